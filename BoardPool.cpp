@@ -0,0 +1,188 @@
+#include "BoardPool.hpp"
+#include "ReelConverter.h"
+#include <cstring>
+#include <stdexcept>
+
+BoardId BoardPool::intern(const uint8_t* board) {
+    interned_++;
+    if ((hashes_.size() + 1) * 2 > table_.size()) grow();
+    const uint64_t h = hash(board);
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = h & mask;; slot = (slot + 1) & mask) {
+        const BoardId id = table_[slot];
+        if (id == kEmptySlot) {
+            const BoardId added = static_cast<BoardId>(hashes_.size());
+            cells_.insert(cells_.end(), board, board + CELLS);
+            hashes_.push_back(h);
+            table_[slot] = added;
+            return added;
+        }
+        if (hashes_[id] == h && std::memcmp(cells(id), board, CELLS) == 0) return id;
+    }
+}
+
+BoardId BoardPool::intern(const Board& board) {
+    if (board.size() != SS02BatchEvaluator::HEIGHT || board[0].size() != SS02BatchEvaluator::WIDTH) {
+        throw std::runtime_error("Board pool holds 5x6 boards only");
+    }
+    uint8_t packed[CELLS];
+    SS02BatchEvaluator::packBoard(board, packed);
+    return intern(packed);
+}
+
+Board BoardPool::board(BoardId id) const {
+    const uint8_t* c = cells(id);
+    Board board(SS02BatchEvaluator::HEIGHT, std::vector<int>(SS02BatchEvaluator::WIDTH));
+    for (int row = 0; row < SS02BatchEvaluator::HEIGHT; ++row) {
+        for (int col = 0; col < SS02BatchEvaluator::WIDTH; ++col) {
+            uint8_t v = c[row * SS02BatchEvaluator::WIDTH + col];
+            board[row][col] = v == SS02BatchEvaluator::EMPTY ? -1 : v;
+        }
+    }
+    return board;
+}
+
+size_t BoardPool::bytes() const {
+    return cells_.capacity() + hashes_.capacity() * sizeof(uint64_t) + table_.capacity() * sizeof(BoardId);
+}
+
+uint64_t BoardPool::hash(const uint8_t* c) {
+    // 30 bytes as three 8-byte words and a 6-byte tail, mixed with the splitmix64 finalizer
+    uint64_t words[4] = {};
+    std::memcpy(words, c, CELLS);
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t w : words) {
+        h ^= w + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+void BoardPool::grow() {
+    table_.assign(table_.empty() ? 1024 : table_.size() * 2, kEmptySlot);
+    const size_t mask = table_.size() - 1;
+    for (BoardId id = 0; id < hashes_.size(); ++id) {
+        size_t slot = hashes_[id] & mask;
+        while (table_[slot] != kEmptySlot) slot = (slot + 1) & mask;
+        table_[slot] = id;
+    }
+}
+
+void InternedScriptSet::add(int index, const ScriptApp::ScriptData& data) {
+    InternedScript s;
+    s.is_free = data.is_free;
+    s.index = index;
+    s.stop = data.stop;
+    s.payout = data.payout;
+    s.payout_id = data.payout_id;
+    s.special_multipliers = data.special_multipliers;
+    s.multiple_table = data.multiple_table;
+    s.first = static_cast<uint32_t>(boardIds.size());
+    s.board_count = static_cast<uint32_t>(data.script.size());
+    for (const auto& board : data.script) boardIds.push_back(pool.intern(board));
+    scripts.push_back(s);
+}
+
+size_t InternedScriptSet::loadFile(const std::string& filename) {
+    const size_t before = scripts.size();
+    auto config = ScriptApp::ScriptConfig::loadFromFile(filename);
+    for (const auto& [index, data] : config.base_scripts) add(index, data);
+    for (const auto& [index, data] : config.free_scripts) add(index, data);
+    if (scripts.size() > before) return scripts.size() - before;
+
+    // No board scripts: a reel file, replayed the way the backend plays it
+    ReelScriptSet reels = ReelConverter::loadReelFile(filename);
+    for (bool isFree : {false, true}) {
+        SlotSS02 game(true, 20.0f, isFree ? "free" : "base");
+        for (const auto& reel : isFree ? reels.free : reels.base) {
+            ScriptApp::ScriptData data;
+            data.is_free = isFree;
+            data.stop = reel.stopover;
+            data.multiple_table = reel.multiple_table;
+            data.script = ReelConverter::replay(game, reel).boards;
+            add(reel.number, data);
+            scripts.back().has_payout = false;
+        }
+    }
+    return scripts.size() - before;
+}
+
+ScriptApp::ScriptData InternedScriptSet::expand(const InternedScript& s) const {
+    ScriptApp::ScriptData data;
+    data.is_free = s.is_free;
+    data.stop = s.stop;
+    data.payout = s.payout;
+    data.payout_id = s.payout_id;
+    data.special_multipliers = s.special_multipliers;
+    data.multiple_table = s.multiple_table;
+    for (uint32_t b = 0; b < s.board_count; ++b) data.script.push_back(pool.board(ids(s)[b]));
+    return data;
+}
+
+size_t InternedScriptSet::bytes() const {
+    return pool.bytes() + boardIds.capacity() * sizeof(BoardId) + scripts.capacity() * sizeof(InternedScript);
+}
+
+size_t InternedScriptSet::expandedBytes() const {
+    // Board = vector of HEIGHT row vectors of WIDTH ints; allocator overhead not counted
+    const size_t perBoard = SS02BatchEvaluator::HEIGHT * (sizeof(std::vector<int>) + SS02BatchEvaluator::WIDTH * sizeof(int));
+    return boardIds.size() * (sizeof(Board) + perBoard) + scripts.size() * sizeof(ScriptApp::ScriptData);
+}
+
+InternedEvaluator::InternedEvaluator(SlotSS02& game, const BoardPool& pool)
+    : game_(game), pool_(pool), isFree_(game.get_config().game_type == "free") {}
+
+const InternedEvaluator::BoardOutcome& InternedEvaluator::outcome(BoardId id) {
+    if (id >= outcomes_.size()) outcomes_.resize(pool_.size());
+    BoardOutcome& o = outcomes_[id];
+    if (o.analyzed) return o;
+
+    Board board = pool_.board(id);
+    auto [patterns, has_match] = game_.find_matches(board);
+    o.terminal = !has_match;
+    for (const auto& row : board) {
+        for (int v : row) {
+            if (v == SlotSS02::get_multiplier_symbol()) o.multiplierCount++;
+        }
+    }
+    if (has_match) {
+        o.score = game_.get_score(patterns);
+        SS02BatchEvaluator::packBoard(game_.apply_gravity(game_.eliminate_matches(board, patterns)), o.survivors.data());
+    }
+    o.analyzed = true;
+    analyzed_++;
+    return o;
+}
+
+BatchScriptResult InternedEvaluator::evaluate(const BoardId* ids, int count, int special_multipliers) {
+    BatchScriptResult result;
+    if (count <= 0) return result;
+
+    // Same loop and score accumulation as SlotSS02::steps()
+    int total_score = 0;
+    int stop = 0;
+    while (stop < count - 1) {
+        const BoardOutcome& o = outcome(ids[stop]);
+        if (o.terminal) break;
+        steps_++;
+        total_score += o.score;
+        const uint8_t* next = pool_.cells(ids[stop + 1]);
+        for (int cell = 0; cell < BoardPool::CELLS; ++cell) {
+            if (o.survivors[cell] != SS02BatchEvaluator::EMPTY && o.survivors[cell] != next[cell]) {
+                result.cascade_match = false;
+                break;
+            }
+        }
+        stop++;
+    }
+    const BoardOutcome& last = outcome(ids[stop]);
+    if (isFree_ && last.multiplierCount > 0) {
+        total_score *= last.multiplierCount * special_multipliers;
+    }
+    result.score = total_score;
+    result.stop = stop + 1;
+    result.multiplier_count = last.multiplierCount;
+    return result;
+}
@@ -0,0 +1,107 @@
+// BoardPool.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include "ScriptConfig.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using BoardId = uint32_t;
+
+// Hash-consed store of packed SS02 boards (SS02BatchEvaluator layout: 30 bytes, 0xFF for an
+// empty cell). Interning the same board twice returns the same id, so scripts that share
+// boards - within a file or across files - store each distinct board once.
+class BoardPool {
+public:
+    static constexpr int CELLS = SS02BatchEvaluator::CELLS;
+
+    BoardId intern(const uint8_t* cells);
+    BoardId intern(const Board& board);
+
+    const uint8_t* cells(BoardId id) const { return cells_.data() + static_cast<size_t>(id) * CELLS; }
+    Board board(BoardId id) const;
+
+    size_t size() const { return hashes_.size(); }   // Distinct boards
+    size_t interned() const { return interned_; }     // intern() calls, repeats included
+    size_t bytes() const;                             // Cells, hashes and the hash table
+
+private:
+    static uint64_t hash(const uint8_t* cells);
+    void grow();
+
+    static constexpr BoardId kEmptySlot = 0xFFFFFFFFu;
+
+    std::vector<uint8_t> cells_;
+    std::vector<uint64_t> hashes_;       // Per id, reused when the table grows
+    std::vector<BoardId> table_;         // Open addressing, linear probing
+    size_t interned_ = 0;
+};
+
+// A script whose boards are a span of ids in InternedScriptSet::boardIds
+struct InternedScript {
+    bool is_free = false;
+    bool has_payout = true;      // False for scripts rebuilt from reel files
+    int index = 0;
+    int stop = 0;
+    int payout = 0;
+    int payout_id = 0;
+    int special_multipliers = 1;
+    int multiple_table = 0;
+    uint32_t first = 0;
+    uint32_t board_count = 0;
+};
+
+// Script sets of one or more files sharing one board pool
+struct InternedScriptSet {
+    BoardPool pool;
+    std::vector<BoardId> boardIds;
+    std::vector<InternedScript> scripts;
+
+    void add(int index, const ScriptApp::ScriptData& data);
+
+    // Loads a board-format script file (SS02_scripts.json layout) or, if it has none, a reel
+    // file (converter output or Insert_Script.json) replayed into boards. Returns the number
+    // of scripts added.
+    size_t loadFile(const std::string& filename);
+
+    const BoardId* ids(const InternedScript& script) const { return boardIds.data() + script.first; }
+    ScriptApp::ScriptData expand(const InternedScript& script) const;
+
+    size_t bytes() const;          // Pool, id spans and script records
+    size_t expandedBytes() const;  // Payload of the same scripts held as ScriptData (Board vectors)
+};
+
+// SS02 evaluation of interned scripts, equivalent to SlotSS02::steps(). Everything a cascade
+// step computes - matches, score, elimination, gravity - depends only on the board being
+// evaluated, so it is memoized per board id; a step (board, next board) then costs one
+// 30-byte comparison of the survivors against the next board. Scripts that share boards or
+// transitions skip the repeated work. Not thread-safe: use one evaluator per thread.
+class InternedEvaluator {
+public:
+    InternedEvaluator(SlotSS02& game, const BoardPool& pool);
+
+    BatchScriptResult evaluate(const BoardId* ids, int count, int special_multipliers);
+
+    size_t boardsAnalyzed() const { return analyzed_; }
+    size_t stepsEvaluated() const { return steps_; }
+
+private:
+    struct BoardOutcome {
+        bool analyzed = false;
+        bool terminal = true;
+        float score = 0.0f;
+        int multiplierCount = 0;
+        std::array<uint8_t, BoardPool::CELLS> survivors{};   // After elimination and gravity
+    };
+
+    const BoardOutcome& outcome(BoardId id);
+
+    SlotSS02& game_;
+    const BoardPool& pool_;
+    bool isFree_;
+    std::vector<BoardOutcome> outcomes_;
+    size_t analyzed_ = 0;
+    size_t steps_ = 0;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Compact binary checkpoints for long runs (simulations, sweeps).
+//
+// File layout (little-endian):
+//   header, 32 bytes: "SS02CKPT", u32 version, u32 kind, u64 fingerprint, u64 payload bytes
+//   payload: fixed-width fields in the order the writer appended them
+//
+// The fingerprint hashes everything the saved state depends on (scripts, parameters, seed),
+// so a checkpoint is never resumed or merged under a different configuration. Files are
+// written to "<path>.tmp" and renamed over the old checkpoint, so a crash mid-write leaves
+// the previous checkpoint intact.
+struct Checkpoint {
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t SIMULATION = 1;
+    static constexpr uint32_t SWEEP = 2;
+
+    // FNV-1a over the bytes of trivially copyable values and strings
+    class Fingerprint {
+    public:
+        template <typename T>
+        Fingerprint& add(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Fingerprint needs trivially copyable values");
+            return bytes(&value, sizeof(T));
+        }
+        Fingerprint& add(const std::string& text) {
+            add<uint64_t>(text.size());
+            return bytes(text.data(), text.size());
+        }
+        uint64_t value() const { return hash_; }
+
+    private:
+        Fingerprint& bytes(const void* data, size_t size) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash_ ^= p[i];
+                hash_ *= 0x100000001B3ULL;
+            }
+            return *this;
+        }
+        uint64_t hash_ = 0xCBF29CE484222325ULL;
+    };
+
+    class Writer {
+    public:
+        template <typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "Checkpoint fields must be trivially copyable");
+            const auto* p = reinterpret_cast<const char*>(&value);
+            payload_.insert(payload_.end(), p, p + sizeof(T));
+        }
+
+        void save(const std::string& path, uint32_t kind, uint64_t fingerprint) const {
+            const std::string tmp = path + ".tmp";
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out.is_open()) {
+                    throw std::runtime_error("Cannot write checkpoint " + tmp);
+                }
+                char header[32] = {};
+                std::memcpy(header, "SS02CKPT", 8);
+                const uint64_t size = payload_.size();
+                std::memcpy(header + 8, &VERSION, 4);
+                std::memcpy(header + 12, &kind, 4);
+                std::memcpy(header + 16, &fingerprint, 8);
+                std::memcpy(header + 24, &size, 8);
+                out.write(header, sizeof(header));
+                out.write(payload_.data(), static_cast<std::streamsize>(payload_.size()));
+                if (!out) {
+                    throw std::runtime_error("Failed writing checkpoint " + tmp);
+                }
+            }
+            if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+                throw std::runtime_error("Cannot replace checkpoint " + path);
+            }
+        }
+
+    private:
+        std::vector<char> payload_;
+    };
+
+    class Reader {
+    public:
+        // Throws std::runtime_error unless `path` is a checkpoint of `kind` saved under `fingerprint`
+        Reader(const std::string& path, uint32_t kind, uint64_t fingerprint) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) {
+                throw std::runtime_error("Cannot open checkpoint " + path);
+            }
+            char header[32];
+            if (!in.read(header, sizeof(header)) || std::memcmp(header, "SS02CKPT", 8) != 0) {
+                throw std::runtime_error(path + " is not an SS02 checkpoint");
+            }
+            uint32_t version, fileKind;
+            uint64_t fileFingerprint, size;
+            std::memcpy(&version, header + 8, 4);
+            std::memcpy(&fileKind, header + 12, 4);
+            std::memcpy(&fileFingerprint, header + 16, 8);
+            std::memcpy(&size, header + 24, 8);
+            if (version != VERSION || fileKind != kind) {
+                throw std::runtime_error(path + ": unsupported checkpoint version or kind");
+            }
+            if (fileFingerprint != fingerprint) {
+                throw std::runtime_error(path + " was saved for different scripts or parameters");
+            }
+            payload_.resize(size);
+            if (!in.read(payload_.data(), static_cast<std::streamsize>(size))) {
+                throw std::runtime_error(path + " is truncated");
+            }
+        }
+
+        template <typename T>
+        T get() {
+            static_assert(std::is_trivially_copyable<T>::value, "Checkpoint fields must be trivially copyable");
+            if (offset_ + sizeof(T) > payload_.size()) {
+                throw std::runtime_error("Checkpoint payload is truncated");
+            }
+            T value;
+            std::memcpy(&value, payload_.data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return value;
+        }
+
+    private:
+        std::vector<char> payload_;
+        size_t offset_ = 0;
+    };
+};
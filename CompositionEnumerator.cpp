@@ -0,0 +1,306 @@
+#include "CompositionEnumerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+DeepDiveProblem DeepDiveProblem::loadFromFile(const std::string& filename, const SlotSS02& game) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open composition config file: " + filename);
+    }
+    nlohmann::json j;
+    file >> j;
+
+    DeepDiveProblem problem;
+    problem.name = j.value("problem_name", "");
+
+    const auto& payTable = game.get_config().pay_table;
+    const int cells = game.get_board_height() * game.get_board_width();
+    const auto& terms = j.at("terms");
+    for (size_t i = 0; i < terms.size(); ++i) {
+        problem.termNames.push_back(terms[i].at("name").get<std::string>());
+        std::vector<int> sValues = terms[i].at("s_values").get<std::vector<int>>();
+        std::vector<int> tierCounts;
+        int symbol = static_cast<int>(i);
+        for (int s : sValues) {
+            // Smallest cluster of this symbol that pays exactly s
+            int found = -1;
+            auto it = payTable.find(symbol);
+            for (int count = game.get_min_match_size(); it != payTable.end() && count <= cells; ++count) {
+                auto pay = it->second.find(count);
+                if (pay != it->second.end() && static_cast<int>(pay->second) == s) {
+                    found = count;
+                    break;
+                }
+            }
+            if (found < 0) {
+                throw std::runtime_error("Term " + problem.termNames.back() + " s_value " + std::to_string(s) +
+                                         " does not match any SS02 pay for symbol " + std::to_string(symbol));
+            }
+            tierCounts.push_back(found);
+        }
+        problem.sValues.push_back(sValues);
+        problem.tierCounts.push_back(tierCounts);
+    }
+
+    const auto& constraints = j.at("constraints");
+    problem.termProductMax.assign(terms.size(), 0);
+    if (constraints.contains("global_constraints")) {
+        for (const auto& bound : constraints.at("global_constraints").at("term_product_bounds")) {
+            size_t index = bound.at("term_index").get<size_t>();
+            if (index < problem.termProductMax.size()) {
+                problem.termProductMax[index] = bound.at("max").get<int>();
+            }
+        }
+    }
+
+    const auto& counts = constraints.at("count_constraints");
+    problem.globalMaxCount = counts.at("global_max_count").get<int>();
+    problem.maxNonzeroCounts = counts.value("max_nonzero_counts", static_cast<int>(terms.size() * 3));
+    problem.allNonzeroCountsEqual = counts.value("all_nonzero_counts_are_equal", false);
+    problem.totalCountMin = counts.at("total_sum_of_counts_bound").value("min", 0);
+    problem.totalCountMax = counts.at("total_sum_of_counts_bound").at("max").get<int>();
+
+    problem.specialMultipliers = j.at("coefficient_definition").at("special_multipliers").get<std::vector<int>>();
+    if (constraints.contains("multiplier_constraints")) {
+        problem.multiplierCountMax = constraints.at("multiplier_constraints").value("sum_of_multipliers_bound", 0);
+    }
+    if (constraints.contains("coefficient_constraints") &&
+        constraints.at("coefficient_constraints").contains("total_coefficient_sum_bounds")) {
+        const auto& bounds = constraints.at("coefficient_constraints").at("total_coefficient_sum_bounds");
+        problem.coefficientMin = bounds.value("min", 1);
+        problem.coefficientMax = bounds.value("max", 0);
+    }
+    problem.isFree = problem.multiplierCountMax > 0;
+    return problem;
+}
+
+CompositionSpec Composition::toSpec(const DeepDiveProblem& problem, const RefillSolver& solver) const {
+    std::vector<ClusterSpec> clusters;
+    for (size_t term = 0; term < counts.size(); ++term) {
+        for (size_t tier = 0; tier < counts[term].size(); ++tier) {
+            for (int k = 0; k < counts[term][tier]; ++k) {
+                clusters.push_back({static_cast<int>(term), problem.tierCounts[term][tier]});
+            }
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const ClusterSpec& a, const ClusterSpec& b) { return a.count > b.count; });
+
+    // First-fit: a step holds each symbol once; fall back to a new step
+    CompositionSpec spec;
+    spec.special_multipliers = specialMultiplier;
+    spec.multiplier_count = multiplierCount;
+    for (const auto& cluster : clusters) {
+        bool placed = false;
+        for (size_t step = 0; step < spec.steps.size() && !placed; ++step) {
+            bool hasSymbol = std::any_of(spec.steps[step].begin(), spec.steps[step].end(),
+                                         [&](const ClusterSpec& c) { return c.symbol == cluster.symbol; });
+            if (hasSymbol) continue;
+            spec.steps[step].push_back(cluster);
+            if (solver.feasible(spec)) {
+                placed = true;
+            } else {
+                spec.steps[step].pop_back();
+            }
+        }
+        if (!placed) {
+            spec.steps.push_back({cluster});
+        }
+    }
+    for (auto& step : spec.steps) {
+        std::sort(step.begin(), step.end(), [](const ClusterSpec& a, const ClusterSpec& b) { return a.symbol < b.symbol; });
+    }
+    return spec;
+}
+
+nlohmann::json Composition::toJson(const DeepDiveProblem& problem, const RefillSolver& solver) const {
+    CompositionSpec spec = toSpec(problem, solver);
+    nlohmann::json j;
+    j["payout"] = payout;
+    j["base_payout"] = basePayout;
+    j["special_multipliers"] = specialMultiplier;
+    j["multiplier_count"] = multiplierCount;
+
+    nlohmann::json termCounts = nlohmann::json::object();
+    for (size_t term = 0; term < counts.size(); ++term) {
+        bool nonzero = std::any_of(counts[term].begin(), counts[term].end(), [](int c) { return c > 0; });
+        if (nonzero) termCounts[problem.termNames[term]] = counts[term];
+    }
+    j["counts"] = termCounts;
+
+    nlohmann::json steps = nlohmann::json::array();
+    for (const auto& step : spec.steps) {
+        nlohmann::json clusters = nlohmann::json::array();
+        for (const auto& cluster : step) {
+            clusters.push_back({{"symbol", cluster.symbol}, {"count", cluster.count}});
+        }
+        steps.push_back(clusters);
+    }
+    j["steps"] = steps;
+    return j;
+}
+
+std::vector<std::vector<CompositionEnumerator::TermOption>> CompositionEnumerator::buildTermOptions() const {
+    std::vector<std::vector<TermOption>> options;
+    for (size_t term = 0; term < problem_.sValues.size(); ++term) {
+        const auto& s = problem_.sValues[term];
+        std::vector<TermOption> termOptions;
+        std::vector<int> counts(s.size(), 0);
+
+        // Odometer over [0, globalMaxCount]^tiers, all-zero first
+        while (true) {
+            TermOption option{counts, 0, 0, 0};
+            for (size_t tier = 0; tier < s.size(); ++tier) {
+                option.countSum += counts[tier];
+                option.nonzero += counts[tier] > 0 ? 1 : 0;
+                option.payout += counts[tier] * s[tier];
+            }
+            int bound = problem_.termProductMax[term];
+            if ((bound <= 0 || option.payout <= bound) && option.countSum <= problem_.totalCountMax &&
+                option.nonzero <= problem_.maxNonzeroCounts) {
+                termOptions.push_back(option);
+            }
+
+            size_t pos = s.size();
+            while (pos > 0 && counts[pos - 1] == problem_.globalMaxCount) {
+                counts[pos - 1] = 0;
+                --pos;
+            }
+            if (pos == 0) break;
+            counts[pos - 1]++;
+        }
+        options.push_back(termOptions);
+    }
+    return options;
+}
+
+std::vector<std::pair<int, int>> CompositionEnumerator::coefficients() const {
+    std::vector<std::pair<int, int>> result = {{1, 0}};  // No multiplier symbols
+    if (!problem_.isFree) return result;
+    for (int multiplier : problem_.specialMultipliers) {
+        for (int count = 1; count <= problem_.multiplierCountMax; ++count) {
+            int coefficient = multiplier * count;
+            if (coefficient < problem_.coefficientMin) continue;
+            if (problem_.coefficientMax > 0 && coefficient > problem_.coefficientMax) continue;
+            result.emplace_back(multiplier, count);
+        }
+    }
+    return result;
+}
+
+std::map<int, PayoutGroup> CompositionEnumerator::enumerate(int threads, int examplesPerPayout, int maxPayout) const {
+    const auto options = buildTermOptions();
+    const auto coefs = coefficients();
+    const size_t numTerms = options.size();
+    if (numTerms == 0) return {};
+
+    // Largest count sum still reachable from each term onward (for the total_sum min bound)
+    std::vector<int> suffixMaxCount(numTerms + 1, 0);
+    for (size_t t = numTerms; t-- > 0;) {
+        int best = 0;
+        for (const auto& o : options[t]) best = std::max(best, o.countSum);
+        suffixMaxCount[t] = suffixMaxCount[t + 1] + best;
+    }
+    int minCoefficient = 1;
+    for (const auto& [m, k] : coefs) minCoefficient = std::min(minCoefficient, k == 0 ? 1 : m * k);
+
+    // Tasks: every choice for the first two terms
+    std::vector<std::vector<size_t>> tasks;
+    const size_t splitDepth = std::min<size_t>(2, numTerms);
+    std::vector<size_t> prefix(splitDepth, 0);
+    std::function<void(size_t)> makeTasks = [&](size_t depth) {
+        if (depth == splitDepth) {
+            tasks.push_back(prefix);
+            return;
+        }
+        for (size_t i = 0; i < options[depth].size(); ++i) {
+            prefix[depth] = i;
+            makeTasks(depth + 1);
+        }
+    };
+    makeTasks(0);
+
+    std::vector<std::map<int, PayoutGroup>> taskResults(tasks.size());
+    std::atomic<size_t> nextTask{0};
+
+    auto worker = [&]() {
+        std::vector<size_t> choice(numTerms, 0);
+        for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+            auto& groups = taskResults[t];
+
+            auto record = [&](int basePayout) {
+                for (const auto& [multiplier, count] : coefs) {
+                    // A zero-payout composition has no use for multiplier symbols
+                    if (basePayout == 0 && count > 0) continue;
+                    int payout = basePayout * (count == 0 ? 1 : multiplier * count);
+                    if (maxPayout > 0 && payout > maxPayout) continue;
+                    PayoutGroup& group = groups[payout];
+                    group.compositions++;
+                    if (static_cast<int>(group.examples.size()) < examplesPerPayout) {
+                        Composition composition;
+                        for (size_t term = 0; term < numTerms; ++term) {
+                            composition.counts.push_back(options[term][choice[term]].counts);
+                        }
+                        composition.basePayout = basePayout;
+                        composition.payout = payout;
+                        composition.specialMultiplier = count == 0 ? 1 : multiplier;
+                        composition.multiplierCount = count;
+                        group.examples.push_back(std::move(composition));
+                    }
+                }
+            };
+
+            // Depth-first search with pruning on count sum, nonzero count, equal counts and payout
+            std::function<void(size_t, int, int, int, int)> dfs =
+                [&](size_t term, int countSum, int nonzero, int payout, int commonCount) {
+                    if (term == numTerms) {
+                        if (countSum >= problem_.totalCountMin) record(payout);
+                        return;
+                    }
+                    if (countSum + suffixMaxCount[term] < problem_.totalCountMin) return;
+                    for (size_t i = 0; i < options[term].size(); ++i) {
+                        if (term < splitDepth && i != tasks[t][term]) continue;
+                        const auto& o = options[term][i];
+                        if (countSum + o.countSum > problem_.totalCountMax) continue;
+                        if (nonzero + o.nonzero > problem_.maxNonzeroCounts) continue;
+                        if (maxPayout > 0 && (payout + o.payout) * minCoefficient > maxPayout) continue;
+                        int common = commonCount;
+                        if (problem_.allNonzeroCountsEqual) {
+                            bool ok = true;
+                            for (int c : o.counts) {
+                                if (c == 0) continue;
+                                if (common == 0) common = c;
+                                if (c != common) ok = false;
+                            }
+                            if (!ok) continue;
+                        }
+                        choice[term] = i;
+                        dfs(term + 1, countSum + o.countSum, nonzero + o.nonzero, payout + o.payout, common);
+                    }
+                };
+            dfs(0, 0, 0, 0, 0);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < std::max(1, threads); ++i) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+
+    // Merge in task order so examples are the first found in canonical order
+    std::map<int, PayoutGroup> merged;
+    for (auto& groups : taskResults) {
+        for (auto& [payout, group] : groups) {
+            PayoutGroup& target = merged[payout];
+            target.compositions += group.compositions;
+            for (auto& example : group.examples) {
+                if (static_cast<int>(target.examples.size()) >= examplesPerPayout) break;
+                target.examples.push_back(std::move(example));
+            }
+        }
+    }
+    return merged;
+}
@@ -0,0 +1,77 @@
+// CompositionEnumerator.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include "SS02Generator.hpp"
+#include "json.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+// DeepDive composition problem (Backup/DeepDive{BG,FG}_Comp_Config.json).
+//
+// Term i is SS02 symbol i; s_values[j] is the pay of its j-th cluster tier (8-9, 10-11, 12+).
+// A composition assigns a count c[i][j] (how many clusters of that tier occur in the script),
+// its base payout is sum(c[i][j] * s_values[i][j]) and the final payout is the base payout
+// times a coefficient (multiplier_count * special_multiplier for free games, 1 otherwise).
+struct DeepDiveProblem {
+    std::string name;
+    std::vector<std::string> termNames;
+    std::vector<std::vector<int>> sValues;       // [term][tier]
+    std::vector<std::vector<int>> tierCounts;    // Smallest cluster size paying sValues[term][tier]
+    std::vector<int> termProductMax;             // sum_j c[i][j] * s[i][j] <= max (per term)
+    int globalMaxCount = 0;
+    int maxNonzeroCounts = 0;
+    bool allNonzeroCountsEqual = false;
+    int totalCountMin = 0;
+    int totalCountMax = 0;
+    std::vector<int> specialMultipliers;
+    int multiplierCountMax = 0;                  // sum_of_multipliers_bound
+    int coefficientMin = 1;                      // total_coefficient_sum_bounds
+    int coefficientMax = 0;                      // 0 = unbounded
+    bool isFree = false;
+
+    // Loads the config and maps each s_value onto a cluster size using the SS02 pay table
+    static DeepDiveProblem loadFromFile(const std::string& filename, const SlotSS02& game);
+};
+
+struct Composition {
+    std::vector<std::vector<int>> counts;  // [term][tier]
+    int basePayout = 0;
+    int payout = 0;
+    int specialMultiplier = 1;
+    int multiplierCount = 0;
+
+    // Pack the clusters into cascade steps: one symbol per step at most, each placement kept
+    // only while RefillSolver::feasible accepts the plan
+    CompositionSpec toSpec(const DeepDiveProblem& problem, const RefillSolver& solver) const;
+    nlohmann::json toJson(const DeepDiveProblem& problem, const RefillSolver& solver) const;
+};
+
+// Aggregated enumeration result for one payout value
+struct PayoutGroup {
+    long long compositions = 0;
+    std::vector<Composition> examples;   // First compositions in canonical search order
+};
+
+class CompositionEnumerator {
+public:
+    explicit CompositionEnumerator(const DeepDiveProblem& problem) : problem_(problem) {}
+
+    // Enumerate every feasible composition. The search tree is split on the first terms
+    // and explored by `threads` workers; merging is in task order so the result is
+    // independent of the thread count. maxPayout <= 0 disables the payout cap.
+    std::map<int, PayoutGroup> enumerate(int threads, int examplesPerPayout, int maxPayout = 0) const;
+
+private:
+    struct TermOption {
+        std::vector<int> counts;
+        int countSum;
+        int nonzero;
+        int payout;
+    };
+
+    std::vector<std::vector<TermOption>> buildTermOptions() const;
+    std::vector<std::pair<int, int>> coefficients() const;  // (special multiplier, multiplier count)
+
+    const DeepDiveProblem& problem_;
+};
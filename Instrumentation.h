@@ -0,0 +1,316 @@
+#pragma once
+
+#include "json.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Lightweight instrumentation for the SS02 tools.
+//
+//   Instrumentation::ScopedTimer timer("load");      // phase timer, nests by scope
+//   Instrumentation::instance().counter("scripts") += n;
+//   SS02_COUNT("find_matches");                      // engine hot paths, see below
+//
+// Phases nest: a timer opened inside another is reported as "outer/inner". Hardware
+// counters (cycles, instructions, cache and branch misses) are read per phase through
+// perf_event_open once enableHardwareCounters() succeeds; where the kernel does not permit
+// it the report says why and only wall time is kept.
+//
+// SS02_COUNT compiles to nothing unless built with -DSS02_INSTRUMENT, so the game engine
+// pays nothing for it in normal builds. With -DSS02_INSTRUMENT, the one translation unit
+// that defines SS02_INSTRUMENT_MAIN before including this header also counts heap
+// allocations.
+
+#ifdef SS02_INSTRUMENT
+#define SS02_COUNT(name)                                                                   \
+    do {                                                                                   \
+        static auto& ss02Counter_ = Instrumentation::instance().counter(name);            \
+        ss02Counter_.fetch_add(1, std::memory_order_relaxed);                              \
+    } while (0)
+#else
+#define SS02_COUNT(name) do {} while (0)
+#endif
+
+class Instrumentation {
+public:
+    static constexpr int HW_EVENTS = 4;
+
+    struct Phase {
+        std::string path;
+        int depth = 0;
+        long long calls = 0;
+        double seconds = 0.0;
+        uint64_t hw[HW_EVENTS] = {0, 0, 0, 0};
+    };
+
+    static Instrumentation& instance() {
+        static Instrumentation inst;
+        return inst;
+    }
+
+    static std::atomic<long long>& allocationCounter() {
+        static std::atomic<long long> allocations{0};
+        return allocations;
+    }
+
+    // Named counter; the reference stays valid for the life of the program
+    std::atomic<long long>& counter(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = counterIndex_.find(name);
+        if (it != counterIndex_.end()) return counters_[it->second];
+        counterIndex_[name] = counters_.size();
+        counterNames_.push_back(name);
+        counters_.emplace_back(0);
+        return counters_.back();
+    }
+
+    // Try to open the hardware counters; returns false (and records why) if not permitted
+    bool enableHardwareCounters() {
+#ifdef __linux__
+        const uint64_t configs[HW_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                             PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < HW_EVENTS; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            hwFds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            if (hwFds_[i] < 0) {
+                hwError_ = std::string("perf_event_open: ") + std::strerror(errno);
+                for (int j = 0; j <= i; ++j) {
+                    if (hwFds_[j] >= 0) close(hwFds_[j]);
+                    hwFds_[j] = -1;
+                }
+                return false;
+            }
+        }
+        hwEnabled_ = true;
+        return true;
+#else
+        hwError_ = "hardware counters need Linux perf_event_open";
+        return false;
+#endif
+    }
+
+    bool hardwareCountersEnabled() const { return hwEnabled_; }
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const std::string& name) : inst_(Instrumentation::instance()) {
+            auto& stack = pathStack();
+            path_ = stack.empty() ? name : stack.back() + "/" + name;
+            depth_ = static_cast<int>(stack.size());
+            stack.push_back(path_);
+            inst_.phaseFor(path_, depth_);
+            inst_.readHardware(hwStart_);
+            start_ = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            uint64_t hwEnd[HW_EVENTS] = {0, 0, 0, 0};
+            inst_.readHardware(hwEnd);
+            uint64_t delta[HW_EVENTS];
+            for (int i = 0; i < HW_EVENTS; ++i) delta[i] = hwEnd[i] - hwStart_[i];
+            inst_.record(path_, depth_, seconds, delta);
+            pathStack().pop_back();
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Instrumentation& inst_;
+        std::string path_;
+        int depth_ = 0;
+        uint64_t hwStart_[HW_EVENTS] = {0, 0, 0, 0};
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Phase breakdown (percent of the time since start-up) followed by the counters
+    void printReport(std::ostream& os = std::cout) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double total = elapsed();
+        os << "\n==============================================\n";
+        os << "       INSTRUMENTATION REPORT\n";
+        os << "==============================================\n";
+        os << std::left << std::setw(40) << "Phase" << std::right << std::setw(8) << "Calls"
+           << std::setw(12) << "Time (ms)" << std::setw(8) << "%";
+        if (hwEnabled_) os << std::setw(14) << "Cycles" << std::setw(8) << "IPC" << std::setw(12) << "Cache miss";
+        os << "\n";
+        for (const auto& phase : phases_) {
+            std::string label = std::string(phase.depth * 2, ' ') + phase.path.substr(phase.path.rfind('/') + 1);
+            os << std::left << std::setw(40) << label << std::right << std::setw(8) << phase.calls
+               << std::setw(12) << std::fixed << std::setprecision(2) << phase.seconds * 1000.0
+               << std::setw(8) << std::setprecision(1) << (total > 0.0 ? 100.0 * phase.seconds / total : 0.0);
+            if (hwEnabled_) {
+                double ipc = phase.hw[0] > 0 ? static_cast<double>(phase.hw[1]) / phase.hw[0] : 0.0;
+                os << std::setw(14) << phase.hw[0] << std::setw(8) << std::setprecision(2) << ipc
+                   << std::setw(12) << phase.hw[2];
+            }
+            os << "\n";
+        }
+        os << std::left << std::setw(40) << "Total (wall)" << std::right << std::setw(8) << ""
+           << std::setw(12) << std::setprecision(2) << total * 1000.0 << "\n";
+        if (!hwEnabled_ && !hwError_.empty()) {
+            os << "⚠️  Hardware counters unavailable (" << hwError_ << ")\n";
+        }
+
+        auto counters = counterValues();
+        if (!counters.empty()) {
+            os << "\nCounters:\n";
+            for (const auto& [name, value] : counters) {
+                os << "  " << std::left << std::setw(24) << name << std::right << std::setw(14) << value << "\n";
+            }
+        }
+    }
+
+    nlohmann::json toJson() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        static const char* hwNames[HW_EVENTS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+        nlohmann::json j;
+        j["total_seconds"] = elapsed();
+        j["phases"] = nlohmann::json::array();
+        for (const auto& phase : phases_) {
+            nlohmann::json p = {{"phase", phase.path}, {"calls", phase.calls}, {"seconds", phase.seconds}};
+            if (hwEnabled_) {
+                for (int i = 0; i < HW_EVENTS; ++i) p[hwNames[i]] = phase.hw[i];
+            }
+            j["phases"].push_back(p);
+        }
+        j["counters"] = nlohmann::json::object();
+        for (const auto& [name, value] : counterValues()) j["counters"][name] = value;
+        j["hardware_counters"] = hwEnabled_;
+        if (!hwEnabled_ && !hwError_.empty()) j["hardware_counters_error"] = hwError_;
+        return j;
+    }
+
+    bool exportJson(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) return false;
+        file << toJson().dump(2) << "\n";
+        return true;
+    }
+
+private:
+    Instrumentation() : start_(std::chrono::steady_clock::now()) {}
+
+    ~Instrumentation() {
+#ifdef __linux__
+        for (int fd : hwFds_) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    static std::vector<std::string>& pathStack() {
+        thread_local std::vector<std::string> stack;
+        return stack;
+    }
+
+    void readHardware(uint64_t* values) const {
+#ifdef __linux__
+        if (!hwEnabled_) return;
+        for (int i = 0; i < HW_EVENTS; ++i) {
+            if (read(hwFds_[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t)) values[i] = 0;
+        }
+#else
+        (void)values;
+#endif
+    }
+
+    // Registers a phase when first entered, so parents are listed before their children
+    size_t phaseFor(const std::string& path, int depth) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = phaseIndex_.find(path);
+        if (it != phaseIndex_.end()) return it->second;
+        Phase phase;
+        phase.path = path;
+        phase.depth = depth;
+        phases_.push_back(phase);
+        phaseIndex_[path] = phases_.size() - 1;
+        return phases_.size() - 1;
+    }
+
+    void record(const std::string& path, int depth, double seconds, const uint64_t* hw) {
+        size_t index = phaseFor(path, depth);
+        std::lock_guard<std::mutex> lock(mutex_);
+        Phase& phase = phases_[index];
+        phase.calls++;
+        phase.seconds += seconds;
+        for (int i = 0; i < HW_EVENTS; ++i) phase.hw[i] += hw[i];
+    }
+
+    std::vector<std::pair<std::string, long long>> counterValues() const {
+        std::vector<std::pair<std::string, long long>> values;
+        for (size_t i = 0; i < counters_.size(); ++i) values.emplace_back(counterNames_[i], counters_[i].load());
+#if defined(SS02_INSTRUMENT)
+        values.emplace_back("allocations", allocationCounter().load());
+#endif
+        return values;
+    }
+
+    double elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    mutable std::mutex mutex_;
+    std::chrono::steady_clock::time_point start_;
+    std::vector<Phase> phases_;                  // Order of first entry
+    std::map<std::string, size_t> phaseIndex_;
+    std::deque<std::atomic<long long>> counters_;
+    std::vector<std::string> counterNames_;
+    std::map<std::string, size_t> counterIndex_;
+    int hwFds_[HW_EVENTS] = {-1, -1, -1, -1};
+    bool hwEnabled_ = false;
+    std::string hwError_;
+};
+
+#if defined(SS02_INSTRUMENT) && defined(SS02_INSTRUMENT_MAIN)
+#include <cstdlib>
+#include <new>
+
+// Counting replacements of the global allocation functions (one definition per program).
+// The deallocation functions stay out of line so GCC does not pair an inlined free() with
+// a new-expression and warn about a mismatch.
+#if defined(__GNUC__)
+#define SS02_NOINLINE __attribute__((noinline))
+#else
+#define SS02_NOINLINE
+#endif
+void* operator new(std::size_t size) {
+    Instrumentation::allocationCounter().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    Instrumentation::allocationCounter().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+SS02_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+SS02_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+SS02_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+SS02_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,272 @@
+#include "MultiplierOptimizer.hpp"
+#include "SeedMix.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Score weights: leaving the RTP window outweighs everything else, and inside it the RTP
+// is pulled to the middle of the window before the std dev is matched
+constexpr double kWindowPenalty = 1.0e4;   // Per relative distance outside the FG RTP window
+constexpr double kRtpWeight = 1.0e2;       // Per squared relative deviation from the window midpoint
+
+}  // namespace
+
+MultiplierTarget MultiplierTarget::fromGameConfig(const nlohmann::json& gameConfig) {
+    const auto rtp = gameConfig.at("game_RTP").get<std::vector<double>>();
+    if (rtp.size() != 2) {
+        throw std::runtime_error("game_RTP must be a [min, max] window");
+    }
+    const double fgShare = 1.0 - gameConfig.value("BG_percent", 1.0);
+    MultiplierTarget target;
+    target.freeRtpMin = rtp[0] * fgShare;
+    target.freeRtpMax = rtp[1] * fgShare;
+    target.maxWin = gameConfig.value("FG_max", 0.0);
+    return target;
+}
+
+MultiplierOptimizer::MultiplierOptimizer(const ScriptOutcomeCache& cache, const RtpParameters& params,
+                                         const nlohmann::json& tables, const MultiplierTarget& target, int maxWeight)
+    : params_(params), target_(target), maxWeight_(std::max(1, maxWeight)), json_(tables) {
+    if (cache.free.empty()) {
+        throw std::runtime_error("Multiplier optimization needs free scripts");
+    }
+    if (params_.fgRounds * params_.fgRetrigger >= 1.0) {
+        throw std::runtime_error("fgRounds * fgRetrigger >= 1: free game sessions never end");
+    }
+    if (target_.freeRtpMax < target_.freeRtpMin || target_.freeRtpMax <= 0.0) {
+        throw std::runtime_error("Invalid FG RTP window");
+    }
+
+    for (const auto& entry : tables.at("free")) {
+        Table t;
+        t.id = entry.at("id").get<int>();
+        t.multipliers = entry.at("multiplier").get<std::vector<int>>();
+        auto weights = entry.at("weight").get<std::vector<int>>();
+        if (weights.size() != t.multipliers.size()) {
+            throw std::runtime_error("Multiplier table " + std::to_string(t.id) + " has mismatched weights");
+        }
+        tables_.push_back(t);
+        live_.push_back(weights);
+    }
+    initial_ = live_;
+
+    const double freeP = 1.0 / cache.free.size();
+    for (const auto& o : cache.free) {
+        if (o.multiplierCount == 0) {
+            fixedMean_ += o.payout * freeP;
+            fixedSecond_ += static_cast<double>(o.payout) * o.payout * freeP;
+            fixedMax_ = std::max(fixedMax_, static_cast<double>(o.payout));
+            continue;
+        }
+        auto it = std::find_if(tables_.begin(), tables_.end(), [&](const Table& t) { return t.id == o.table; });
+        if (it == tables_.end()) {
+            throw std::runtime_error("Multiplier table " + std::to_string(o.table) + " not found");
+        }
+        const double k = o.multiplierCount;
+        const double bp = o.basePayout;
+        it->scripts++;
+        it->a += bp * k * freeP;
+        it->b += bp * bp * k * freeP;
+        it->c += bp * bp * k * k * freeP;
+        it->maxUnit = std::max(it->maxUnit, bp * k);
+    }
+
+    // A spin's largest win is maxUnit * (draw - 100) with every draw at the table's maximum
+    for (size_t t = 0; t < tables_.size(); ++t) {
+        Table& table = tables_[t];
+        bool any = false;
+        for (int m : table.multipliers) {
+            const bool ok = target_.maxWin <= 0.0 || table.maxUnit * (m - 100) <= target_.maxWin;
+            table.allowed.push_back(ok);
+            any = any || ok;
+        }
+        if (table.scripts > 0 && !any) {
+            throw std::runtime_error("Every multiplier of table " + std::to_string(table.id) +
+                                     " pushes one of its scripts over the max win");
+        }
+        auto& weights = initial_[t];
+        int total = 0;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            weights[i] = table.allowed[i] ? std::clamp(weights[i], 0, maxWeight_) : 0;
+            total += weights[i];
+        }
+        if (table.scripts > 0 && total == 0) {
+            // Start from the smallest multiplier the cap allows
+            size_t lowest = weights.size();
+            for (size_t i = 0; i < weights.size(); ++i) {
+                if (table.allowed[i] && (lowest == weights.size() || table.multipliers[i] < table.multipliers[lowest])) lowest = i;
+            }
+            weights[lowest] = 1;
+        }
+    }
+}
+
+MultiplierResult MultiplierOptimizer::evaluate(const std::vector<std::vector<int>>& weights) const {
+    MultiplierResult r;
+    r.weights = weights;
+    double mean = fixedMean_, second = fixedSecond_;
+    r.maxWin = fixedMax_;
+    for (size_t t = 0; t < tables_.size(); ++t) {
+        const Table& table = tables_[t];
+        if (table.scripts == 0) continue;
+        double total = 0.0, m1 = 0.0, m2 = 0.0;
+        int top = 0;
+        for (size_t i = 0; i < weights[t].size(); ++i) {
+            if (weights[t][i] <= 0) continue;
+            const double offset = table.multipliers[i] - 100;
+            total += weights[t][i];
+            m1 += weights[t][i] * offset;
+            m2 += weights[t][i] * offset * offset;
+            top = std::max(top, table.multipliers[i] - 100);
+        }
+        if (total <= 0.0) {
+            throw std::runtime_error("Multiplier table " + std::to_string(table.id) + " has no usable weights");
+        }
+        m1 /= total;
+        m2 /= total;
+        mean += table.a * m1;
+        second += table.b * m2 + (table.c - table.b) * m1 * m1;
+        r.maxWin = std::max(r.maxWin, table.maxUnit * top);
+    }
+    r.freeSpinMean = mean;
+    r.freeSpinVariance = std::max(0.0, second - mean * mean);
+
+    // Same session moments as SS02AnalyticRtp::solve
+    const double R = params_.fgRounds;
+    const double rr = params_.fgRetrigger;
+    const double mu = R * rr;
+    const double lengthMean = R / (1.0 - mu);
+    const double lengthVariance = R * R * R * rr * (1.0 - rr) / std::pow(1.0 - mu, 3);
+    r.sessionMean = lengthMean * r.freeSpinMean;
+    r.sessionVariance = lengthMean * r.freeSpinVariance + lengthVariance * r.freeSpinMean * r.freeSpinMean;
+    r.freeRtp = params_.fgTrigger * r.sessionMean / params_.bet;
+
+    r.feasible = r.freeRtp >= target_.freeRtpMin && r.freeRtp <= target_.freeRtpMax &&
+                 (target_.maxWin <= 0.0 || r.maxWin <= target_.maxWin);
+    r.score = score(r);
+    return r;
+}
+
+double MultiplierOptimizer::score(const MultiplierResult& r) const {
+    const double mid = 0.5 * (target_.freeRtpMin + target_.freeRtpMax);
+    const double outside = std::max({0.0, target_.freeRtpMin - r.freeRtp, r.freeRtp - target_.freeRtpMax});
+    const double rel = (r.freeRtp - mid) / mid;
+    double s = kWindowPenalty * outside / mid + kRtpWeight * rel * rel;
+    if (target_.sessionStdDev > 0.0) {
+        const double sd = (std::sqrt(r.sessionVariance) - target_.sessionStdDev) / target_.sessionStdDev;
+        s += target_.stdDevWeight * sd * sd;
+    }
+    return s;
+}
+
+MultiplierResult MultiplierOptimizer::search(uint64_t seed, int iterations, bool randomStart) const {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Searchable entries: allowed multipliers of tables that some script draws from
+    std::vector<std::pair<size_t, size_t>> entries;
+    for (size_t t = 0; t < tables_.size(); ++t) {
+        if (tables_[t].scripts == 0) continue;
+        for (size_t i = 0; i < tables_[t].multipliers.size(); ++i) {
+            if (tables_[t].allowed[i]) entries.emplace_back(t, i);
+        }
+    }
+
+    std::vector<std::vector<int>> weights = initial_;
+    if (randomStart) {
+        std::uniform_int_distribution<int> draw(0, maxWeight_);
+        for (const auto& [t, i] : entries) weights[t][i] = draw(rng);
+    }
+    std::vector<int> totals;
+    for (size_t t = 0; t < weights.size(); ++t) {
+        int total = 0;
+        for (int x : weights[t]) total += x;
+        if (total == 0 && tables_[t].scripts > 0) {
+            for (const auto& [et, i] : entries) {
+                if (et == t && total == 0) weights[t][i] = total = 1;
+            }
+        }
+        totals.push_back(total);
+    }
+
+    auto better = [](const MultiplierResult& a, const MultiplierResult& b) {
+        if (a.feasible != b.feasible) return a.feasible;
+        return a.score < b.score;
+    };
+
+    MultiplierResult current = evaluate(weights);
+    MultiplierResult best = current;
+    if (entries.empty()) return best;
+
+    // Geometric cooling
+    const double t0 = 1.0, t1 = 1.0e-6;
+    const double cooling = std::pow(t1 / t0, 1.0 / std::max(1, iterations));
+    double temperature = t0;
+
+    for (int it = 0; it < iterations; ++it, temperature *= cooling) {
+        // Either change one weight, or move weight between two entries of the same table
+        const auto [t, i] = entries[std::uniform_int_distribution<size_t>(0, entries.size() - 1)(rng)];
+        const int step = std::uniform_int_distribution<int>(1, 3)(rng);
+        const int delta = unit(rng) < 0.5 ? -step : step;
+        size_t j = i;
+        if (unit(rng) < 0.5) {
+            j = std::uniform_int_distribution<size_t>(0, tables_[t].multipliers.size() - 1)(rng);
+            if (j == i || !tables_[t].allowed[j]) continue;
+        }
+        const int wi = weights[t][i] + delta;
+        const int wj = j == i ? 0 : weights[t][j] - delta;
+        if (wi < 0 || wi > maxWeight_ || (j != i && (wj < 0 || wj > maxWeight_))) continue;
+        if (j == i && totals[t] + delta <= 0) continue;
+
+        const int oldI = weights[t][i], oldJ = weights[t][j];
+        weights[t][i] = wi;
+        if (j != i) weights[t][j] = wj;
+
+        MultiplierResult candidate = evaluate(weights);
+        const double change = candidate.score - current.score;
+        if ((candidate.feasible && !current.feasible) || change <= 0.0 || unit(rng) < std::exp(-change / temperature)) {
+            if (j == i) totals[t] += delta;
+            current = std::move(candidate);
+            if (better(current, best)) best = current;
+        } else {
+            weights[t][i] = oldI;
+            weights[t][j] = oldJ;
+        }
+    }
+    return best;
+}
+
+MultiplierResult MultiplierOptimizer::optimize(int threads, uint64_t seed, int restarts, int iterations) const {
+    restarts = std::max(1, restarts);
+    std::vector<MultiplierResult> results(restarts);
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int run = next++; run < restarts; run = next++) {
+            // Run 0 refines the starting table, the others start from random weights
+            results[run] = search(mixSeed(seed, run), iterations, run > 0);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < std::max(1, std::min(threads, restarts)); ++t) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+
+    // Best by feasibility, then score; ties keep the lowest run index
+    size_t best = 0;
+    for (size_t run = 1; run < results.size(); ++run) {
+        const auto& a = results[run];
+        const auto& b = results[best];
+        if ((a.feasible && !b.feasible) || (a.feasible == b.feasible && a.score < b.score)) best = run;
+    }
+    return results[best];
+}
+
+nlohmann::json MultiplierOptimizer::toJson(const std::vector<std::vector<int>>& weights) const {
+    nlohmann::json out = json_;
+    for (size_t t = 0; t < tables_.size(); ++t) out["free"][t]["weight"] = weights[t];
+    return out;
+}
@@ -0,0 +1,89 @@
+// MultiplierOptimizer.hpp
+#pragma once
+#include "SS02Analytic.hpp"
+#include "json.hpp"
+#include <cstdint>
+#include <vector>
+
+// What the free game should pay under the tuned multiplier tables
+struct MultiplierTarget {
+    double freeRtpMin = 0.0;          // Window on the FG share of the RTP
+    double freeRtpMax = 0.0;
+    double sessionStdDev = 0.0;       // Std dev of one free game session's total win (0 = no target)
+    double maxWin = 0.0;              // Cap on a single free spin's win, not a session's (0 = no cap)
+    double stdDevWeight = 1.0;        // Weight of the std dev term against the RTP term
+
+    // FG window = game_RTP * (1 - BG_percent), cap = FG_max. Like the script selection and
+    // enumeration tools, FG_max is read as a per-script (per free spin) cap.
+    static MultiplierTarget fromGameConfig(const nlohmann::json& gameConfig);
+};
+
+struct MultiplierResult {
+    std::vector<std::vector<int>> weights;   // Per table, parallel to the table's multipliers
+    double freeSpinMean = 0.0, freeSpinVariance = 0.0;
+    double sessionMean = 0.0, sessionVariance = 0.0;
+    double freeRtp = 0.0;
+    double maxWin = 0.0;                     // Largest reachable single free spin win
+    bool feasible = false;                   // FG RTP in the window and max win under the cap
+    double score = 0.0;
+};
+
+// Integer weight search for the free game multiplier tables (SS02Pay.cpp table format).
+//
+// A free script with k MULTIPLIER cells on table t pays basePayout * sum(draw - 100), so with
+// m = E[draw - 100] and v = E[(draw - 100)^2] of table t its first two moments are
+// basePayout * k * m and basePayout^2 * (k * v + k * (k - 1) * m^2). Summed over the scripts,
+// each table reduces to three constants and the free spin moments - and from them the session
+// moments and FG RTP of SS02AnalyticRtp - cost a few operations per candidate weight vector.
+// Entries whose multiplier could push a script on that table over the max-win cap are held at
+// zero in the search's starting point; the others are searched by simulated annealing with
+// parallel restarts.
+class MultiplierOptimizer {
+public:
+    // tables: {"free": [{"id", "multiplier", "weight"}, ...]}; its weights, clamped to the cap and
+    // maxWeight, are the starting point.
+    // Throws std::runtime_error if a script uses a table that is not in `tables`.
+    MultiplierOptimizer(const ScriptOutcomeCache& cache, const RtpParameters& params, const nlohmann::json& tables,
+                        const MultiplierTarget& target, int maxWeight);
+
+    MultiplierResult evaluate(const std::vector<std::vector<int>>& weights) const;
+
+    // Best of `restarts` searches of `iterations` moves; only depends on the seed, not on the
+    // thread count
+    MultiplierResult optimize(int threads, uint64_t seed, int restarts, int iterations) const;
+
+    // `tables` with its weights replaced
+    nlohmann::json toJson(const std::vector<std::vector<int>>& weights) const;
+
+    // Weights of `tables` as given, and the clamped starting point of the search
+    const std::vector<std::vector<int>>& liveWeights() const { return live_; }
+    const std::vector<std::vector<int>>& initialWeights() const { return initial_; }
+    size_t tableCount() const { return tables_.size(); }
+    int tableId(size_t t) const { return tables_[t].id; }
+    const std::vector<int>& multipliers(size_t t) const { return tables_[t].multipliers; }
+    bool used(size_t t) const { return tables_[t].scripts > 0; }
+    bool allowed(size_t t, size_t i) const { return tables_[t].allowed[i]; }
+
+private:
+    struct Table {
+        int id = 0;
+        std::vector<int> multipliers;
+        std::vector<bool> allowed;     // Within the max-win cap
+        size_t scripts = 0;
+        double a = 0.0, b = 0.0, c = 0.0;   // Per free spin: E[bp * k], E[bp^2 * k], E[bp^2 * k^2] over this table's scripts
+        double maxUnit = 0.0;               // max bp * k
+    };
+
+    MultiplierResult search(uint64_t seed, int iterations, bool randomStart) const;
+    double score(const MultiplierResult& r) const;
+
+    RtpParameters params_;
+    MultiplierTarget target_;
+    int maxWeight_;
+    nlohmann::json json_;
+    std::vector<Table> tables_;
+    std::vector<std::vector<int>> live_;
+    std::vector<std::vector<int>> initial_;
+    double fixedMean_ = 0.0, fixedSecond_ = 0.0;   // Free scripts without multiplier draws
+    double fixedMax_ = 0.0;
+};
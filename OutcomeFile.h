@@ -0,0 +1,111 @@
+#pragma once
+
+#include "SS02Analytic.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+// Script outcome cache as a flat binary file that worker processes map read-only, so N
+// workers share one copy of the outcomes through the page cache instead of each loading and
+// evaluating the scripts.
+//
+// File layout (native ScriptOutcome records, little-endian):
+//   header, 48 bytes: "SS02OUTC", u32 version, u32 record size, u64 base, free and buy
+//                     counts, u64 fingerprint (ScriptOutcomeView::fingerprint)
+//   records: base, then free, then buy outcomes
+struct OutcomeFile {
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER = 48;
+    static_assert(std::is_trivially_copyable<ScriptOutcome>::value && std::is_standard_layout<ScriptOutcome>::value,
+                  "ScriptOutcome records are mapped in place");
+    static_assert(HEADER % alignof(ScriptOutcome) == 0, "Records must stay aligned after the header");
+
+    static void write(const std::string& path, const ScriptOutcomeCache& cache) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot write " + path);
+        }
+        char header[HEADER] = {};
+        const uint32_t recordSize = sizeof(ScriptOutcome);
+        const uint64_t counts[3] = {cache.base.size(), cache.free.size(), cache.buy.size()};
+        const uint64_t fingerprint = cache.fingerprint();
+        std::memcpy(header, "SS02OUTC", 8);
+        std::memcpy(header + 8, &VERSION, 4);
+        std::memcpy(header + 12, &recordSize, 4);
+        std::memcpy(header + 16, counts, sizeof(counts));
+        std::memcpy(header + 40, &fingerprint, 8);
+        out.write(header, HEADER);
+        for (const auto* section : {&cache.base, &cache.free, &cache.buy}) {
+            out.write(reinterpret_cast<const char*>(section->data()),
+                      static_cast<std::streamsize>(section->size() * sizeof(ScriptOutcome)));
+        }
+        if (!out) {
+            throw std::runtime_error("Failed writing " + path);
+        }
+    }
+
+    // Read-only shared mapping of an outcome file; the view stays valid while the mapping lives
+    class Mapping {
+    public:
+        explicit Mapping(const std::string& path) {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Cannot open " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER) {
+                ::close(fd);
+                throw std::runtime_error(path + " is not an outcome file");
+            }
+            size_ = static_cast<size_t>(st.st_size);
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED) {
+                throw std::runtime_error("Cannot map " + path);
+            }
+            data_ = static_cast<const char*>(data);
+
+            uint32_t version, recordSize;
+            uint64_t counts[3], fingerprint;
+            std::memcpy(&version, data_ + 8, 4);
+            std::memcpy(&recordSize, data_ + 12, 4);
+            std::memcpy(counts, data_ + 16, sizeof(counts));
+            std::memcpy(&fingerprint, data_ + 40, 8);
+            if (std::memcmp(data_, "SS02OUTC", 8) != 0 || version != VERSION || recordSize != sizeof(ScriptOutcome) ||
+                size_ != HEADER + (counts[0] + counts[1] + counts[2]) * sizeof(ScriptOutcome)) {
+                release();
+                throw std::runtime_error(path + " is not a compatible outcome file");
+            }
+            const auto* records = reinterpret_cast<const ScriptOutcome*>(data_ + HEADER);
+            view_.base = {records, counts[0]};
+            view_.free = {records + counts[0], counts[1]};
+            view_.buy = {records + counts[0] + counts[1], counts[2]};
+            if (view_.fingerprint() != fingerprint) {
+                release();
+                throw std::runtime_error(path + " is corrupt (fingerprint mismatch)");
+            }
+        }
+        ~Mapping() { release(); }
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        const ScriptOutcomeView& view() const { return view_; }
+
+    private:
+        void release() {
+            if (data_) ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+        ScriptOutcomeView view_;
+    };
+};
@@ -0,0 +1,227 @@
+#ifndef REEL_CONVERTER_H
+#define REEL_CONVERTER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include "json.hpp"
+#include "SlotPay.hpp"
+
+// One converted script as the backend stores it: per column, the symbols dropped into the
+// column in order (first the initial board bottom to top, then every refill)
+struct ReelScript {
+    int number = 0;
+    int stopover = 0;
+    int multiple_table = 0;
+    std::vector<std::vector<int>> reels;
+};
+
+struct ReelScriptSet {
+    std::vector<ReelScript> base;
+    std::vector<ReelScript> free;
+};
+
+// Boards rebuilt from a reel script
+struct ReelReplay {
+    std::vector<Board> boards;
+    bool exhausted = false;     // A refill needed more symbols than the reel holds
+    int unusedSymbols = 0;      // Reel symbols never dropped
+};
+
+// Board script -> reel strip conversion shared by SS02_convertpay and the tools that
+// benchmark or verify it. Columns are read bottom to top, the order in which the backend
+// drops symbols into a column.
+class ReelConverter {
+public:
+    // Column `col` of a board, bottom row first
+    static std::vector<int> boardColumn(const Board& board, int col) {
+        std::vector<int> column;
+        for (int row = static_cast<int>(board.size()) - 1; row >= 0; --row) {
+            if (board[row].size() > static_cast<size_t>(col)) {
+                column.push_back(board[row][col]);
+            }
+        }
+        return column;
+    }
+
+    // Function to find overlap using subsequence matching
+    // Finds longest consecutive prefix of currentBoard that appears as a subsequence in previousBoard
+    // Does not allow prefix to end with eliminated symbols
+    static int findBoardOverlap(const std::vector<int>& previousBoard, const std::vector<int>& currentBoard,
+                                const MatchPatterns& eliminationPatterns, int currentCol) {
+        int maxOverlap = 0;
+
+        // Try all possible prefix lengths of currentBoard (from longest to shortest)
+        for (int prefixLen = static_cast<int>(currentBoard.size()); prefixLen >= 1; --prefixLen) {
+
+            // Check if the last symbol of this prefix is an eliminated symbol
+            bool endsWithEliminatedSymbol = false;
+            int lastSymbol = currentBoard[prefixLen - 1];
+
+            for (const auto& [symbol, positions] : eliminationPatterns) {
+                for (const auto& [row, col] : positions) {
+                    if (col == currentCol && symbol == lastSymbol) {
+                        endsWithEliminatedSymbol = true;
+                        break;
+                    }
+                }
+                if (endsWithEliminatedSymbol) break;
+            }
+
+            // Skip this prefix if it ends with an eliminated symbol
+            if (endsWithEliminatedSymbol) {
+                continue;
+            }
+
+            // Check if this prefix exists as a subsequence in previousBoard
+            int prevIndex = 0;
+            int matchCount = 0;
+
+            for (int currIndex = 0; currIndex < prefixLen; ++currIndex) {
+                // Look for currentBoard[currIndex] in previousBoard starting from prevIndex
+                while (prevIndex < static_cast<int>(previousBoard.size()) &&
+                       previousBoard[prevIndex] != currentBoard[currIndex]) {
+                    prevIndex++;
+                }
+
+                if (prevIndex < static_cast<int>(previousBoard.size())) {
+                    // Found a match
+                    matchCount++;
+                    prevIndex++; // Move to next position for next search
+                } else {
+                    // No match found for this element
+                    break;
+                }
+            }
+
+            // If all elements in the prefix were found as a subsequence
+            if (matchCount == prefixLen) {
+                maxOverlap = prefixLen;
+                return maxOverlap; // Return the first (longest) match found
+            }
+        }
+
+        return maxOverlap;
+    }
+
+    // Smart conversion of one script: the first board fills every column, each later board
+    // only appends the part of its column not already covered by the previous board.
+    // `eliminationPatterns[i]` are the matches removed from board i (from SlotSS02::steps).
+    static std::vector<std::vector<int>> buildSmartReels(const std::vector<Board>& script,
+                                                         const std::vector<MatchPatterns>& eliminationPatterns,
+                                                         int columns = 6) {
+        std::vector<std::vector<int>> reels(columns);
+        for (int col = 0; col < columns; ++col) {
+            std::vector<int>& finalReel = reels[col];
+            for (size_t boardIdx = 0; boardIdx < script.size(); ++boardIdx) {
+                std::vector<int> currentBoardColumn = boardColumn(script[boardIdx], col);
+
+                if (boardIdx == 0) {
+                    finalReel.insert(finalReel.end(), currentBoardColumn.begin(), currentBoardColumn.end());
+                } else {
+                    std::vector<int> previousBoardColumn = boardColumn(script[boardIdx - 1], col);
+
+                    MatchPatterns patterns;
+                    if (boardIdx - 1 < eliminationPatterns.size()) {
+                        patterns = eliminationPatterns[boardIdx - 1];
+                    }
+
+                    int maxOverlap = findBoardOverlap(previousBoardColumn, currentBoardColumn, patterns, col);
+
+                    for (size_t i = maxOverlap; i < currentBoardColumn.size(); ++i) {
+                        finalReel.push_back(currentBoardColumn[i]);
+                    }
+                }
+            }
+        }
+        return reels;
+    }
+
+    // One backend entry: {"number", "stopover", ["multiple_table"], "script": [{"index", "reel"}]}
+    static ReelScript parseEntry(const nlohmann::json& entry) {
+        ReelScript script;
+        script.number = entry.at("number").get<int>();
+        script.stopover = entry.at("stopover").get<int>();
+        script.multiple_table = entry.value("multiple_table", 0);
+        for (const auto& column : entry.at("script")) {
+            size_t index = column.at("index").get<size_t>();
+            if (script.reels.size() <= index) script.reels.resize(index + 1);
+            script.reels[index] = column.at("reel").get<std::vector<int>>();
+        }
+        return script;
+    }
+
+    // Reads converter output (SS02_scripts_smart.json, written without outer braces) or a
+    // backend file with the scripts under "data" (Insert_Script.json)
+    static ReelScriptSet loadReelFile(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open reel file: " + filename);
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        size_t first = content.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            throw std::runtime_error("Reel file is empty: " + filename);
+        }
+        nlohmann::json j = nlohmann::json::parse(content[first] == '{' ? content : "{" + content + "}");
+        const nlohmann::json& data = j.contains("data") ? j.at("data") : j;
+
+        auto parseSection = [](const nlohmann::json& entries) {
+            std::vector<ReelScript> scripts;
+            for (const auto& entry : entries) scripts.push_back(parseEntry(entry));
+            return scripts;
+        };
+
+        ReelScriptSet set;
+        if (data.contains("base")) set.base = parseSection(data.at("base"));
+        if (data.contains("free")) set.free = parseSection(data.at("free"));
+        return set;
+    }
+
+    // Rebuilds the board sequence the way the backend plays a reel script: the first
+    // `height` symbols of each reel form the column (bottom up); after every winning step
+    // matches are eliminated, the columns collapse and the empty cells on top are filled,
+    // bottom up, with the next symbols of the reel. Stops at the first board without a win.
+    static ReelReplay replay(SlotBase& game, const ReelScript& script, int height = 5) {
+        ReelReplay result;
+        const int width = static_cast<int>(script.reels.size());
+        std::vector<size_t> next(width, 0);
+
+        auto fill = [&](Board& board) {
+            for (int col = 0; col < width; ++col) {
+                const auto& reel = script.reels[col];
+                for (int row = height - 1; row >= 0; --row) {
+                    if (board[row][col] != -1) continue;
+                    if (next[col] >= reel.size()) {
+                        result.exhausted = true;
+                        return;
+                    }
+                    board[row][col] = reel[next[col]++];
+                }
+            }
+        };
+
+        Board board(height, std::vector<int>(width, -1));
+        fill(board);
+        result.boards.push_back(board);
+        // A cascade can never be longer than the symbols available to refill it
+        size_t maxSteps = 1;
+        for (const auto& reel : script.reels) maxSteps += reel.size();
+        while (!result.exhausted && result.boards.size() < maxSteps) {
+            auto [patterns, has_match] = game.find_matches(board);
+            if (!has_match) break;
+            board = game.apply_gravity(game.eliminate_matches(board, patterns));
+            fill(board);
+            if (result.exhausted) break;
+            result.boards.push_back(board);
+        }
+        for (int col = 0; col < width; ++col) {
+            result.unusedSymbols += static_cast<int>(script.reels[col].size() - next[col]);
+        }
+        return result;
+    }
+};
+
+#endif // REEL_CONVERTER_H
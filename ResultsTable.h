@@ -0,0 +1,168 @@
+#pragma once
+
+#include "BoardAnalyzer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Columnar validation results (script_results.ss02r), the compact replacement for
+// script_results.json. Every per-script field is one fixed-width column, so a reader loads
+// a column with a single read (or numpy.frombuffer) instead of parsing nested JSON.
+//
+// File layout (little-endian):
+//   header, 32 bytes: "SS02RSLT", u32 version, u32 rows, u32 base rows, u32 max patterns,
+//                     f64 FG trigger probability
+//   columns, each starting at a multiple of 8 bytes (zero padding in between), in order:
+//     index             i32[rows]
+//     section           u8[rows]       0 base, 1 free
+//     expected_payout   f64[rows]
+//     calculated_payout f64[rows]
+//     expected_stop     i32[rows]
+//     actual_stop       i32[rows]
+//     mismatch          u8[rows]       bit 0 payout, bit 1 stop, bit 2 cascading
+//     pattern_count     u8[rows]       first-board clusters (may exceed max patterns)
+//     pattern_symbol    i16[rows * max patterns]   -1 for unused slots
+//     pattern_size      u8[rows * max patterns]    cells in the cluster
+struct ResultsTable {
+    static constexpr uint32_t MAX_PATTERNS = 4;   // An SS02 board fits at most 3 clusters of 8
+    static constexpr uint8_t PAYOUT_MISMATCH = 1;
+    static constexpr uint8_t STOP_MISMATCH = 2;
+    static constexpr uint8_t CASCADING_MISMATCH = 4;
+
+    uint32_t baseRows = 0;
+    double fgTriggerProb = 0.0;
+
+    std::vector<int32_t> index;
+    std::vector<uint8_t> section;
+    std::vector<double> expectedPayout;
+    std::vector<double> calculatedPayout;
+    std::vector<int32_t> expectedStop;
+    std::vector<int32_t> actualStop;
+    std::vector<uint8_t> mismatch;
+    std::vector<uint8_t> patternCount;
+    std::vector<int16_t> patternSymbol;
+    std::vector<uint8_t> patternSize;
+
+    size_t rows() const { return index.size(); }
+
+    bool isFree(size_t row) const { return section[row] != 0; }
+
+    // Cells of `symbol` in the first board's clusters (0 if it did not win there)
+    int clusterSize(size_t row, int symbol) const {
+        for (uint32_t p = 0; p < MAX_PATTERNS; ++p) {
+            if (patternSymbol[row * MAX_PATTERNS + p] == symbol) return patternSize[row * MAX_PATTERNS + p];
+        }
+        return 0;
+    }
+
+    // Results as collected by the test programs: the first baseRows entries are base scripts
+    static ResultsTable fromContext(const AnalysisContext& context, size_t baseRows, double fgTriggerProb) {
+        ResultsTable t;
+        t.baseRows = static_cast<uint32_t>(std::min(baseRows, context.allResults.size()));
+        t.fgTriggerProb = fgTriggerProb;
+        for (size_t i = 0; i < context.allResults.size(); ++i) {
+            const ScriptResult& r = context.allResults[i];
+            t.index.push_back(r.index);
+            t.section.push_back(i < baseRows ? 0 : 1);
+            t.expectedPayout.push_back(r.expectedPayout);
+            t.calculatedPayout.push_back(r.calculatedPayout);
+            t.expectedStop.push_back(r.expectedStop);
+            t.actualStop.push_back(r.actualStop);
+            t.mismatch.push_back((r.payoutMismatch ? PAYOUT_MISMATCH : 0) | (r.stopMismatch ? STOP_MISMATCH : 0) |
+                                 (r.cascadingMismatch ? CASCADING_MISMATCH : 0));
+            t.patternCount.push_back(static_cast<uint8_t>(std::min<size_t>(r.firstBoardPatterns.size(), 255)));
+            for (uint32_t p = 0; p < MAX_PATTERNS; ++p) {
+                const bool used = p < r.firstBoardPatterns.size();
+                t.patternSymbol.push_back(static_cast<int16_t>(used ? r.firstBoardPatterns[p].symbol : -1));
+                t.patternSize.push_back(static_cast<uint8_t>(used ? r.firstBoardPatterns[p].count : 0));
+            }
+        }
+        return t;
+    }
+
+    void save(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + filename);
+        }
+        const uint32_t header[] = {kVersion, static_cast<uint32_t>(rows()), baseRows, MAX_PATTERNS};
+        file.write(kMagic, sizeof(kMagic));
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&fgTriggerProb), sizeof(fgTriggerProb));
+        size_t offset = kHeaderBytes;
+        auto column = [&](const auto& values) {
+            static const char zeros[8] = {};
+            file.write(zeros, static_cast<std::streamsize>((8 - offset % 8) % 8));
+            offset += (8 - offset % 8) % 8;
+            const size_t bytes = values.size() * sizeof(values[0]);
+            file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(bytes));
+            offset += bytes;
+        };
+        column(index);
+        column(section);
+        column(expectedPayout);
+        column(calculatedPayout);
+        column(expectedStop);
+        column(actualStop);
+        column(mismatch);
+        column(patternCount);
+        column(patternSymbol);
+        column(patternSize);
+        if (!file) {
+            throw std::runtime_error("Failed to write " + filename);
+        }
+    }
+
+    static ResultsTable load(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open " + filename);
+        }
+        char magic[sizeof(kMagic)] = {};
+        uint32_t header[4] = {};
+        ResultsTable t;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        file.read(reinterpret_cast<char*>(&t.fgTriggerProb), sizeof(t.fgTriggerProb));
+        if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error(filename + " is not a columnar results file");
+        }
+        if (header[0] != kVersion || header[3] != MAX_PATTERNS) {
+            throw std::runtime_error(filename + ": unsupported version " + std::to_string(header[0]));
+        }
+        const size_t n = header[1];
+        t.baseRows = header[2];
+        size_t offset = kHeaderBytes;
+        auto column = [&](auto& values, size_t count) {
+            file.ignore(static_cast<std::streamsize>((8 - offset % 8) % 8));
+            offset += (8 - offset % 8) % 8;
+            values.resize(count);
+            const size_t bytes = count * sizeof(values[0]);
+            file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(bytes));
+            offset += bytes;
+        };
+        column(t.index, n);
+        column(t.section, n);
+        column(t.expectedPayout, n);
+        column(t.calculatedPayout, n);
+        column(t.expectedStop, n);
+        column(t.actualStop, n);
+        column(t.mismatch, n);
+        column(t.patternCount, n);
+        column(t.patternSymbol, n * MAX_PATTERNS);
+        column(t.patternSize, n * MAX_PATTERNS);
+        if (!file) {
+            throw std::runtime_error(filename + " is truncated");
+        }
+        return t;
+    }
+
+private:
+    static constexpr char kMagic[8] = {'S', 'S', '0', '2', 'R', 'S', 'L', 'T'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderBytes = 32;
+};
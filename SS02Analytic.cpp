@@ -0,0 +1,451 @@
+#include "SS02Analytic.hpp"
+#include "SS02BatchEval.hpp"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Complex = std::complex<double>;
+
+// Discrete payout distribution: value -> probability
+using Discrete = std::map<double, double>;
+
+// Plain complex product; std::complex operator* goes through the slow Annex G NaN path
+inline Complex mul(const Complex& a, const Complex& b) {
+    return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+void fft(std::vector<Complex>& a, bool inverse) {
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double angle = 2.0 * M_PI / static_cast<double>(len) * (inverse ? 1.0 : -1.0);
+        Complex step(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len) {
+            Complex w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k) {
+                Complex u = a[i + k];
+                Complex v = mul(a[i + k + len / 2], w);
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w = mul(w, step);
+            }
+        }
+    }
+    if (inverse) {
+        for (auto& x : a) x /= static_cast<double>(n);
+    }
+}
+
+Complex ipow(Complex z, int n) {
+    Complex result(1.0, 0.0);
+    for (; n > 0; n >>= 1, z = mul(z, z)) {
+        if (n & 1) result = mul(result, z);
+    }
+    return result;
+}
+
+// Distribution of sum(draw - 100) over `count` draws of a multiplier table
+Discrete multiplierSum(const nlohmann::json& tables, int table, int count) {
+    const nlohmann::json* entry = nullptr;
+    for (const auto& t : tables.at("free")) {
+        if (t.at("id").get<int>() == table) entry = &t;
+    }
+    if (!entry) {
+        throw std::runtime_error("Multiplier table " + std::to_string(table) + " not found");
+    }
+    const auto multipliers = entry->at("multiplier").get<std::vector<int>>();
+    const auto weights = entry->at("weight").get<std::vector<double>>();
+    double total = 0.0;
+    for (double w : weights) total += w;
+    if (total <= 0.0 || multipliers.size() != weights.size()) {
+        throw std::runtime_error("Multiplier table " + std::to_string(table) + " has no usable weights");
+    }
+
+    Discrete sum{{0.0, 1.0}};
+    for (int draw = 0; draw < count; ++draw) {
+        Discrete next;
+        for (const auto& [value, p] : sum) {
+            for (size_t i = 0; i < multipliers.size(); ++i) {
+                if (weights[i] > 0.0) next[value + multipliers[i] - 100] += p * weights[i] / total;
+            }
+        }
+        sum.swap(next);
+    }
+    return sum;
+}
+
+// Put mass p at `value` onto the grid, split between the two nearest bins so the mean is exact
+void spread(std::vector<Complex>& grid, double value, double p, double binWidth) {
+    double x = value / binWidth;
+    size_t i = static_cast<size_t>(x);
+    if (i + 1 >= grid.size()) {
+        grid.back() += p;
+        return;
+    }
+    double frac = x - static_cast<double>(i);
+    grid[i] += p * (1.0 - frac);
+    grid[i + 1] += p * frac;
+}
+
+PayoutDistribution toDistribution(std::vector<Complex>& transform, double binWidth) {
+    fft(transform, true);
+    PayoutDistribution d;
+    d.binWidth = binWidth;
+    d.pmf.resize(transform.size());
+    for (size_t i = 0; i < transform.size(); ++i) d.pmf[i] = std::max(0.0, transform[i].real());
+    return d;
+}
+
+}  // namespace
+
+ScriptOutcomeCache ScriptOutcomeCache::build(const ScriptApp::ScriptConfig& config) {
+    ScriptOutcomeCache cache;
+    auto evaluateSection = [](const std::map<int, ScriptApp::ScriptData>& scripts, const std::string& gameType,
+                              int tableOffset, std::vector<ScriptOutcome>& out) {
+        SlotSS02 game(true, 20.0f, gameType);
+        SS02BatchEvaluator evaluator(game);
+        std::vector<const std::vector<Board>*> boards;
+        std::vector<int> specials;
+        for (const auto& [index, scriptData] : scripts) {
+            boards.push_back(&scriptData.script);
+            specials.push_back(scriptData.special_multipliers);
+        }
+        auto results = evaluator.evaluate(boards, specials);
+
+        size_t i = 0;
+        for (const auto& [index, scriptData] : scripts) {
+            const auto& r = results[i++];
+            ScriptOutcome outcome;
+            outcome.payout = r.score;
+            outcome.basePayout = r.score;
+            outcome.table = scriptData.multiple_table + tableOffset;
+            if (gameType == "free" && r.multiplier_count > 0) {
+                outcome.multiplierCount = r.multiplier_count;
+                outcome.basePayout = static_cast<double>(r.score) / (r.multiplier_count * scriptData.special_multipliers);
+            }
+            out.push_back(outcome);
+        }
+    };
+    evaluateSection(config.base_scripts, "base", 1, cache.base);
+    evaluateSection(config.free_scripts, "free", 1, cache.free);
+    evaluateSection(config.buy_free_scripts, "free", 0, cache.buy);
+    return cache;
+}
+
+uint64_t ScriptOutcomeView::fingerprint() const {
+    Checkpoint::Fingerprint hash;
+    for (const auto* section : {&base, &free, &buy}) {
+        hash.add<uint64_t>(section->size());
+        for (const auto& o : *section) {
+            hash.add(o.payout).add(o.basePayout).add(o.multiplierCount).add(o.table);
+        }
+    }
+    return hash.value();
+}
+
+ScriptApp::ScriptConfig loadSS02Scripts(const std::string& filename) {
+    SlotSS02 baseGame(true, 20.0f, "base");
+    SlotSS02 freeGame(true, 20.0f, "free");
+    return ScriptApp::ScriptConfig::loadFromFile(filename, [&](const ReelScript& reel, bool isFree) {
+        return ReelConverter::replay(isFree ? freeGame : baseGame, reel).boards;
+    });
+}
+
+RtpParameters RtpParameters::fromGame(const SlotSS02& game) {
+    RtpParameters params;
+    params.fgTrigger = game.get_fg_trigger_probability();
+    params.fgRetrigger = game.get_fg_retrigger_probability();
+    params.volatility = game.get_volatility_type();
+    return params;
+}
+
+void RtpParameters::checkVolatility(const std::string& volatility) {
+    // SlotSS02::get_multiplier_table falls back to the high set for unknown names
+    if (volatility != "low" && volatility != "high") {
+        throw std::runtime_error("Unknown volatility \"" + volatility + "\" (expected low or high)");
+    }
+}
+
+nlohmann::json RtpParameters::multiplierTables() const {
+    checkVolatility(volatility);
+    return multiplierTable.is_null() ? SlotSS02::get_multiplier_table(volatility) : multiplierTable;
+}
+
+double PayoutDistribution::quantile(double q) const {
+    double cumulative = 0.0;
+    for (size_t i = 0; i < pmf.size(); ++i) {
+        cumulative += pmf[i];
+        if (cumulative >= q) return static_cast<double>(i) * binWidth;
+    }
+    return static_cast<double>(pmf.size() - 1) * binWidth;
+}
+
+double PayoutDistribution::exceedance(double payout) const {
+    double tail = 0.0;
+    for (size_t i = pmf.size(); i-- > 0 && static_cast<double>(i) * binWidth >= payout;) tail += pmf[i];
+    return tail;
+}
+
+RtpReport SS02AnalyticRtp::solve(const RtpParameters& params, size_t gridSize) const {
+    if (cache_.base.empty() || cache_.free.empty()) {
+        throw std::runtime_error("Analytic RTP needs both base and free scripts");
+    }
+    const double R = params.fgRounds;
+    const double r = params.fgRetrigger;
+    const double p = params.fgTrigger;
+    if (R * r >= 1.0) {
+        throw std::runtime_error("fgRounds * fgRetrigger >= 1: free game sessions never end");
+    }
+
+    // Per-spin distributions; a bought session plays buy_free spins when there are any
+    Discrete base;
+    const double baseP = 1.0 / cache_.base.size();
+    for (const auto& o : cache_.base) base[o.payout] += baseP;
+
+    RtpReport report;
+    const nlohmann::json tables = params.multiplierTables();
+    std::map<std::pair<int, int>, Discrete> sums;
+    auto freeSpinDistribution = [&](const std::vector<ScriptOutcome>& scripts) {
+        Discrete spin;
+        const double scriptP = 1.0 / scripts.size();
+        for (const auto& o : scripts) {
+            if (!params.drawMultipliers || o.multiplierCount == 0) {
+                spin[o.payout] += scriptP;
+                continue;
+            }
+            auto key = std::make_pair(o.table, o.multiplierCount);
+            auto it = sums.find(key);
+            if (it == sums.end()) it = sums.emplace(key, multiplierSum(tables, o.table, o.multiplierCount)).first;
+            for (const auto& [s, ps] : it->second) spin[o.basePayout * s] += scriptP * ps;
+        }
+        return spin;
+    };
+    for (const auto& o : cache_.free) report.freeScriptMean += o.payout / static_cast<double>(cache_.free.size());
+    const Discrete freeSpin = freeSpinDistribution(cache_.free);
+    const Discrete buySpin = cache_.buy.empty() ? freeSpin : freeSpinDistribution(cache_.buy);
+
+    auto moments = [](const Discrete& d, double& mean, double& variance) {
+        double m1 = 0.0, m2 = 0.0;
+        for (const auto& [value, prob] : d) {
+            m1 += value * prob;
+            m2 += value * value * prob;
+        }
+        mean = m1;
+        variance = std::max(0.0, m2 - m1 * m1);
+    };
+    moments(base, report.baseMean, report.baseVariance);
+    moments(freeSpin, report.freeSpinMean, report.freeSpinVariance);
+    moments(buySpin, report.buySpinMean, report.buySpinVariance);
+
+    // Spin blocks: Galton-Watson total progeny with Binomial(R, r) offspring
+    const double mu = R * r;
+    const double sigma2 = R * r * (1.0 - r);
+    report.sessionLengthMean = R / (1.0 - mu);
+    report.sessionLengthVariance = R * R * sigma2 / std::pow(1.0 - mu, 3);
+
+    // Compound sums over the random session length
+    report.sessionMean = report.sessionLengthMean * report.freeSpinMean;
+    report.sessionVariance = report.sessionLengthMean * report.freeSpinVariance +
+                             report.sessionLengthVariance * report.freeSpinMean * report.freeSpinMean;
+    report.spinMean = report.baseMean + p * report.sessionMean;
+    report.spinVariance = report.baseVariance + p * report.sessionVariance +
+                          p * (1.0 - p) * report.sessionMean * report.sessionMean;
+    report.baseRtp = report.baseMean / params.bet;
+    report.freeRtp = p * report.sessionMean / params.bet;
+    report.rtp = report.spinMean / params.bet;
+    report.buyMean = report.sessionLengthMean * report.buySpinMean;
+    report.buyVariance = report.sessionLengthMean * report.buySpinVariance +
+                         report.sessionLengthVariance * report.buySpinMean * report.buySpinMean;
+    report.buyRtp = report.buyMean / (params.buyCost * params.bet);
+
+    if (gridSize == 0) return report;
+
+    // Grid wide enough for the bulk of a free or bought session total plus one base spin;
+    // mass beyond 40 standard deviations is folded into the last bin
+    const double span = base.rbegin()->first + std::max(report.sessionMean, report.buyMean) +
+                        40.0 * std::sqrt(std::max(report.sessionVariance, report.buyVariance));
+    size_t size = 2;
+    while (size < gridSize && static_cast<double>(size) < span + 2.0) size <<= 1;
+    const double binWidth = std::max(1.0, span / static_cast<double>(size - 2));
+
+    std::vector<Complex> phiFree(size), phiBase(size), phiBuy(size);
+    for (const auto& [value, prob] : freeSpin) spread(phiFree, value, prob, binWidth);
+    for (const auto& [value, prob] : base) spread(phiBase, value, prob, binWidth);
+    for (const auto& [value, prob] : buySpin) spread(phiBuy, value, prob, binWidth);
+    fft(phiFree, false);
+    fft(phiBase, false);
+    fft(phiBuy, false);
+
+    // Session transform: root of B = g(B) = (phi * (1 - r + r * B))^R per frequency, by
+    // Newton's method (|g'| <= R * r < 1). The inputs are real, so the upper half of the
+    // spectrum is the conjugate of the lower.
+    std::vector<Complex> session(size), spin(size), buy(size);
+    const int rounds = params.fgRounds;
+    auto sessionTransform = [&](const Complex& phi) {
+        Complex b = ipow(phi, rounds);
+        for (int it = 0; it < 50; ++it) {
+            Complex c = mul(phi, (1.0 - r) + r * b);
+            Complex cPow = ipow(c, rounds - 1);
+            Complex g = mul(cPow, c);
+            Complex slope = 1.0 - static_cast<double>(rounds) * r * mul(phi, cPow);
+            Complex step = mul(b - g, std::conj(slope)) / std::norm(slope);
+            b -= step;
+            if (std::norm(step) < 1e-28) break;
+        }
+        return b;
+    };
+    for (size_t k = 0; k <= size / 2; ++k) {
+        const Complex b = sessionTransform(phiFree[k]);
+        session[k] = b;
+        spin[k] = mul(phiBase[k], (1.0 - p) + p * b);
+        buy[k] = cache_.buy.empty() ? b : sessionTransform(phiBuy[k]);
+        if (k > 0 && k < size / 2) {
+            session[size - k] = std::conj(session[k]);
+            spin[size - k] = std::conj(spin[k]);
+            buy[size - k] = std::conj(buy[k]);
+        }
+    }
+    report.session = toDistribution(session, binWidth);
+    report.spin = toDistribution(spin, binWidth);
+    report.buy = toDistribution(buy, binWidth);
+    return report;
+}
+
+FirstCascadeDistribution::FirstCascadeDistribution(const SlotSS02& game)
+    : minMatch_(game.get_min_match_size()), cells_(game.get_board_height() * game.get_board_width()) {
+    const auto& payTable = game.get_config().pay_table;
+    for (int symbol : game.get_symbols()) {
+        if (symbol != static_cast<int>(pay_.size())) {
+            throw std::runtime_error("First cascade distribution expects symbols 0..N-1");
+        }
+        std::vector<int> pays(cells_ + 1, 0);
+        for (int count = minMatch_; count <= cells_; ++count) {
+            // Same lookup / fallback as SlotBase::get_score
+            auto it = payTable.find(symbol);
+            pays[count] = it != payTable.end() && it->second.count(count) ? static_cast<int>(it->second.at(count)) : symbol * count;
+        }
+        pay_.push_back(pays);
+    }
+}
+
+FirstCascadeReport FirstCascadeDistribution::solve(const std::vector<double>& weights, unsigned threads) const {
+    const size_t symbols = pay_.size();
+    if (weights.size() != symbols && weights.size() != symbols + 1) {
+        throw std::runtime_error("Expected " + std::to_string(symbols) + " or " + std::to_string(symbols + 1) + " symbol weights");
+    }
+    double total = 0.0;
+    for (double w : weights) {
+        if (w < 0.0) throw std::runtime_error("Symbol weights must not be negative");
+        total += w;
+    }
+    if (total <= 0.0) throw std::runtime_error("Symbol weights sum to zero");
+    const double other = weights.size() > symbols ? weights.back() / total : 0.0;
+
+    int maxPay = 0;
+    for (const auto& pays : pay_) maxPay += *std::max_element(pays.begin(), pays.end());
+    const size_t width = static_cast<size_t>(maxPay) + 1;
+    const size_t rows = static_cast<size_t>(cells_) + 1;
+
+    // f[(hit * rows + n) * width + pay]: sum over partial count vectors using n cells of
+    // prod(p_s^c_s / c_s!), hit = 1 once any symbol reached the minimum match size. The
+    // multinomial coefficient cells! is applied at the end.
+    auto at = [&](int hit, size_t n) { return (static_cast<size_t>(hit) * rows + n) * width; };
+    std::vector<double> f(2 * rows * width, 0.0), g(f.size());
+    f[at(0, 0)] = 1.0;
+    std::vector<double> term(rows);
+
+    const unsigned workers = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(rows)));
+    for (size_t s = 0; s < symbols; ++s) {
+        const double p = weights[s] / total;
+        for (size_t c = 0; c < rows; ++c) term[c] = std::pow(p, static_cast<double>(c)) / std::tgamma(static_cast<double>(c) + 1.0);
+        std::fill(g.begin(), g.end(), 0.0);
+
+        // Each destination cell count n' = n + c is a partial sum over c owned by one thread;
+        // rows are interleaved because larger n' have more terms
+        auto pass = [&](unsigned t) {
+            for (size_t dest = t; dest < rows; dest += workers) {
+                for (size_t c = 0; c <= dest; ++c) {
+                    if (term[c] == 0.0) continue;
+                    const int pv = pay_[s][c];
+                    const int cluster = static_cast<int>(c) >= minMatch_ ? 1 : 0;
+                    for (int hit = 0; hit < 2; ++hit) {
+                        const double* src = &f[at(hit, dest - c)];
+                        double* dst = &g[at(hit | cluster, dest)] + pv;
+                        for (size_t pay = 0; pay + pv < width; ++pay) dst[pay] += src[pay] * term[c];
+                    }
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < workers; ++t) pool.emplace_back(pass, t);
+        pass(0);
+        for (auto& t : pool) t.join();
+        f.swap(g);
+    }
+
+    // Remaining cells go to the non-paying weight
+    FirstCascadeReport report;
+    report.payout.binWidth = 1.0;
+    report.payout.pmf.assign(width, 0.0);
+    const double cellsFactorial = std::tgamma(static_cast<double>(cells_) + 1.0);
+    for (size_t n = 0; n < rows; ++n) {
+        const double r = static_cast<double>(rows - 1 - n);
+        const double rest = std::pow(other, r) / std::tgamma(r + 1.0) * cellsFactorial;
+        if (rest == 0.0) continue;
+        for (int hit = 0; hit < 2; ++hit) {
+            for (size_t pay = 0; pay < width; ++pay) {
+                const double mass = f[at(hit, n) + pay] * rest;
+                report.payout.pmf[pay] += mass;
+                if (hit == 0) report.terminalProbability += mass;
+            }
+        }
+    }
+    for (size_t pay = 0; pay < width; ++pay) {
+        report.mean += static_cast<double>(pay) * report.payout.pmf[pay];
+    }
+    for (size_t pay = 0; pay < width; ++pay) {
+        const double d = static_cast<double>(pay) - report.mean;
+        report.variance += d * d * report.payout.pmf[pay];
+    }
+    while (report.payout.pmf.size() > 1 && report.payout.pmf.back() == 0.0) report.payout.pmf.pop_back();
+
+    // Marginals: the count of one symbol is Binomial(cells, p)
+    for (size_t s = 0; s < symbols; ++s) {
+        const double p = weights[s] / total;
+        double tail = 0.0;
+        for (int c = minMatch_; c <= cells_; ++c) {
+            tail += std::exp(std::lgamma(cells_ + 1.0) - std::lgamma(c + 1.0) - std::lgamma(cells_ - c + 1.0)) *
+                    std::pow(p, c) * std::pow(1.0 - p, cells_ - c);
+        }
+        report.clusterProbability.push_back(tail);
+    }
+    return report;
+}
+
+std::vector<double> FirstCascadeDistribution::weightsFromScripts(const std::map<int, ScriptApp::ScriptData>& scripts) {
+    std::vector<double> weights(SS02BatchEvaluator::NUM_SYMBOLS + 1, 0.0);
+    for (const auto& [index, scriptData] : scripts) {
+        if (scriptData.script.empty()) continue;
+        for (const auto& row : scriptData.script[0]) {
+            for (int v : row) {
+                if (v >= 0 && v < SS02BatchEvaluator::NUM_SYMBOLS) {
+                    weights[v] += 1.0;
+                } else if (v != -1) {
+                    weights.back() += 1.0;
+                }
+            }
+        }
+    }
+    return weights;
+}
@@ -0,0 +1,153 @@
+// SS02Analytic.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include "ScriptConfig.h"
+#include "json.hpp"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Outcome of one script, evaluated once and shared by every analytic or simulated RTP
+// calculation. For free and buy_free scripts with MULTIPLIER symbols, payout = basePayout *
+// multiplierCount * special_multipliers; the game instead draws one value per MULTIPLIER
+// from multiplier table `table` and pays basePayout * sum(draw - 100). Table ids are 1 and 2:
+// free scripts number their tables 0/1 (table = multiple_table + 1), while buy_free scripts
+// already carry the id 1/2 (table = multiple_table).
+struct ScriptOutcome {
+    int payout = 0;
+    double basePayout = 0.0;
+    int multiplierCount = 0;
+    int table = 1;
+};
+
+// Read-only outcomes of one section, held by a ScriptOutcomeCache or a mapped OutcomeFile
+struct ScriptOutcomeSpan {
+    const ScriptOutcome* data = nullptr;
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const ScriptOutcome& operator[](size_t i) const { return data[i]; }
+    const ScriptOutcome* begin() const { return data; }
+    const ScriptOutcome* end() const { return data + count; }
+};
+
+struct ScriptOutcomeView {
+    ScriptOutcomeSpan base, free, buy;
+
+    // Hash of every outcome, for checkpoints that must not be resumed against other scripts
+    uint64_t fingerprint() const;
+};
+
+struct ScriptOutcomeCache {
+    std::vector<ScriptOutcome> base;
+    std::vector<ScriptOutcome> free;
+    std::vector<ScriptOutcome> buy;      // Free spins of a bought feature; empty = bought sessions use the free scripts
+
+    // Evaluates every script once with the batch engine
+    static ScriptOutcomeCache build(const ScriptApp::ScriptConfig& config);
+
+    ScriptOutcomeView view() const {
+        return {{base.data(), base.size()}, {free.data(), free.size()}, {buy.data(), buy.size()}};
+    }
+    uint64_t fingerprint() const { return view().fingerprint(); }
+};
+
+// ScriptConfig::loadFromFile with reel-format entries (backend files such as
+// FG_hist/Insert_Script.json) replayed into boards by SlotSS02
+ScriptApp::ScriptConfig loadSS02Scripts(const std::string& filename);
+
+struct RtpParameters {
+    double bet = 20.0;
+    double fgTrigger = 0.005;           // Per base spin
+    double fgRetrigger = 0.03;          // Per free spin, awards another fgRounds spins
+    int fgRounds = 10;
+    std::string volatility = "low";     // Multiplier table set
+    bool drawMultipliers = true;        // false: pay free scripts at their script payout
+    nlohmann::json multiplierTable;     // Replaces the volatility's table set when not null
+    double buyCost = 100.0;             // Buy feature price, in bets
+
+    // Defaults of an SS02 game instance
+    static RtpParameters fromGame(const SlotSS02& game);
+
+    // Throws std::runtime_error unless `volatility` names a table set ("low" or "high")
+    static void checkVolatility(const std::string& volatility);
+
+    // multiplierTable when set, otherwise the volatility's table set (checked as above)
+    nlohmann::json multiplierTables() const;
+};
+
+// Payout distribution on a uniform grid; bin i holds the mass at payout i * binWidth
+struct PayoutDistribution {
+    double binWidth = 1.0;
+    std::vector<double> pmf;
+
+    double quantile(double q) const;
+    double exceedance(double payout) const;   // P(payout >= x)
+};
+
+struct RtpReport {
+    double baseMean = 0.0, baseVariance = 0.0;
+    double freeSpinMean = 0.0, freeSpinVariance = 0.0;
+    double freeScriptMean = 0.0;             // Free spins paid at their script payouts
+    double sessionLengthMean = 0.0, sessionLengthVariance = 0.0;
+    double sessionMean = 0.0, sessionVariance = 0.0;
+    double spinMean = 0.0, spinVariance = 0.0;   // Per base spin, free games included
+    double baseRtp = 0.0, freeRtp = 0.0, rtp = 0.0;
+    double buySpinMean = 0.0, buySpinVariance = 0.0;   // Buy feature: one free game session of buy_free spins
+    double buyMean = 0.0, buyVariance = 0.0;
+    double buyRtp = 0.0;                     // buyMean / (buyCost * bet)
+    PayoutDistribution session;              // Total win of one free game session
+    PayoutDistribution spin;                 // Total win of one base spin
+    PayoutDistribution buy;                  // Total win of one bought feature
+};
+
+// Exact RTP, variance and payout distribution over the free game session structure.
+//
+// A session starts with fgRounds free spins and every free spin independently awards
+// another fgRounds spins with probability fgRetrigger, so the number of spin blocks is a
+// Galton-Watson total progeny. Moments follow in closed form. Distributions use the
+// characteristic function of one block and its descendants, B = (phi * (1 - r + r * B))^R,
+// solved per frequency on an FFT grid; no simulation is involved.
+class SS02AnalyticRtp {
+public:
+    explicit SS02AnalyticRtp(const ScriptOutcomeCache& cache) : cache_(cache) {}
+
+    // gridSize = 0 computes the moments only (used by sweeps); otherwise the
+    // distributions are computed on a power-of-two grid of at most gridSize bins.
+    RtpReport solve(const RtpParameters& params, size_t gridSize = 1 << 16) const;
+
+private:
+    const ScriptOutcomeCache& cache_;
+};
+
+// Exact distribution of the first cascade step of a board whose 30 cells are drawn
+// independently from per-symbol weights. SS02 matching is count-based, so the step's payout
+// (SlotBase::get_score of the board's clusters) depends only on the board's count vector;
+// the count vectors are multinomial, and a DP over symbols with state (cells used, payout so
+// far, any cluster yet) sums their probabilities without enumerating boards.
+struct FirstCascadeReport {
+    PayoutDistribution payout;                  // binWidth 1, first-step score before multipliers
+    double terminalProbability = 0.0;           // No symbol reaches the minimum match size
+    double mean = 0.0, variance = 0.0;
+    std::vector<double> clusterProbability;     // Per symbol: P(count >= minimum match size)
+};
+
+class FirstCascadeDistribution {
+public:
+    // Pays (with the get_score fallback) and minimum match size of `game`
+    explicit FirstCascadeDistribution(const SlotSS02& game);
+
+    // weights: symbols 0..8, optionally followed by one weight for MULTIPLIER / any
+    // non-paying symbol. Destination cell counts of each DP pass are split across threads.
+    FirstCascadeReport solve(const std::vector<double>& weights, unsigned threads = 1) const;
+
+    // Symbol frequencies of the first boards of a script section, in solve()'s weight layout
+    static std::vector<double> weightsFromScripts(const std::map<int, ScriptApp::ScriptData>& scripts);
+
+private:
+    std::vector<std::vector<int>> pay_;   // [symbol][count], 0 below the minimum match size
+    int minMatch_;
+    int cells_;
+};
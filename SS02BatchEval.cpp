@@ -0,0 +1,335 @@
+#include "SS02BatchEval.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Define SS02_BATCH_SCALAR to force the portable fallback (useful for cross-checking)
+#if !defined(SS02_BATCH_SCALAR) && defined(__AVX2__)
+#define SS02_BATCH_AVX2 1
+#include <immintrin.h>
+#elif !defined(SS02_BATCH_SCALAR) && defined(__SSE2__)
+#define SS02_BATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// ============================================================================
+// 32 x uint8 lane vector. One byte per script; masks are 0xFF (true) / 0x00 (false).
+// ============================================================================
+
+#if defined(SS02_BATCH_AVX2)
+
+struct Lanes {
+    __m256i v;
+};
+
+inline Lanes splat(uint8_t x) { return {_mm256_set1_epi8(static_cast<char>(x))}; }
+inline Lanes load(const uint8_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+inline void store(uint8_t* p, Lanes a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a.v); }
+inline Lanes eq(Lanes a, Lanes b) { return {_mm256_cmpeq_epi8(a.v, b.v)}; }
+inline Lanes operator&(Lanes a, Lanes b) { return {_mm256_and_si256(a.v, b.v)}; }
+inline Lanes operator|(Lanes a, Lanes b) { return {_mm256_or_si256(a.v, b.v)}; }
+inline Lanes andnot(Lanes a, Lanes b) { return {_mm256_andnot_si256(a.v, b.v)}; }  // ~a & b
+inline Lanes sub(Lanes a, Lanes b) { return {_mm256_sub_epi8(a.v, b.v)}; }
+inline Lanes ge_u(Lanes a, Lanes b) { return {_mm256_cmpeq_epi8(_mm256_max_epu8(a.v, b.v), a.v)}; }
+inline Lanes blend(Lanes mask, Lanes a, Lanes b) { return {_mm256_blendv_epi8(b.v, a.v, mask.v)}; }
+inline uint32_t movemask(Lanes a) { return static_cast<uint32_t>(_mm256_movemask_epi8(a.v)); }
+
+#elif defined(SS02_BATCH_SSE2)
+
+struct Lanes {
+    __m128i lo, hi;
+};
+
+inline Lanes splat(uint8_t x) {
+    __m128i v = _mm_set1_epi8(static_cast<char>(x));
+    return {v, v};
+}
+inline Lanes load(const uint8_t* p) {
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16))};
+}
+inline void store(uint8_t* p, Lanes a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 16), a.hi);
+}
+inline Lanes eq(Lanes a, Lanes b) { return {_mm_cmpeq_epi8(a.lo, b.lo), _mm_cmpeq_epi8(a.hi, b.hi)}; }
+inline Lanes operator&(Lanes a, Lanes b) { return {_mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi)}; }
+inline Lanes operator|(Lanes a, Lanes b) { return {_mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi)}; }
+inline Lanes andnot(Lanes a, Lanes b) { return {_mm_andnot_si128(a.lo, b.lo), _mm_andnot_si128(a.hi, b.hi)}; }
+inline Lanes sub(Lanes a, Lanes b) { return {_mm_sub_epi8(a.lo, b.lo), _mm_sub_epi8(a.hi, b.hi)}; }
+inline Lanes ge_u(Lanes a, Lanes b) {
+    return {_mm_cmpeq_epi8(_mm_max_epu8(a.lo, b.lo), a.lo), _mm_cmpeq_epi8(_mm_max_epu8(a.hi, b.hi), a.hi)};
+}
+inline Lanes blend(Lanes mask, Lanes a, Lanes b) { return (mask & a) | andnot(mask, b); }
+inline uint32_t movemask(Lanes a) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(a.lo)) |
+           (static_cast<uint32_t>(_mm_movemask_epi8(a.hi)) << 16);
+}
+
+#else
+
+// Scalar fallback - plain byte loops the compiler is free to vectorize
+struct Lanes {
+    uint8_t v[32];
+};
+
+template <typename F>
+inline Lanes map2(Lanes a, Lanes b, F f) {
+    Lanes r;
+    for (int i = 0; i < 32; ++i) r.v[i] = f(a.v[i], b.v[i]);
+    return r;
+}
+inline Lanes splat(uint8_t x) {
+    Lanes r;
+    std::memset(r.v, x, sizeof(r.v));
+    return r;
+}
+inline Lanes load(const uint8_t* p) {
+    Lanes r;
+    std::memcpy(r.v, p, sizeof(r.v));
+    return r;
+}
+inline void store(uint8_t* p, Lanes a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline Lanes eq(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return x == y ? 0xFF : 0; }); }
+inline Lanes operator&(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return x & y; }); }
+inline Lanes operator|(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return x | y; }); }
+inline Lanes andnot(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return ~x & y; }); }
+inline Lanes sub(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return x - y; }); }
+inline Lanes ge_u(Lanes a, Lanes b) { return map2(a, b, [](uint8_t x, uint8_t y) -> uint8_t { return x >= y ? 0xFF : 0; }); }
+inline Lanes blend(Lanes mask, Lanes a, Lanes b) { return (mask & a) | andnot(mask, b); }
+inline uint32_t movemask(Lanes a) {
+    uint32_t m = 0;
+    for (int i = 0; i < 32; ++i) m |= static_cast<uint32_t>(a.v[i] >> 7) << i;
+    return m;
+}
+
+#endif
+
+// Expand a 32-bit lane bitmask into a byte mask
+inline Lanes lane_mask(uint32_t bits) {
+    alignas(32) uint8_t bytes[32];
+    for (int i = 0; i < 32; ++i) bytes[i] = (bits >> i) & 1u ? 0xFF : 0x00;
+    return load(bytes);
+}
+
+}  // namespace
+
+SS02BatchEvaluator::SS02BatchEvaluator(const SlotSS02& game)
+    : min_match_size_(game.get_min_match_size()),
+      is_free_(game.get_config().game_type == "free") {
+    const auto& pay_table = game.get_config().pay_table;
+    for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+        for (int count = 0; count <= CELLS; ++count) {
+            int value = 0;
+            if (count >= min_match_size_) {
+                // Same lookup / fallback as SlotBase::get_score
+                auto it = pay_table.find(symbol);
+                if (it != pay_table.end() && it->second.count(count)) {
+                    value = static_cast<int>(it->second.at(count));
+                } else {
+                    value = symbol * count;
+                }
+            }
+            pay_[symbol][count] = value;
+        }
+    }
+}
+
+const char* SS02BatchEvaluator::isa_name() {
+#if defined(SS02_BATCH_AVX2)
+    return "AVX2";
+#elif defined(SS02_BATCH_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+void SS02BatchEvaluator::packBoard(const Board& board, uint8_t* out) {
+    if (static_cast<int>(board.size()) != HEIGHT) {
+        throw std::runtime_error("SS02 board must have " + std::to_string(HEIGHT) + " rows");
+    }
+    for (int row = 0; row < HEIGHT; ++row) {
+        if (static_cast<int>(board[row].size()) != WIDTH) {
+            throw std::runtime_error("SS02 board must have " + std::to_string(WIDTH) + " columns");
+        }
+        for (int col = 0; col < WIDTH; ++col) {
+            int value = board[row][col];
+            out[row * WIDTH + col] = value < 0 ? EMPTY : static_cast<uint8_t>(value);
+        }
+    }
+}
+
+void SS02BatchEvaluator::evaluate(const PackedScript* scripts, size_t count, BatchScriptResult* results,
+                                  uint32_t* step_masks, int mask_stride) const {
+    for (size_t begin = 0; begin < count; begin += LANES) {
+        int lanes = static_cast<int>(std::min<size_t>(LANES, count - begin));
+        evaluateBlock(scripts + begin, lanes, results + begin,
+                      step_masks ? step_masks + begin * mask_stride : nullptr, mask_stride);
+    }
+}
+
+std::vector<BatchScriptResult> SS02BatchEvaluator::evaluate(const std::vector<const std::vector<Board>*>& scripts,
+                                                            const std::vector<int>& special_multipliers) const {
+    // Pack every script into one contiguous buffer
+    size_t total_boards = 0;
+    for (const auto* script : scripts) total_boards += script->size();
+    std::vector<uint8_t> buffer(total_boards * CELLS);
+    std::vector<PackedScript> packed(scripts.size());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        packed[i].boards = buffer.data() + offset;
+        packed[i].board_count = static_cast<int>(scripts[i]->size());
+        packed[i].special_multipliers = i < special_multipliers.size() ? special_multipliers[i] : 1;
+        for (const auto& board : *scripts[i]) {
+            packBoard(board, buffer.data() + offset);
+            offset += CELLS;
+        }
+    }
+
+    std::vector<BatchScriptResult> results(scripts.size());
+    evaluate(packed.data(), packed.size(), results.data());
+    return results;
+}
+
+void SS02BatchEvaluator::evaluateBlock(const PackedScript* scripts, int lanes, BatchScriptResult* results,
+                                       uint32_t* step_masks, int mask_stride) const {
+    alignas(32) uint8_t scratch[LANES];
+    Lanes cur[CELLS];
+
+    // Transpose board `step` of the selected lanes into cell-major vectors
+    auto gather = [&](int step, uint32_t lane_bits, Lanes* dst) {
+        for (int cell = 0; cell < CELLS; ++cell) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                bool use = lane < lanes && ((lane_bits >> lane) & 1u);
+                scratch[lane] = use ? scripts[lane].boards[step * CELLS + cell] : EMPTY;
+            }
+            dst[cell] = load(scratch);
+        }
+    };
+
+    uint32_t alive = 0;
+    for (int lane = 0; lane < lanes; ++lane) {
+        results[lane] = BatchScriptResult{};
+        if (step_masks) {
+            std::fill(step_masks + lane * mask_stride, step_masks + (lane + 1) * mask_stride, 0u);
+        }
+        if (scripts[lane].board_count > 0) {
+            alive |= 1u << lane;
+        }
+    }
+    gather(0, alive, cur);
+
+    int score[LANES] = {0};
+    uint32_t cascade_broken = 0;
+    const Lanes empty = splat(EMPTY);
+    const Lanes one_lane_true = splat(0xFF);
+    const Lanes min_match = splat(static_cast<uint8_t>(min_match_size_));
+
+    for (int step = 0; alive != 0; ++step) {
+        // 1. Count every symbol in every lane
+        Lanes counts[NUM_SYMBOLS];
+        Lanes matched[NUM_SYMBOLS];
+        Lanes any_match = splat(0);
+        for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+            const Lanes sym = splat(static_cast<uint8_t>(symbol));
+            Lanes count = splat(0);
+            for (int cell = 0; cell < CELLS; ++cell) {
+                count = sub(count, eq(cur[cell], sym));  // 0xFF == -1, so this adds one per match
+            }
+            counts[symbol] = count;
+            matched[symbol] = ge_u(count, min_match);
+            any_match = any_match | matched[symbol];
+        }
+
+        // A lane keeps cascading while it has a match and a next board to compare against
+        uint32_t has_next = 0;
+        for (int lane = 0; lane < lanes; ++lane) {
+            if (step < scripts[lane].board_count - 1) has_next |= 1u << lane;
+        }
+        uint32_t active = alive & movemask(any_match) & has_next;
+        for (uint32_t bits = alive & ~active; bits; bits &= bits - 1) {
+            results[__builtin_ctz(bits)].stop = step + 1;
+        }
+        alive = active;
+        if (!alive) break;
+
+        // 2. Score matched symbols (pay table gather is scalar)
+        for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+            uint32_t hit = movemask(matched[symbol]) & active;
+            if (!hit) continue;
+            store(scratch, counts[symbol]);
+            for (uint32_t bits = hit; bits; bits &= bits - 1) {
+                int lane = __builtin_ctz(bits);
+                score[lane] += pay_[symbol][scratch[lane]];
+            }
+        }
+
+        const Lanes active_mask = lane_mask(active);
+
+        // 3. Eliminate matched cells
+        for (int cell = 0; cell < CELLS; ++cell) {
+            Lanes eliminated = splat(0);
+            for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+                eliminated = eliminated | (eq(cur[cell], splat(static_cast<uint8_t>(symbol))) & matched[symbol]);
+            }
+            eliminated = eliminated & active_mask;
+            if (step_masks && step < mask_stride) {
+                for (uint32_t bits = movemask(eliminated); bits; bits &= bits - 1) {
+                    int lane = __builtin_ctz(bits);
+                    step_masks[lane * mask_stride + step] |= 1u << cell;
+                }
+            }
+            cur[cell] = blend(eliminated, empty, cur[cell]);
+        }
+
+        // 4. Gravity: stable bubble of empties to the top of each column
+        for (int col = 0; col < WIDTH; ++col) {
+            for (int pass = 0; pass < HEIGHT - 1; ++pass) {
+                for (int row = HEIGHT - 1; row > 0; --row) {
+                    Lanes& below = cur[row * WIDTH + col];
+                    Lanes& above = cur[(row - 1) * WIDTH + col];
+                    Lanes fall = andnot(eq(above, empty), eq(below, empty));
+                    below = blend(fall, above, below);
+                    above = blend(fall, empty, above);
+                }
+            }
+        }
+
+        // 5. Cascade check against the next board, then advance active lanes
+        Lanes next[CELLS];
+        gather(step + 1, active, next);
+        Lanes broken = splat(0);
+        for (int cell = 0; cell < CELLS; ++cell) {
+            Lanes survivor = andnot(eq(cur[cell], empty), one_lane_true);
+            broken = broken | andnot(eq(cur[cell], next[cell]), survivor);
+            cur[cell] = blend(active_mask, next[cell], cur[cell]);
+        }
+        cascade_broken |= movemask(broken) & active;
+    }
+
+    // Final boards are left in place for terminated lanes; count MULTIPLIER symbols
+    const Lanes multiplier = splat(static_cast<uint8_t>(SlotSS02::get_multiplier_symbol()));
+    Lanes mult_count = splat(0);
+    for (int cell = 0; cell < CELLS; ++cell) {
+        mult_count = sub(mult_count, eq(cur[cell], multiplier));
+    }
+    store(scratch, mult_count);
+
+    for (int lane = 0; lane < lanes; ++lane) {
+        BatchScriptResult& r = results[lane];
+        if (scripts[lane].board_count == 0) {
+            r.stop = 0;
+            continue;
+        }
+        r.cascade_match = !((cascade_broken >> lane) & 1u);
+        r.multiplier_count = scratch[lane];
+        r.score = score[lane];
+        if (is_free_ && r.multiplier_count > 0) {
+            r.score *= r.multiplier_count * scripts[lane].special_multipliers;
+        }
+    }
+}
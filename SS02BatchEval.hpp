@@ -0,0 +1,66 @@
+// SS02BatchEval.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Outcome of one script evaluated by the batch engine.
+// Mirrors the score / stop / cascade flag returned by SlotSS02::steps.
+struct BatchScriptResult {
+    int score = 0;              // Total score (multiplied for free games)
+    int stop = 0;               // Number of boards consumed (same as steps() actual_stop)
+    bool cascade_match = true;  // False if any post-gravity survivor disagrees with the next board
+    int multiplier_count = 0;   // MULTIPLIER symbols on the final board
+};
+
+// A script packed as consecutive row-major boards of 30 bytes each.
+// Cells hold the symbol value, 202 for MULTIPLIER and 0xFF for an empty (-1) cell.
+struct PackedScript {
+    const uint8_t* boards = nullptr;
+    int board_count = 0;
+    int special_multipliers = 1;
+};
+
+// Lockstep SS02 evaluator: transposes up to LANES scripts into structure-of-arrays form
+// (one vector per cell, one byte per script) and runs matching, scoring, elimination,
+// gravity and the cascade check for all of them at once. Lanes whose script has
+// terminated are masked out until the whole block is finished.
+//
+// Built with -mavx2 it uses AVX2, otherwise SSE2 on x86-64, otherwise a scalar fallback.
+class SS02BatchEvaluator {
+public:
+    static constexpr int LANES = 32;
+    static constexpr int HEIGHT = 5;
+    static constexpr int WIDTH = 6;
+    static constexpr int CELLS = HEIGHT * WIDTH;
+    static constexpr int NUM_SYMBOLS = 9;
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    // Copies pay table and game type (base/free) from an existing SS02 instance
+    explicit SS02BatchEvaluator(const SlotSS02& game);
+
+    // Evaluate packed scripts. If step_masks is given, step_masks[i * mask_stride + step]
+    // receives the bitmask (bit = row * 6 + col) of cells eliminated at that cascade step
+    // for script i; steps beyond mask_stride are not recorded.
+    void evaluate(const PackedScript* scripts, size_t count, BatchScriptResult* results,
+                  uint32_t* step_masks = nullptr, int mask_stride = 0) const;
+
+    // Convenience overload for scripts held as Board vectors
+    std::vector<BatchScriptResult> evaluate(const std::vector<const std::vector<Board>*>& scripts,
+                                            const std::vector<int>& special_multipliers) const;
+
+    // Pack a board into 30 bytes (-1 becomes EMPTY)
+    static void packBoard(const Board& board, uint8_t* out);
+
+    // Name of the instruction set selected at compile time
+    static const char* isa_name();
+
+private:
+    void evaluateBlock(const PackedScript* scripts, int lanes, BatchScriptResult* results,
+                       uint32_t* step_masks, int mask_stride) const;
+
+    std::array<std::array<int, CELLS + 1>, NUM_SYMBOLS> pay_;  // pay_[symbol][count], 0 below min match
+    int min_match_size_;
+    bool is_free_;
+};
@@ -0,0 +1,465 @@
+#include "SS02Generator.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+constexpr int NUM_SYMBOLS = 9;
+constexpr int kDrawsPerBoard = 4;
+
+}  // namespace
+
+CompositionSpec CompositionSpec::fromJson(const nlohmann::json& j) {
+    CompositionSpec spec;
+    if (j.contains("steps")) {
+        for (const auto& step : j.at("steps")) {
+            std::vector<ClusterSpec> clusters;
+            for (const auto& cluster : step) {
+                clusters.push_back({cluster.at("symbol").get<int>(), cluster.at("count").get<int>()});
+            }
+            spec.steps.push_back(clusters);
+        }
+    }
+    if (j.contains("special_multipliers")) spec.special_multipliers = j.at("special_multipliers").get<int>();
+    if (j.contains("multiplier_count")) spec.multiplier_count = j.at("multiplier_count").get<int>();
+    if (j.contains("payout_id")) spec.payout_id = j.at("payout_id").get<int>();
+    if (j.contains("repeat")) spec.repeat = j.at("repeat").get<int>();
+    return spec;
+}
+
+nlohmann::json GeneratedScript::toJson(int index) const {
+    nlohmann::json j;
+    j["index"] = index;
+    j["stop"] = stop;
+    j["script"] = script;
+    j["special_multipliers"] = special_multipliers;
+    j["multiplier_count"] = multiplier_count;
+    j["payout_type"] = is_free ? "FG" : "BG";
+    j["payout"] = payout;
+    j["payout_id"] = payout_id;
+    return j;
+}
+
+bool BoardHashIndex::insert(const Board& board) {
+    Key key;
+    key.fill(0xFE);
+    size_t cell = 0;
+    for (const auto& row : board) {
+        for (int v : row) {
+            if (cell == key.size()) throw std::runtime_error("Board hash index holds boards of up to 32 cells");
+            key[cell++] = static_cast<uint8_t>(v);   // -1 becomes 0xFF, MULTIPLIER 202
+        }
+    }
+    return boards_.insert(key).second;
+}
+
+size_t BoardHashIndex::KeyHash::operator()(const Key& key) const {
+    // FNV-1a
+    uint64_t h = 1469598103934665603ULL;
+    for (uint8_t b : key) h = (h ^ b) * 1099511628211ULL;
+    return static_cast<size_t>(h);
+}
+
+TerminalBoardSampler::TerminalBoardSampler(const SlotSS02& game, const std::vector<double>& weights)
+    : height_(game.get_board_height()), width_(game.get_board_width()), maxCount_(game.get_min_match_size() - 1) {
+    const size_t symbols = game.get_symbols().size();
+    if (!weights.empty() && weights.size() != symbols) {
+        throw std::runtime_error("Expected " + std::to_string(symbols) + " terminal board symbol weights");
+    }
+    const int cells = height_ * width_;
+    term_.assign(symbols, std::vector<double>(maxCount_ + 1));
+    for (size_t s = 0; s < symbols; ++s) {
+        const double w = weights.empty() ? 1.0 : weights[s];
+        if (w < 0.0) throw std::runtime_error("Symbol weights must not be negative");
+        double value = 1.0;
+        for (int c = 0; c <= maxCount_; ++c) {
+            term_[s][c] = value;
+            value *= w / (c + 1);
+        }
+    }
+    // completions_[s][n] = sum over counts c_s.. (each <= maxCount_, summing to n) of prod term
+    completions_.assign(symbols + 1, std::vector<double>(cells + 1, 0.0));
+    completions_[symbols][0] = 1.0;
+    for (size_t s = symbols; s-- > 0;) {
+        for (int n = 0; n <= cells; ++n) {
+            for (int c = 0; c <= std::min(n, maxCount_); ++c) completions_[s][n] += term_[s][c] * completions_[s + 1][n - c];
+        }
+    }
+}
+
+Board TerminalBoardSampler::sample(std::mt19937_64& rng, int multiplier_count) const {
+    const int cells = height_ * width_;
+    int remaining = cells - multiplier_count;
+    if (multiplier_count < 0 || remaining < 0 || completions_[0][remaining] <= 0.0) {
+        throw std::runtime_error("No terminal board holds " + std::to_string(multiplier_count) + " multipliers");
+    }
+    std::vector<int> fill;
+    fill.reserve(cells);
+    fill.insert(fill.end(), multiplier_count, SlotSS02::get_multiplier_symbol());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const size_t symbols = term_.size();
+    for (size_t s = 0; s < symbols; ++s) {
+        // P(c_s = c) = term(c) * completions(s + 1, n - c) / completions(s, n)
+        double u = unit(rng) * completions_[s][remaining];
+        int c = std::min(remaining, maxCount_);
+        for (int k = 0; k < c; ++k) {
+            u -= term_[s][k] * completions_[s + 1][remaining - k];
+            if (u < 0.0) {
+                c = k;
+                break;
+            }
+        }
+        // Rounding can leave the last candidate infeasible; step down to one that is
+        while (c > 0 && term_[s][c] * completions_[s + 1][remaining - c] <= 0.0) c--;
+        fill.insert(fill.end(), c, static_cast<int>(s));
+        remaining -= c;
+    }
+    std::shuffle(fill.begin(), fill.end(), rng);
+
+    Board board(height_, std::vector<int>(width_));
+    for (int i = 0; i < cells; ++i) board[i / width_][i % width_] = fill[i];
+    return board;
+}
+
+Board TerminalBoardSampler::sampleUnique(std::mt19937_64& rng, BoardHashIndex& index, int multiplier_count,
+                                         int max_tries) const {
+    for (int attempt = 0; attempt < max_tries; ++attempt) {
+        Board board = sample(rng, multiplier_count);
+        if (index.insert(board)) return board;
+    }
+    throw std::runtime_error("No unseen terminal board with " + std::to_string(multiplier_count) +
+                             " multipliers after " + std::to_string(max_tries) + " tries");
+}
+
+SS02ScriptGenerator::SS02ScriptGenerator(const std::string& game_type, uint64_t seed)
+    : game_(true, 20.0f, game_type), terminal_(game_), refill_(game_), rng_(seed) {}
+
+int SS02ScriptGenerator::expectedPayout(const CompositionSpec& spec) const {
+    const auto& pay_table = game_.get_config().pay_table;
+    int total = 0;
+    for (const auto& step : spec.steps) {
+        for (const auto& cluster : step) {
+            auto it = pay_table.find(cluster.symbol);
+            if (it != pay_table.end() && it->second.count(cluster.count)) {
+                total += static_cast<int>(it->second.at(cluster.count));
+            } else {
+                total += cluster.symbol * cluster.count;
+            }
+        }
+    }
+    if (game_.get_config().game_type == "free" && spec.multiplier_count > 0) {
+        total *= spec.multiplier_count * spec.special_multipliers;
+    }
+    return total;
+}
+
+void SS02ScriptGenerator::validate(const CompositionSpec& spec) const {
+    const int cells = game_.get_board_height() * game_.get_board_width();
+    const int minMatch = game_.get_min_match_size();
+    const bool isFree = game_.get_config().game_type == "free";
+
+    if (spec.multiplier_count < 0 || (!isFree && spec.multiplier_count > 0)) {
+        throw std::runtime_error("MULTIPLIER symbols are only allowed in free game compositions");
+    }
+    for (size_t i = 0; i < spec.steps.size(); ++i) {
+        std::set<int> seen;
+        int used = (i == 0) ? spec.multiplier_count : 0;
+        if (spec.steps[i].empty()) {
+            throw std::runtime_error("Cascade step " + std::to_string(i) + " has no winning cluster");
+        }
+        for (const auto& cluster : spec.steps[i]) {
+            if (cluster.symbol < 0 || cluster.symbol >= NUM_SYMBOLS) {
+                throw std::runtime_error("Invalid cluster symbol " + std::to_string(cluster.symbol));
+            }
+            if (cluster.count < minMatch || cluster.count > cells) {
+                throw std::runtime_error("Cluster count " + std::to_string(cluster.count) +
+                                         " is outside [" + std::to_string(minMatch) + ", " + std::to_string(cells) + "]");
+            }
+            if (!seen.insert(cluster.symbol).second) {
+                throw std::runtime_error("Symbol " + std::to_string(cluster.symbol) +
+                                         " appears twice in cascade step " + std::to_string(i));
+            }
+            used += cluster.count;
+        }
+        // Remaining cells must be coverable by non-winning symbols (at most minMatch-1 each)
+        int freeSymbols = NUM_SYMBOLS - static_cast<int>(seen.size());
+        if (used > cells || cells - used > freeSymbols * (minMatch - 1)) {
+            throw std::runtime_error("Cascade step " + std::to_string(i) + " cannot fill a " +
+                                     std::to_string(cells) + "-cell board");
+        }
+    }
+    if (spec.steps.empty() && cells - spec.multiplier_count > NUM_SYMBOLS * (minMatch - 1)) {
+        throw std::runtime_error("Zero-payout board cannot hold " + std::to_string(spec.multiplier_count) + " multipliers");
+    }
+    if (!spec.steps.empty() && !refill_.feasible(spec)) {
+        throw std::runtime_error("Cascade steps cannot follow each other: a cluster needs more cells than the previous step can carry over or refill");
+    }
+}
+
+struct RefillSolver::Plan {
+    size_t boards = 0;                  // steps + 1
+    int symbolCells = 0;                // Cells not taken by MULTIPLIER
+    std::vector<SymbolCounts> target;   // Cluster size per symbol, -1 if it must not win
+    std::vector<SymbolCounts> lower;    // Bounds of the non-winning symbols (winning: the cluster)
+    std::vector<SymbolCounts> upper;
+    std::vector<int> nextClusterCells;  // Cells of board i + 1's clusters
+};
+
+RefillSolver::RefillSolver(const SlotSS02& game)
+    : cells_(game.get_board_height() * game.get_board_width()), maxCount_(game.get_min_match_size() - 1) {}
+
+bool RefillSolver::buildPlan(const CompositionSpec& spec, Plan& plan) const {
+    plan.boards = spec.steps.size() + 1;
+    plan.symbolCells = cells_ - spec.multiplier_count;
+    plan.target.resize(plan.boards);
+    plan.lower.assign(plan.boards, SymbolCounts{});
+    plan.upper.resize(plan.boards);
+    plan.nextClusterCells.assign(plan.boards, 0);
+    std::vector<int> freed(plan.boards, 0);   // Cells eliminated on board i
+    for (size_t i = 0; i < plan.boards; ++i) {
+        plan.target[i].fill(-1);
+        if (i < spec.steps.size()) {
+            for (const auto& cluster : spec.steps[i]) {
+                if (cluster.symbol < 0 || cluster.symbol >= NUM_SYMBOLS) return false;
+                plan.target[i][cluster.symbol] = cluster.count;
+                freed[i] += cluster.count;
+            }
+        }
+        if (freed[i] > plan.symbolCells) return false;
+    }
+
+    // Backward propagation. A non-winning symbol's count can only grow until it wins, and
+    // by at most the cells the current step frees per board.
+    for (size_t i = plan.boards; i-- > 0;) {
+        int lowerSum = 0;
+        for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+            const int target = plan.target[i][symbol];
+            int upper = maxCount_, lower = 0;
+            if (i + 1 < plan.boards) {
+                const int next = plan.target[i + 1][symbol];
+                upper = std::min(upper, next >= 0 ? next : plan.upper[i + 1][symbol]);
+                lower = std::max(0, (next >= 0 ? next : plan.lower[i + 1][symbol]) - freed[i]);
+                if (next >= 0) plan.nextClusterCells[i] += next;
+            }
+            if (target >= 0) {
+                // A cluster right after another cluster of the same symbol is refilled from scratch
+                if (i > 0 && plan.target[i - 1][symbol] >= 0 && target > freed[i - 1]) return false;
+                if (lower > 0) return false;   // Eliminated here, yet needed on the next board
+                upper = lower = target;
+            } else if (lower > upper) {
+                return false;
+            }
+            plan.upper[i][symbol] = upper;
+            plan.lower[i][symbol] = lower;
+            lowerSum += lower;
+        }
+        if (lowerSum > plan.symbolCells) return false;
+    }
+
+    // Every board must be able to use all its cells while the symbols that carry over to the
+    // next board leave room for the next board's clusters
+    for (size_t i = 0; i < plan.boards; ++i) {
+        int upperFree = 0, upperGrouped = 0;
+        for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+            const bool grouped = plan.target[i][symbol] < 0 && i + 1 < plan.boards && plan.target[i + 1][symbol] < 0;
+            (grouped ? upperGrouped : upperFree) += plan.upper[i][symbol];
+        }
+        const int cap = plan.symbolCells - plan.nextClusterCells[i];
+        if (upperFree + std::min(upperGrouped, cap) < plan.symbolCells) return false;
+    }
+    return true;
+}
+
+bool RefillSolver::feasible(const CompositionSpec& spec) const {
+    Plan plan;
+    return buildPlan(spec, plan);
+}
+
+bool RefillSolver::solve(const CompositionSpec& spec, std::mt19937_64& rng, std::vector<SymbolCounts>& counts,
+                         int node_budget) const {
+    Plan plan;
+    if (!buildPlan(spec, plan)) return false;
+    counts.assign(plan.boards, SymbolCounts{});
+    int nodes = node_budget;
+    return assignBoard(plan, 0, SymbolCounts{}, rng, counts, nodes);
+}
+
+bool RefillSolver::assignBoard(const Plan& plan, size_t board, const SymbolCounts& carried, std::mt19937_64& rng,
+                               std::vector<SymbolCounts>& counts, int& nodes) const {
+    if (board == plan.boards) return true;
+
+    // Domains as bitmasks of allowed counts; `grouped` symbols neither win here nor on the
+    // next board, so they all carry over and must leave room for the next board's clusters
+    std::array<uint32_t, NUM_SYMBOLS> domain{};
+    std::array<bool, NUM_SYMBOLS> grouped{};
+    const bool hasNext = board + 1 < plan.boards;
+    const int cap = hasNext ? plan.symbolCells - plan.nextClusterCells[board] : plan.symbolCells;
+    for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+        const int target = plan.target[board][symbol];
+        const int lo = std::max(carried[symbol], plan.lower[board][symbol]);
+        const int hi = plan.upper[board][symbol];
+        if (lo > hi) return false;
+        domain[symbol] = ((hi >= 31 ? 0xFFFFFFFFu : (1u << (hi + 1)) - 1)) & ~((1u << lo) - 1);
+        grouped[symbol] = target < 0 && hasNext && plan.target[board + 1][symbol] < 0;
+    }
+    auto low = [&](int symbol) { return __builtin_ctz(domain[symbol]); };
+    auto high = [&](int symbol) { return 31 - __builtin_clz(domain[symbol]); };
+
+    std::array<int, NUM_SYMBOLS> order;
+    std::iota(order.begin(), order.end(), 0);
+    // A few draws per board before giving up on the previous board's choice: a dead end
+    // usually comes from what was carried in, not from this board's draw. The first board
+    // is re-drawn until the budget runs out.
+    const int draws = board == 0 ? std::numeric_limits<int>::max() : kDrawsPerBoard;
+    for (int draw = 0; draw < draws && nodes > 0; ++draw) {
+        nodes--;
+        std::shuffle(order.begin(), order.end(), rng);
+        SymbolCounts& chosen = counts[board];
+        int remaining = plan.symbolCells;
+        int capLeft = cap;
+        bool drawn = true;
+        for (int k = 0; k < NUM_SYMBOLS && drawn; ++k) {
+            // Bounds of the symbols after this one
+            int restLo = 0, restHiFree = 0, restLoGrouped = 0, restHiGrouped = 0;
+            for (int r = k + 1; r < NUM_SYMBOLS; ++r) {
+                const int symbol = order[r];
+                restLo += low(symbol);
+                if (grouped[symbol]) {
+                    restLoGrouped += low(symbol);
+                    restHiGrouped += high(symbol);
+                } else {
+                    restHiFree += high(symbol);
+                }
+            }
+            // Values that keep the rest feasible: total = remaining, grouped total <= capLeft
+            const int symbol = order[k];
+            uint32_t feasible = 0;
+            for (uint32_t bits = domain[symbol]; bits; bits &= bits - 1) {
+                const int v = __builtin_ctz(bits);
+                const int rest = remaining - v;
+                const int restCap = capLeft - (grouped[symbol] ? v : 0);
+                if (restCap < restLoGrouped || rest < restLo || rest > restHiFree + std::min(restHiGrouped, restCap)) continue;
+                feasible |= 1u << v;
+            }
+            if (feasible == 0) {
+                drawn = false;
+                break;
+            }
+            int pick = std::uniform_int_distribution<int>(0, __builtin_popcount(feasible) - 1)(rng);
+            while (pick-- > 0) feasible &= feasible - 1;
+            chosen[symbol] = __builtin_ctz(feasible);
+            remaining -= chosen[symbol];
+            if (grouped[symbol]) capLeft -= chosen[symbol];
+        }
+        // An infeasible draw means no assignment of this board exists at all
+        if (!drawn) return false;
+
+        SymbolCounts next{};
+        for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+            next[symbol] = plan.target[board][symbol] >= 0 ? 0 : chosen[symbol];
+        }
+        if (assignBoard(plan, board + 1, next, rng, counts, nodes)) return true;
+    }
+    return false;
+}
+
+bool RefillSolver::fill(Board& board, const SymbolCounts& counts, int multipliers, std::mt19937_64& rng) {
+    SymbolCounts existing{};
+    std::vector<std::pair<int, int>> empties;
+    for (int row = 0; row < static_cast<int>(board.size()); ++row) {
+        for (int col = 0; col < static_cast<int>(board[row].size()); ++col) {
+            int value = board[row][col];
+            if (value == -1) {
+                empties.emplace_back(row, col);
+            } else if (value >= 0 && value < NUM_SYMBOLS) {
+                existing[value]++;
+            }
+        }
+    }
+    std::vector<int> fill(multipliers, SlotSS02::get_multiplier_symbol());
+    for (int symbol = 0; symbol < NUM_SYMBOLS; ++symbol) {
+        if (counts[symbol] < existing[symbol]) return false;
+        fill.insert(fill.end(), counts[symbol] - existing[symbol], symbol);
+    }
+    if (fill.size() != empties.size()) return false;
+    std::shuffle(fill.begin(), fill.end(), rng);
+    for (size_t i = 0; i < empties.size(); ++i) {
+        board[empties[i].first][empties[i].second] = fill[i];
+    }
+    return true;
+}
+
+bool SS02ScriptGenerator::tryGenerate(const CompositionSpec& spec, GeneratedScript& out, BoardHashIndex* unique) {
+    const int height = game_.get_board_height();
+    const int width = game_.get_board_width();
+    const size_t steps = spec.steps.size();
+
+    std::vector<Board> script;
+    if (steps == 0) {
+        script.push_back(unique ? terminal_.sampleUnique(rng_, *unique, spec.multiplier_count)
+                                : terminal_.sample(rng_, spec.multiplier_count));
+    } else {
+        // validate() has already ruled out infeasible plans, so a failed solve only ran out of
+        // its node budget; retry with fresh random choices
+        std::vector<SymbolCounts> counts;
+        if (!refill_.solve(spec, rng_, counts)) return false;
+        Board board(height, std::vector<int>(width, -1));
+        if (!RefillSolver::fill(board, counts[0], spec.multiplier_count, rng_)) return false;
+        script.push_back(board);
+
+        // Each winning step is followed by the refilled survivors of that step
+        for (size_t i = 0; i < steps; ++i) {
+            auto [patterns, has_match] = game_.find_matches(script.back());
+            if (!has_match) return false;
+            Board next = game_.apply_gravity(game_.eliminate_matches(script.back(), patterns));
+            if (!RefillSolver::fill(next, counts[i + 1], 0, rng_)) return false;
+            script.push_back(next);
+        }
+    }
+
+    // Self-verify through the engine
+    auto [final_board, total_score, actual_stop, patterns, boards_match] = game_.steps(script, spec.special_multipliers);
+    int expected = expectedPayout(spec);
+    if (!boards_match || actual_stop != static_cast<int>(script.size()) ||
+        static_cast<int>(total_score) != expected || !game_.is_terminal(script.back())) {
+        return false;
+    }
+    if (unique && steps > 0 && !unique->insert(script[0])) {
+        return false;
+    }
+
+    out.script = std::move(script);
+    out.stop = actual_stop;
+    out.payout = expected;
+    out.payout_id = spec.payout_id;
+    out.special_multipliers = spec.special_multipliers;
+    out.multiplier_count = spec.multiplier_count;
+    out.is_free = game_.get_config().game_type == "free";
+    return true;
+}
+
+GeneratedScript SS02ScriptGenerator::generate(const CompositionSpec& spec, int max_attempts) {
+    validate(spec);
+    GeneratedScript result;
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        if (tryGenerate(spec, result, nullptr)) {
+            return result;
+        }
+    }
+    throw std::runtime_error("No verified script found after " + std::to_string(max_attempts) + " attempts");
+}
+
+GeneratedScript SS02ScriptGenerator::generateUnique(const CompositionSpec& spec, BoardHashIndex& index, int max_attempts) {
+    validate(spec);
+    GeneratedScript result;
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        if (tryGenerate(spec, result, &index)) {
+            return result;
+        }
+    }
+    throw std::runtime_error("No verified unique script found after " + std::to_string(max_attempts) + " attempts");
+}
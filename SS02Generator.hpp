@@ -0,0 +1,155 @@
+// SS02Generator.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include "json.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// One winning cluster of a cascade step: `count` copies of `symbol` on the board
+struct ClusterSpec {
+    int symbol = 0;
+    int count = 0;
+};
+
+// Target composition of a script. steps[i] holds the clusters that must win on board i;
+// a script with no steps is a zero-payout (single terminal board) script.
+struct CompositionSpec {
+    std::vector<std::vector<ClusterSpec>> steps;
+    int special_multipliers = 1;   // Free games only
+    int multiplier_count = 0;      // MULTIPLIER symbols placed on the first board (free games only)
+    int payout_id = 0;             // Carried through to the output
+    int repeat = 1;                // Number of scripts to generate from this composition
+
+    static CompositionSpec fromJson(const nlohmann::json& j);
+};
+
+// A generated script in the same shape as SS02_scripts.json entries
+struct GeneratedScript {
+    std::vector<Board> script;
+    int stop = 0;
+    int payout = 0;
+    int payout_id = 0;
+    int special_multipliers = 1;
+    int multiplier_count = 0;
+    bool is_free = false;
+
+    nlohmann::json toJson(int index) const;
+};
+
+// Hash index of packed boards (one byte per cell, at most 32 cells), used to keep the first
+// boards of a section unique
+class BoardHashIndex {
+public:
+    // False if the board is already in the index
+    bool insert(const Board& board);
+    size_t size() const { return boards_.size(); }
+
+private:
+    using Key = std::array<uint8_t, 32>;
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    std::unordered_set<Key, KeyHash> boards_;
+};
+
+// Samples terminal boards - every symbol below the minimum match size - without rejection.
+// A count vector is drawn from precomputed completion tables, then the counts (and any
+// MULTIPLIER cells) are placed by a random permutation. With uniform weights every terminal
+// board is equally likely; otherwise cells are i.i.d. under `weights` conditioned on the
+// board being terminal.
+class TerminalBoardSampler {
+public:
+    // weights: one per symbol (empty = uniform)
+    explicit TerminalBoardSampler(const SlotSS02& game, const std::vector<double>& weights = {});
+
+    // Throws std::runtime_error if no terminal board has `multiplier_count` MULTIPLIER cells
+    Board sample(std::mt19937_64& rng, int multiplier_count = 0) const;
+
+    // Samples until the board is new to `index` and adds it; throws std::runtime_error after
+    // max_tries boards that were all already in the index
+    Board sampleUnique(std::mt19937_64& rng, BoardHashIndex& index, int multiplier_count = 0, int max_tries = 1000) const;
+
+private:
+    int height_;
+    int width_;
+    int maxCount_;                                  // min_match_size - 1
+    std::vector<std::vector<double>> term_;         // [symbol][count] w^count / count!
+    std::vector<std::vector<double>> completions_;  // [symbol][cells] sum over the counts of symbols >= symbol
+};
+
+// Symbol counts of one board, SS02 symbols 0..8 (MULTIPLIER cells not included)
+using SymbolCounts = std::array<int, 9>;
+
+// Plans the symbol counts of every board of a cascade and fills boards to match them.
+//
+// SS02 matching only depends on counts, so a script realizes a composition iff board i holds
+// exactly the step-i clusters with every other symbol below the minimum match size, the last
+// board is terminal, and every non-winning cell carries over (counts can only grow until the
+// symbol wins). Each symbol's possible counts on each board are a bitmask domain: winning
+// symbols are fixed, the others are bounded above by the match size and, propagated backwards,
+// by the next cluster of that symbol, and below by the cells carried from the previous board.
+// Boards are assigned in order; within a board the sum constraints (all cells used, the next
+// step's clusters must fit in the cells it refills) are checked for every candidate value, and
+// a board that leaves the next one infeasible is re-drawn, backtracking if necessary.
+class RefillSolver {
+public:
+    explicit RefillSolver(const SlotSS02& game);
+
+    // counts[i] for boards 0..steps; false if the composition is infeasible or the search
+    // exceeds node_budget board assignments
+    bool solve(const CompositionSpec& spec, std::mt19937_64& rng, std::vector<SymbolCounts>& counts,
+               int node_budget = 2000) const;
+
+    // False if bound propagation already rules the composition out
+    bool feasible(const CompositionSpec& spec) const;
+
+    // Fills the -1 cells of `board` in random order so its counts become `counts`, plus
+    // `multipliers` MULTIPLIER cells; false if the empty cells do not add up
+    static bool fill(Board& board, const SymbolCounts& counts, int multipliers, std::mt19937_64& rng);
+
+private:
+    struct Plan;
+    bool buildPlan(const CompositionSpec& spec, Plan& plan) const;
+    bool assignBoard(const Plan& plan, size_t board, const SymbolCounts& carried, std::mt19937_64& rng,
+                     std::vector<SymbolCounts>& counts, int& nodes) const;
+
+    int cells_;
+    int maxCount_;   // min_match_size - 1
+};
+
+// Builds boards and cascades that realize a composition and self-verifies them through
+// SlotSS02::steps. SS02 matching only depends on symbol counts, so each board is built
+// from a count vector (RefillSolver) and a random placement of those counts.
+class SS02ScriptGenerator {
+public:
+    SS02ScriptGenerator(const std::string& game_type, uint64_t seed);
+
+    // Generate one script; throws std::runtime_error if the composition is infeasible
+    // or no verified script was found within max_attempts.
+    GeneratedScript generate(const CompositionSpec& spec, int max_attempts = 200);
+
+    // As generate, but the first board must be new to `index` and is added to it. Zero-payout
+    // boards come straight from TerminalBoardSampler::sampleUnique (which throws once it cannot
+    // find an unseen board); winning scripts are re-drawn on a collision.
+    GeneratedScript generateUnique(const CompositionSpec& spec, BoardHashIndex& index, int max_attempts = 200);
+
+    // Payout the composition should produce under the SS02 pay table
+    int expectedPayout(const CompositionSpec& spec) const;
+
+    // Throws std::runtime_error describing why a composition can never be realized
+    void validate(const CompositionSpec& spec) const;
+
+    void reseed(uint64_t seed) { rng_.seed(seed); }
+
+private:
+    bool tryGenerate(const CompositionSpec& spec, GeneratedScript& out, BoardHashIndex* unique);
+
+    SlotSS02 game_;
+    TerminalBoardSampler terminal_;   // Zero-payout scripts
+    RefillSolver refill_;             // Winning scripts
+    std::mt19937_64 rng_;
+};
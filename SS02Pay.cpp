@@ -1,4 +1,5 @@
 #include "SS02Pay.hpp"
+#include "Instrumentation.h"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
@@ -65,6 +66,7 @@ Board SlotSS02::apply_gravity(const Board& board) {
 
 
 std::pair<MatchPatterns, bool> SlotSS02::find_matches(const Board& board) {
+    SS02_COUNT("find_matches");
     MatchPatterns match_patterns;
     bool has_match = false;
 
@@ -129,6 +131,7 @@ std::tuple<Board, float, int, std::vector<MatchPatterns>, bool> SlotSS02::steps(
     std::vector<MatchPatterns> all_patterns;
 
     while (!is_terminal(current_board) && actual_stop < static_cast<int>(script.size())-1) { 
+        SS02_COUNT("cascade_steps");
         auto [patterns, has_match] = find_matches(current_board);
         // Record the patterns for this step
         all_patterns.push_back(patterns);
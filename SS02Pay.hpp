@@ -54,6 +54,9 @@ public:
     // Setter for volatility type
     void set_volatility_type(const std::string& type) { volatility_type_ = type; }
     
+    // Symbol value used for MULTIPLIER cells in free games
+    static constexpr int get_multiplier_symbol() { return MULTIPLIER; }
+    
     // Get multiplier table based on volatility type
     static nlohmann::json get_multiplier_table(const std::string& volatility_type);
     
@@ -0,0 +1,170 @@
+#include "SS02Rescore.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+constexpr int SIZES = SS02BatchEvaluator::CELLS + 1;
+
+int symbolKey(const std::string& key) {
+    int symbol = -1;
+    try {
+        symbol = std::stoi(key);
+    } catch (const std::exception&) {
+    }
+    if (symbol < 0 || symbol >= SS02BatchEvaluator::NUM_SYMBOLS) {
+        throw std::runtime_error("Invalid pay table symbol: " + key);
+    }
+    return symbol;
+}
+
+}  // namespace
+
+PayTable PayTable::fromGame(const SlotSS02& game) {
+    PayTable table;
+    table.name = "current";
+    const auto& payTable = game.get_config().pay_table;
+    for (int symbol = 0; symbol < SS02BatchEvaluator::NUM_SYMBOLS; ++symbol) {
+        for (int count = game.get_min_match_size(); count < SIZES; ++count) {
+            auto it = payTable.find(symbol);
+            table.pay[symbol][count] = it != payTable.end() && it->second.count(count) ? it->second.at(count) : symbol * count;
+        }
+    }
+    return table;
+}
+
+std::vector<PayTable> PayTable::loadCandidates(const std::string& filename, const PayTable& defaults) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    nlohmann::json j;
+    file >> j;
+    if (!j.contains("candidates") || !j.at("candidates").is_array()) {
+        throw std::runtime_error(filename + ": expected a \"candidates\" array");
+    }
+    std::vector<PayTable> candidates;
+    for (const auto& entry : j.at("candidates")) {
+        PayTable table = defaults;
+        table.name = entry.value("name", "candidate " + std::to_string(candidates.size() + 1));
+        if (entry.contains("pay_table")) {
+            for (const auto& [symbolText, pays] : entry.at("pay_table").items()) {
+                int symbol = symbolKey(symbolText);
+                for (const auto& [countText, value] : pays.items()) {
+                    int count = std::stoi(countText);
+                    if (count < 0 || count >= SIZES) {
+                        throw std::runtime_error(table.name + ": invalid cluster size " + countText);
+                    }
+                    table.pay[symbol][count] = value.get<double>();
+                }
+            }
+        }
+        if (entry.contains("scale")) {
+            for (const auto& [symbolText, factor] : entry.at("scale").items()) {
+                for (double& pay : table.pay[symbolKey(symbolText)]) pay *= factor.get<double>();
+            }
+        }
+        candidates.push_back(table);
+    }
+    return candidates;
+}
+
+ClusterHistogram ClusterHistogram::build(const ScriptApp::ScriptConfig& config) {
+    ClusterHistogram h;
+    h.stepStart.push_back(0);
+    h.rowStart.push_back(0);
+    for (bool isFree : {false, true}) {
+        const auto& scripts = isFree ? config.free_scripts : config.base_scripts;
+        SlotSS02 game(true, 20.0f, isFree ? "free" : "base");
+        SS02BatchEvaluator evaluator(game);
+        std::vector<const std::vector<Board>*> boards;
+        std::vector<int> specials;
+        for (const auto& [index, scriptData] : scripts) {
+            boards.push_back(&scriptData.script);
+            specials.push_back(scriptData.special_multipliers);
+        }
+        auto results = evaluator.evaluate(boards, specials);
+
+        size_t i = 0;
+        for (const auto& [index, scriptData] : scripts) {
+            const BatchScriptResult& r = results[i++];
+            // Steps 0 .. stop - 2 each pay the clusters of script[step]
+            for (int step = 0; step + 1 < r.stop; ++step) {
+                std::array<int, SS02BatchEvaluator::NUM_SYMBOLS> symbolCells{};
+                for (const auto& row : scriptData.script[step]) {
+                    for (int v : row) {
+                        if (v >= 0 && v < SS02BatchEvaluator::NUM_SYMBOLS) symbolCells[v]++;
+                    }
+                }
+                for (int symbol = 0; symbol < SS02BatchEvaluator::NUM_SYMBOLS; ++symbol) {
+                    if (symbolCells[symbol] < game.get_min_match_size()) continue;
+                    h.feature.push_back(static_cast<uint16_t>(symbol * SIZES + symbolCells[symbol]));
+                }
+                h.rowStart.push_back(static_cast<uint32_t>(h.feature.size()));
+            }
+            h.stepStart.push_back(static_cast<uint32_t>(h.rowStart.size() - 1));
+            const bool multiplied = isFree && r.multiplier_count > 0;
+            h.factor.push_back(multiplied ? r.multiplier_count * scriptData.special_multipliers : 1);
+            h.multiplierCount.push_back(multiplied ? r.multiplier_count : 0);
+            h.table.push_back(scriptData.multiple_table + 1);
+            h.recordedPayout.push_back(scriptData.payout);
+            h.enginePayout.push_back(r.score);
+        }
+        if (!isFree) h.baseRows = h.rows();
+    }
+    return h;
+}
+
+std::vector<double> PayTableRescorer::payouts(const std::vector<PayTable>& candidates, unsigned threads) const {
+    const size_t rows = histogram_.rows();
+    std::vector<double> out(candidates.size() * rows);
+
+    for (size_t first = 0; first < candidates.size(); first += BATCH) {
+        const size_t width = std::min(BATCH, candidates.size() - first);
+        // Pay matrix, feature-major so that one feature's BATCH pays are contiguous
+        std::vector<double> pays(static_cast<size_t>(ClusterHistogram::FEATURES) * BATCH, 0.0);
+        for (size_t k = 0; k < width; ++k) {
+            for (int f = 0; f < ClusterHistogram::FEATURES; ++f) {
+                pays[f * BATCH + k] = candidates[first + k].pay[f / SIZES][f % SIZES];
+            }
+        }
+
+        auto work = [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                double total[BATCH] = {};
+                for (uint32_t step = histogram_.stepStart[r]; step < histogram_.stepStart[r + 1]; ++step) {
+                    double acc[BATCH] = {};
+                    for (uint32_t e = histogram_.rowStart[step]; e < histogram_.rowStart[step + 1]; ++e) {
+                        const double* p = &pays[histogram_.feature[e] * BATCH];
+                        for (size_t k = 0; k < BATCH; ++k) acc[k] += p[k];
+                    }
+                    for (size_t k = 0; k < BATCH; ++k) total[k] += std::trunc(acc[k]);
+                }
+                for (size_t k = 0; k < width; ++k) out[(first + k) * rows + r] = total[k] * histogram_.factor[r];
+            }
+        };
+        const size_t workers = std::max<size_t>(1, std::min<size_t>(threads, rows / 4096 + 1));
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < workers; ++t) pool.emplace_back(work, rows * t / workers, rows * (t + 1) / workers);
+        for (auto& t : pool) t.join();
+    }
+    return out;
+}
+
+ScriptOutcomeCache PayTableRescorer::outcomes(const std::vector<double>& payouts, size_t candidate) const {
+    ScriptOutcomeCache cache;
+    const size_t rows = histogram_.rows();
+    for (size_t r = 0; r < rows; ++r) {
+        const double payout = payouts[candidate * rows + r];
+        ScriptOutcome outcome;
+        outcome.payout = static_cast<int>(payout);   // Already whole credits
+        outcome.basePayout = payout / histogram_.factor[r];
+        outcome.multiplierCount = histogram_.multiplierCount[r];
+        outcome.table = histogram_.table[r];
+        (histogram_.isFree(r) ? cache.free : cache.base).push_back(outcome);
+    }
+    return cache;
+}
@@ -0,0 +1,72 @@
+// SS02Rescore.hpp
+#pragma once
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "SS02BatchEval.hpp"
+#include "ScriptConfig.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Candidate pay table, pay[symbol][count] for cluster sizes 0..30. Counts below the
+// minimum match size never occur in a cluster histogram and are ignored.
+struct PayTable {
+    std::string name;
+    std::array<std::array<double, SS02BatchEvaluator::CELLS + 1>, SS02BatchEvaluator::NUM_SYMBOLS> pay{};
+
+    // The game's table with the SlotBase::get_score fallback (symbol * count) for missing entries
+    static PayTable fromGame(const SlotSS02& game);
+
+    // Candidates file: {"candidates": [{"name": "...", "pay_table": {"0": {"8": 250, ...}, ...},
+    // "scale": {"0": 1.1}}]}. Entries not given keep their value in `defaults`; "scale"
+    // multiplies every pay of a symbol after the overrides are applied.
+    static std::vector<PayTable> loadCandidates(const std::string& filename, const PayTable& defaults);
+};
+
+// Cascade outcome of every script reduced to what the pay table acts on: the (symbol, cluster
+// size) pairs paid in each cascade step, stored as a sparse matrix in CSR form with one row per
+// step (a symbol forms at most one cluster per step). A script's payout under pay table p
+// follows SlotSS02::steps(): each step pays sum(p[feature]) truncated to an integer, and the
+// script's total is multiplied by factor.
+struct ClusterHistogram {
+    static constexpr int FEATURES = SS02BatchEvaluator::NUM_SYMBOLS * (SS02BatchEvaluator::CELLS + 1);
+
+    size_t baseRows = 0;                // Base scripts first, then free scripts
+    std::vector<uint32_t> stepStart;    // rows() + 1 offsets into the step rows
+    std::vector<uint32_t> rowStart;     // One offset per step row into feature, plus the end
+    std::vector<uint16_t> feature;      // symbol * (CELLS + 1) + cluster size
+    std::vector<int> factor;            // multiplierCount * special_multipliers, else 1
+    std::vector<int> multiplierCount;
+    std::vector<int> table;             // Multiplier table (multiple_table + 1)
+    std::vector<int> recordedPayout;    // Payout stored in the script file
+    std::vector<int> enginePayout;      // Batch engine payout under the game's pay table
+
+    size_t rows() const { return factor.size(); }
+    bool isFree(size_t row) const { return row >= baseRows; }
+
+    // Runs every cascade once with the batch engine; the clusters of each step follow from
+    // the step's board, which the engine has verified to be the script's board at that stop.
+    static ClusterHistogram build(const ScriptApp::ScriptConfig& config);
+};
+
+// Rescores a cluster histogram under many pay tables at once: candidates are processed in
+// groups of BATCH as one sparse-matrix x dense (features x BATCH) product, scripts split across
+// threads. Every payout is an integer, truncated per step as SlotSS02::steps() does, so
+// fractional pay values round the same way a full re-run would (up to float vs double
+// precision in the step sum).
+class PayTableRescorer {
+public:
+    static constexpr size_t BATCH = 8;
+
+    explicit PayTableRescorer(const ClusterHistogram& histogram) : histogram_(histogram) {}
+
+    // payouts[c * rows + r]: payout of script r under candidate c (whole credits)
+    std::vector<double> payouts(const std::vector<PayTable>& candidates, unsigned threads) const;
+
+    // Outcome cache of candidate c for SS02AnalyticRtp, taken from payouts()
+    ScriptOutcomeCache outcomes(const std::vector<double>& payouts, size_t candidate) const;
+
+private:
+    const ClusterHistogram& histogram_;
+};
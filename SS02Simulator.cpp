@@ -0,0 +1,398 @@
+#include "SS02Simulator.hpp"
+#include "Checkpoint.h"
+#include "SeedMix.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+void putStats(Checkpoint::Writer& out, const SimulationStats& stats) {
+    out.put(stats.trials);
+    out.put(stats.mean);
+    out.put(stats.m2);
+    out.put(stats.maxWin);
+    out.put(stats.histogram);
+    out.put(stats.batches);
+    out.put(stats.batchMean);
+    out.put(stats.batchM2);
+}
+
+SimulationStats getStats(Checkpoint::Reader& in) {
+    SimulationStats stats;
+    stats.trials = in.get<uint64_t>();
+    stats.mean = in.get<double>();
+    stats.m2 = in.get<double>();
+    stats.maxWin = in.get<double>();
+    stats.histogram = in.get<decltype(stats.histogram)>();
+    stats.batches = in.get<uint64_t>();
+    stats.batchMean = in.get<double>();
+    stats.batchM2 = in.get<double>();
+    return stats;
+}
+
+}  // namespace
+
+constexpr std::array<double, 11> SimulationStats::RATIO_EDGES;
+
+size_t SimulationStats::bucket(double ratio) {
+    return static_cast<size_t>(std::upper_bound(RATIO_EDGES.begin(), RATIO_EDGES.end(), ratio) - RATIO_EDGES.begin());
+}
+
+double SimulationStats::halfWidth(double z, double stake) const {
+    if (trials < 2) return INFINITY;
+    return z * std::sqrt(variance() / static_cast<double>(trials)) / stake;
+}
+
+double SimulationStats::batchHalfWidth(double z, double stake) const {
+    if (batches < MIN_BATCHES) return INFINITY;
+    const double between = batchM2 / static_cast<double>(batches - 1);
+    return z * std::sqrt(between / static_cast<double>(batches)) / stake;
+}
+
+double StoppingRule::zScore() const {
+    if (confidence <= 0.0 || confidence >= 1.0) {
+        throw std::runtime_error("Confidence level must be in (0, 1)");
+    }
+    // Solve erfc(z / sqrt(2)) = 1 - confidence by bisection
+    double lo = 0.0, hi = 40.0;
+    for (int it = 0; it < 200; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid / std::sqrt(2.0)) > 1.0 - confidence) lo = mid; else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+void SimulationStats::add(double estimate, double win, double weight, double stake) {
+    trials++;
+    const double delta = estimate - mean;
+    mean += delta / static_cast<double>(trials);
+    m2 += delta * (estimate - mean);
+    maxWin = std::max(maxWin, win);
+    histogram[bucket(win / stake)] += weight;
+}
+
+void SimulationStats::closeBatch() {
+    batches = 1;
+    batchMean = mean;
+    batchM2 = 0.0;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    if (other.trials == 0) return;
+    if (trials == 0) {
+        *this = other;
+        return;
+    }
+    const double n = static_cast<double>(trials), m = static_cast<double>(other.trials);
+    const double delta = other.mean - mean;
+    mean += delta * m / (n + m);
+    m2 += other.m2 + delta * delta * n * m / (n + m);
+    trials += other.trials;
+    maxWin = std::max(maxWin, other.maxWin);
+    for (size_t i = 0; i < BUCKETS; ++i) histogram[i] += other.histogram[i];
+
+    if (other.batches > 0) {
+        const double bn = static_cast<double>(batches), bm = static_cast<double>(other.batches);
+        const double bd = other.batchMean - batchMean;
+        batchMean += bd * bm / (bn + bm);
+        batchM2 += other.batchM2 + bd * bd * bn * bm / (bn + bm);
+        batches += other.batches;
+    }
+}
+
+void SimulationState::add(const SimulationStats& batch) {
+    partial.merge(batch);
+    if (++nextBatch % BLOCK_BATCHES == 0) {
+        blocks.push_back(partial);
+        folded_.merge(partial);
+        partial = SimulationStats();
+    }
+}
+
+void SimulationState::merge(const SimulationState& next) {
+    if (next.firstBatch != nextBatch) {
+        throw std::runtime_error("Cannot merge simulation states: batches " + std::to_string(next.firstBatch) +
+                                 ".. do not follow batch " + std::to_string(nextBatch));
+    }
+    if (nextBatch == firstBatch) {
+        *this = next;
+        return;
+    }
+    if (next.fingerprint != fingerprint) {
+        throw std::runtime_error("Cannot merge simulation states of different runs");
+    }
+    if (next.nextBatch == next.firstBatch) return;
+    if (nextBatch % SimulationState::BLOCK_BATCHES != 0 ||
+        total().trials != (nextBatch - firstBatch) * SessionSimulator::BATCH) {
+        throw std::runtime_error("Cannot merge simulation states: batch " + std::to_string(nextBatch) +
+                                 " is not on a block boundary");
+    }
+    for (const auto& block : next.blocks) {
+        blocks.push_back(block);
+        folded_.merge(block);
+    }
+    partial = next.partial;
+    nextBatch = next.nextBatch;
+}
+
+SimulationStats SimulationState::total() const {
+    SimulationStats stats = folded_;
+    stats.merge(partial);
+    return stats;
+}
+
+void SimulationState::save(const std::string& path) const {
+    Checkpoint::Writer out;
+    out.put(firstBatch);
+    out.put(nextBatch);
+    out.put<uint64_t>(blocks.size());
+    for (const auto& block : blocks) putStats(out, block);
+    putStats(out, partial);
+    out.save(path, Checkpoint::SIMULATION, fingerprint);
+}
+
+SimulationState SimulationState::load(const std::string& path, uint64_t fingerprint) {
+    Checkpoint::Reader in(path, Checkpoint::SIMULATION, fingerprint);
+    SimulationState state;
+    state.fingerprint = fingerprint;
+    state.firstBatch = in.get<uint64_t>();
+    state.nextBatch = in.get<uint64_t>();
+    const uint64_t count = in.get<uint64_t>();
+    if (state.nextBatch < state.firstBatch ||
+        count != state.nextBatch / BLOCK_BATCHES - state.firstBatch / BLOCK_BATCHES) {
+        throw std::runtime_error(path + ": inconsistent batch range");
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        state.blocks.push_back(getStats(in));
+        state.folded_.merge(state.blocks.back());
+    }
+    state.partial = getStats(in);
+    return state;
+}
+
+SessionSimulator::SessionSimulator(const ScriptOutcomeView& outcomes, const RtpParameters& params,
+                                   const VarianceReduction& reduction)
+    : outcomes_(outcomes), params_(params), reduction_(reduction) {
+    if (outcomes_.base.empty() || outcomes_.free.empty()) {
+        throw std::runtime_error("Simulation needs both base and free scripts");
+    }
+    if (params_.fgRounds * params_.fgRetrigger >= 1.0) {
+        throw std::runtime_error("fgRounds * fgRetrigger >= 1: free game sessions never end");
+    }
+    if (reduction_.triggerRate < 0.0 || reduction_.triggerRate >= 1.0) {
+        throw std::runtime_error("Importance sampling trigger rate must be in [0, 1)");
+    }
+    for (const auto& o : outcomes_.base) baseMean_ += o.payout / static_cast<double>(outcomes_.base.size());
+
+    const nlohmann::json tables = params_.multiplierTables();
+    for (const auto& entry : tables.at("free")) {
+        const int id = entry.at("id").get<int>();
+        if (id < 0) throw std::runtime_error("Invalid multiplier table id " + std::to_string(id));
+        if (static_cast<size_t>(id) >= tables_.size()) tables_.resize(id + 1);
+        const auto multipliers = entry.at("multiplier").get<std::vector<int>>();
+        const auto weights = entry.at("weight").get<std::vector<double>>();
+        if (multipliers.size() != weights.size()) {
+            throw std::runtime_error("Multiplier table " + std::to_string(id) + " has mismatched weights");
+        }
+        Table& table = tables_[id];
+        double total = 0.0, tilted = 0.0;
+        std::vector<double> sampling;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            const double w = std::max(0.0, weights[i]);
+            const int offset = multipliers[i] - 100;
+            if (reduction_.multiplierTilt != 0.0 && offset <= 0 && w > 0.0) {
+                throw std::runtime_error("Multiplier tilt needs multipliers above 100");
+            }
+            sampling.push_back(reduction_.multiplierTilt != 0.0 && w > 0.0 ? w * std::pow(offset, reduction_.multiplierTilt) : w);
+            total += w;
+            tilted += sampling.back();
+            table.cumulative.push_back(tilted);
+            table.offsets.push_back(offset);
+        }
+        for (size_t i = 0; i < weights.size(); ++i) {
+            table.likelihood.push_back(sampling[i] > 0.0 ? (std::max(0.0, weights[i]) / total) / (sampling[i] / tilted) : 0.0);
+        }
+    }
+    if (params_.drawMultipliers) {
+        for (const auto* section : {&outcomes_.free, &outcomes_.buy}) {
+            for (const auto& o : *section) {
+                if (o.multiplierCount == 0) continue;
+                if (static_cast<size_t>(o.table) >= tables_.size() || tables_[o.table].cumulative.empty() ||
+                    tables_[o.table].cumulative.back() <= 0.0) {
+                    throw std::runtime_error("Multiplier table " + std::to_string(o.table) + " has no usable weights");
+                }
+            }
+        }
+    }
+}
+
+double SessionSimulator::stake(SimulationMode mode) const {
+    return mode == SimulationMode::Buy ? params_.buyCost * params_.bet : params_.bet;
+}
+
+uint64_t SessionSimulator::fingerprint(SimulationMode mode, uint64_t seed) const {
+    Checkpoint::Fingerprint hash;
+    hash.add(outcomes_.fingerprint()).add(params_.bet).add(params_.fgTrigger).add(params_.fgRetrigger).add(params_.fgRounds)
+        .add(params_.drawMultipliers).add(params_.buyCost);
+    for (const auto& table : tables_) {
+        hash.add<uint64_t>(table.offsets.size());
+        for (size_t i = 0; i < table.offsets.size(); ++i) {
+            hash.add(table.offsets[i]).add(table.cumulative[i]).add(table.likelihood[i]);
+        }
+    }
+    hash.add(reduction_.stratify).add(reduction_.triggerRate).add(reduction_.multiplierTilt).add(reduction_.controlVariate);
+    hash.add(mode).add(seed).add(BATCH).add(SimulationState::BLOCK_BATCHES);
+    return hash.value();
+}
+
+double SessionSimulator::freeSpin(std::mt19937_64& rng, const ScriptOutcomeSpan& scripts, double& weight) const {
+    const ScriptOutcome& o = scripts[std::uniform_int_distribution<size_t>(0, scripts.size() - 1)(rng)];
+    if (!params_.drawMultipliers || o.multiplierCount == 0) return o.payout;
+    const Table& table = tables_[o.table];
+    std::uniform_real_distribution<double> unit(0.0, table.cumulative.back());
+    int sum = 0;
+    for (int draw = 0; draw < o.multiplierCount; ++draw) {
+        size_t i = std::upper_bound(table.cumulative.begin(), table.cumulative.end(), unit(rng)) - table.cumulative.begin();
+        i = std::min(i, table.offsets.size() - 1);
+        sum += table.offsets[i];
+        weight *= table.likelihood[i];
+    }
+    return o.basePayout * sum;
+}
+
+SessionSimulator::Session SessionSimulator::session(std::mt19937_64& rng, const ScriptOutcomeSpan& scripts) const {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Session s;
+    for (long long spins = params_.fgRounds; spins > 0; --spins) {
+        double weight = 1.0;
+        const double win = freeSpin(rng, scripts, weight);
+        s.win += win;
+        s.estimate += weight * win;
+        s.weight *= weight;
+        if (unit(rng) < params_.fgRetrigger) spins += params_.fgRounds;
+    }
+    return s;
+}
+
+SimulationStats SessionSimulator::runBatch(SimulationMode mode, uint64_t batch, uint64_t trials, uint64_t seed) const {
+    std::mt19937_64 rng(mixSeed(seed, batch));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pickBase(0, outcomes_.base.size() - 1);
+    const double stakeSize = stake(mode);
+    const double p = params_.fgTrigger;
+    const double q = reduction_.triggerRate > 0.0 ? reduction_.triggerRate : p;
+    const size_t rotation = reduction_.stratify ? pickBase(rng) : 0;
+
+    SimulationStats stats;
+    const uint64_t begin = batch * BATCH, end = std::min(trials, begin + BATCH);
+    for (uint64_t trial = begin; trial < end; ++trial) {
+        if (mode == SimulationMode::Buy) {
+            const Session s = session(rng, outcomes_.buy.empty() ? outcomes_.free : outcomes_.buy);
+            stats.add(s.estimate, s.win, s.weight, stakeSize);
+            continue;
+        }
+        const size_t index = reduction_.stratify ? (rotation + (trial - begin)) % outcomes_.base.size() : pickBase(rng);
+        const double base = outcomes_.base[index].payout;
+        const double baseEstimate = reduction_.controlVariate ? baseMean_ : base;
+        if (unit(rng) < q) {
+            const Session s = session(rng, outcomes_.free);
+            stats.add(baseEstimate + p / q * s.estimate, base + s.win, p / q * s.weight, stakeSize);
+        } else {
+            stats.add(baseEstimate, base, (1.0 - p) / (1.0 - q), stakeSize);
+        }
+    }
+    stats.closeBatch();
+    return stats;
+}
+
+SimulationStats SessionSimulator::run(SimulationMode mode, uint64_t trials, uint64_t seed, unsigned threads) const {
+    StoppingRule fixed;
+    fixed.halfWidth = 0.0;
+    fixed.minTrials = fixed.maxTrials = trials;
+    return runUntil(mode, fixed, seed, threads).stats;
+}
+
+SimulationRun SessionSimulator::runUntil(SimulationMode mode, const StoppingRule& rule, uint64_t seed, unsigned threads) const {
+    SimulationState state;
+    return runUntil(mode, rule, seed, threads, state);
+}
+
+SimulationRun SessionSimulator::runUntil(SimulationMode mode, const StoppingRule& rule, uint64_t seed, unsigned threads,
+                                         SimulationState& state,
+                                         const std::function<void(const SimulationState&)>& checkpoint) const {
+    const double z = rule.zScore();
+    const double stakeSize = stake(mode);
+    const uint64_t batches = (rule.maxTrials + BATCH - 1) / BATCH;
+    const uint64_t hash = fingerprint(mode, seed);
+
+    if (state.nextBatch == state.firstBatch) {
+        if (state.firstBatch % SimulationState::BLOCK_BATCHES != 0) {
+            throw std::runtime_error("Simulation shards must start on a block boundary");
+        }
+        state.fingerprint = hash;
+    } else if (state.fingerprint != hash) {
+        throw std::runtime_error("Simulation state belongs to a different run");
+    }
+
+    SimulationRun run;
+    auto evaluate = [&]() {
+        run.stats = state.total();
+        run.halfWidth = reduction_.stratify ? run.stats.batchHalfWidth(z, stakeSize) : run.stats.halfWidth(z, stakeSize);
+        run.converged = rule.halfWidth > 0.0 && run.stats.trials >= rule.minTrials && run.halfWidth <= rule.halfWidth;
+    };
+    evaluate();
+    if (run.converged || state.nextBatch >= batches) return run;
+    if (run.stats.trials != (state.nextBatch - state.firstBatch) * BATCH) {
+        throw std::runtime_error("Simulation state ends with a partial batch and cannot be extended");
+    }
+
+    // Finished batches waiting for their turn to be merged
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::map<uint64_t, SimulationStats> pending;
+    std::atomic<uint64_t> next{state.nextBatch};
+    std::atomic<bool> stop{false};
+
+    auto worker = [&]() {
+        for (uint64_t b = next++; b < batches && !stop; b = next++) {
+            SimulationStats stats = runBatch(mode, b, rule.maxTrials, seed);
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.emplace(b, std::move(stats));
+            finished.notify_one();
+        }
+    };
+    std::vector<std::thread> pool;
+    const uint64_t workers = std::max<uint64_t>(1, std::min<uint64_t>(threads, batches - state.nextBatch));
+    for (uint64_t t = 0; t < workers; ++t) pool.emplace_back(worker);
+
+    auto join = [&]() {
+        stop = true;
+        for (auto& th : pool) th.join();
+    };
+    try {
+        while (state.nextBatch < batches && !run.converged) {
+            std::unique_lock<std::mutex> lock(mutex);
+            const uint64_t b = state.nextBatch;
+            finished.wait(lock, [&]() { return pending.count(b) > 0; });
+            SimulationStats stats = std::move(pending.at(b));
+            pending.erase(b);
+            lock.unlock();
+
+            state.add(stats);
+            evaluate();
+            if (checkpoint) checkpoint(state);
+        }
+    }
+    catch (...) {
+        join();
+        throw;
+    }
+    join();
+    return run;
+}
@@ -0,0 +1,179 @@
+// SS02Simulator.hpp
+#pragma once
+#include "SS02Analytic.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// What one simulated trial plays
+enum class SimulationMode {
+    Spin,   // One base spin, plus a free game session when it triggers
+    Buy     // One bought feature: a free game session of buy_free spins (free spins without any)
+};
+
+// Mergeable accumulator of trials. Each trial contributes an estimate of its win to the
+// Welford moments (the win itself under plain sampling; see VarianceReduction) and its
+// actual win, with its likelihood weight, to the max win and to a histogram of the win
+// relative to the stake (bet for spins, buyCost * bet for buys). Batch means get their own
+// Welford moments for estimators whose trials are not independent within a batch.
+struct SimulationStats {
+    // Bucket i holds win / stake in [RATIO_EDGES[i - 1], RATIO_EDGES[i]); the last bucket is open
+    static constexpr std::array<double, 11> RATIO_EDGES{0.25, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 500.0, 1000.0};
+    static constexpr size_t BUCKETS = RATIO_EDGES.size() + 1;
+    static constexpr uint64_t MIN_BATCHES = 16;    // Before batchHalfWidth is trusted
+
+    uint64_t trials = 0;
+    double mean = 0.0;
+    double m2 = 0.0;                           // Sum of squared deviations from the mean
+    double maxWin = 0.0;
+    std::array<double, BUCKETS> histogram{};   // Sum of likelihood weights (trial counts under plain sampling)
+    uint64_t batches = 0;
+    double batchMean = 0.0, batchM2 = 0.0;
+
+    void add(double estimate, double win, double weight, double stake);
+    void add(double win, double stake) { add(win, win, 1.0, stake); }
+    void closeBatch();                          // Record this accumulator as one batch mean
+    void merge(const SimulationStats& other);   // Chan et al. pairwise update
+    double variance() const { return trials > 1 ? m2 / static_cast<double>(trials - 1) : 0.0; }
+    // Confidence interval half-width of the mean RTP (mean / stake) for normal quantile z,
+    // from the per-trial variance or from the spread of the batch means
+    double halfWidth(double z, double stake) const;
+    double batchHalfWidth(double z, double stake) const;
+    static size_t bucket(double ratio);
+};
+
+// Variance reduction for SessionSimulator; every option keeps the RTP estimate unbiased.
+//  - stratify: base script indices run through a random rotation of 0..N-1 within each batch,
+//    so every script is drawn equally often. Trials in a batch are no longer independent, so
+//    confidence intervals come from the batch means.
+//  - triggerRate: free games are triggered with this probability instead of fgTrigger and the
+//    session is weighted by fgTrigger / triggerRate (0 = off; spin mode only).
+//  - multiplierTilt: multiplier draws use weights w * (multiplier - 100)^tilt, and each free
+//    spin is weighted by the likelihood ratio of its draws (0 = off).
+//  - controlVariate: the base spin's payout is replaced by its exact mean over the scripts - a
+//    control variate with coefficient 1, which is optimal because the spin is independent of
+//    the session (spin mode only; a bought feature has no base spin).
+// Weighted wins feed the histogram with the whole trial's likelihood ratio, so tail
+// probabilities stay unbiased too.
+struct VarianceReduction {
+    bool stratify = false;
+    double triggerRate = 0.0;
+    double multiplierTilt = 0.0;
+    bool controlVariate = false;
+
+    bool any() const { return stratify || triggerRate > 0.0 || multiplierTilt != 0.0 || controlVariate; }
+};
+
+// When an adaptive run stops: once the RTP confidence interval is narrow enough, checked at
+// every batch boundary after minTrials, or at maxTrials
+struct StoppingRule {
+    double halfWidth = 0.0005;          // Target half-width in RTP (0.0005 = +-0.05% RTP)
+    double confidence = 0.99;
+    uint64_t minTrials = 1 << 20;
+    uint64_t maxTrials = 1ULL << 36;
+
+    // Two-sided normal quantile of the confidence level
+    double zScore() const;
+};
+
+// Resumable, mergeable progress of a run over batches [firstBatch, nextBatch). Batches fold
+// into blocks of BLOCK_BATCHES (block k covers batches [k * BLOCK_BATCHES, (k + 1) * BLOCK_BATCHES))
+// and complete blocks fold in order into the total. Because that merge order is fixed by batch
+// indices alone, a run saved and resumed, or split into block-aligned shards whose states are
+// merged in order, reproduces an uninterrupted run bit for bit. Batch b's RNG stream is a pure
+// function of (seed, b), so nextBatch is the whole RNG position.
+struct SimulationState {
+    static constexpr uint64_t BLOCK_BATCHES = 64;
+
+    uint64_t fingerprint = 0;             // SessionSimulator::fingerprint of the run
+    uint64_t firstBatch = 0, nextBatch = 0;
+    std::vector<SimulationStats> blocks;  // Complete blocks, in order
+    SimulationStats partial;              // Batches after the last complete block
+
+    void add(const SimulationStats& batch);        // Appends batch nextBatch
+    void merge(const SimulationState& next);       // Appends a state starting at nextBatch
+    SimulationStats total() const;
+    uint64_t trials() const { return total().trials; }
+
+    // Compact binary checkpoint (see Checkpoint.h); load throws unless the file was saved
+    // under `fingerprint`
+    void save(const std::string& path) const;
+    static SimulationState load(const std::string& path, uint64_t fingerprint);
+
+private:
+    SimulationStats folded_;              // blocks merged in order
+};
+
+struct SimulationRun {
+    SimulationStats stats;
+    bool converged = false;             // Half-width target reached before maxTrials
+    double halfWidth = 0.0;             // Achieved, in RTP
+};
+
+// Monte Carlo over the SS02 session structure, driven by the same ScriptOutcomeCache as
+// SS02AnalyticRtp: scripts are drawn uniformly per section, free games retrigger with
+// fgRetrigger per spin, and free or buy_free scripts with MULTIPLIER cells draw from their
+// multiplier table.
+//
+// Trials are grouped in batches of BATCH; batch b always uses the RNG stream
+// mixSeed(seed, b) and batches are merged in index order, so a run's result depends only on
+// the seed and trial count, never on the thread count. Adaptive runs test the stopping rule
+// on that same in-order prefix: the result of a run that stops after k batches equals a fixed
+// run of k * BATCH trials.
+class SessionSimulator {
+public:
+    static constexpr uint64_t BATCH = 1 << 16;
+
+    SessionSimulator(const ScriptOutcomeCache& cache, const RtpParameters& params, const VarianceReduction& reduction = {})
+        : SessionSimulator(cache.view(), params, reduction) {}
+    // The outcomes must outlive the simulator (e.g. a mapped OutcomeFile shared by worker processes)
+    SessionSimulator(const ScriptOutcomeView& outcomes, const RtpParameters& params, const VarianceReduction& reduction = {});
+
+    SimulationStats run(SimulationMode mode, uint64_t trials, uint64_t seed, unsigned threads) const;
+
+    // Workers simulate batches ahead while the calling thread merges finished batches in order
+    // and stops them as soon as the merged prefix meets `rule`
+    SimulationRun runUntil(SimulationMode mode, const StoppingRule& rule, uint64_t seed, unsigned threads) const;
+
+    // Continues `state` from state.nextBatch (a fresh state may start at any block-aligned
+    // firstBatch, which is how shards are run). `checkpoint` is called with the state after
+    // every merged batch. An adaptive run resumed from a saved state stops exactly where the
+    // uninterrupted run would have.
+    SimulationRun runUntil(SimulationMode mode, const StoppingRule& rule, uint64_t seed, unsigned threads,
+                           SimulationState& state,
+                           const std::function<void(const SimulationState&)>& checkpoint = {}) const;
+
+    // Trials [batch * BATCH, min(trials, (batch + 1) * BATCH)) of a run
+    SimulationStats runBatch(SimulationMode mode, uint64_t batch, uint64_t trials, uint64_t seed) const;
+
+    double stake(SimulationMode mode) const;
+
+    // Hash of everything a run's batches depend on: scripts, parameters, multiplier tables,
+    // variance reduction, mode and seed
+    uint64_t fingerprint(SimulationMode mode, uint64_t seed) const;
+
+private:
+    struct Table {
+        std::vector<double> cumulative;   // Cumulative sampling weights (tilted if multiplierTilt != 0)
+        std::vector<int> offsets;         // multiplier - 100
+        std::vector<double> likelihood;   // Table probability / sampling probability per entry
+    };
+    struct Session {
+        double win = 0.0;
+        double estimate = 0.0;            // Sum of free spin wins times their own likelihood ratios
+        double weight = 1.0;              // Likelihood ratio of the whole session
+    };
+
+    // Spins are drawn from `scripts` (the free or the buy_free outcomes)
+    Session session(std::mt19937_64& rng, const ScriptOutcomeSpan& scripts) const;
+    double freeSpin(std::mt19937_64& rng, const ScriptOutcomeSpan& scripts, double& weight) const;
+
+    ScriptOutcomeView outcomes_;
+    RtpParameters params_;
+    VarianceReduction reduction_;
+    std::vector<Table> tables_;   // Indexed by table id
+    double baseMean_ = 0.0;       // Exact mean for the control variate
+};
@@ -0,0 +1,94 @@
+#include "SS02Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+// Batch (lockstep SIMD) evaluation of an SS02 script file.
+// Every script is evaluated by both SlotSS02::steps and SS02BatchEvaluator,
+// results are cross-checked and throughput of both paths is reported.
+
+static int checkScriptSet(const std::map<int, ScriptApp::ScriptData>& scripts,
+                          const std::string& scriptType,
+                          const std::string& gameType) {
+    std::cout << "\n============================================\n";
+    std::cout << "***** BATCH EVALUATION: " << scriptType << " SCRIPTS *****\n";
+    std::cout << "============================================\n";
+    std::cout << "Total " << scriptType << " scripts: " << scripts.size() << "\n";
+    if (scripts.empty()) {
+        return 0;
+    }
+
+    SlotSS02 game(true, 20.0f, gameType);
+    SS02BatchEvaluator batch(game);
+
+    std::vector<int> indices;
+    std::vector<const std::vector<Board>*> boards;
+    std::vector<int> specialMultipliers;
+    for (const auto& [index, scriptData] : scripts) {
+        indices.push_back(index);
+        boards.push_back(&scriptData.script);
+        specialMultipliers.push_back(scriptData.special_multipliers);
+    }
+
+    // Reference: one script at a time through steps()
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::tuple<int, int, bool>> reference;
+    reference.reserve(scripts.size());
+    for (const auto& [index, scriptData] : scripts) {
+        auto [final_board, total_score, actual_stop, patterns, boards_match] = game.steps(scriptData.script, scriptData.special_multipliers);
+        reference.emplace_back(static_cast<int>(total_score), actual_stop, boards_match);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Batch: all scripts in lockstep blocks
+    std::vector<BatchScriptResult> results = batch.evaluate(boards, specialMultipliers);
+    auto t2 = std::chrono::steady_clock::now();
+
+    int mismatches = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& [score, stop, match] = reference[i];
+        const auto& r = results[i];
+        if (r.score != score || r.stop != stop || r.cascade_match != match) {
+            if (mismatches < 5) {
+                std::cout << "❌ Script " << indices[i] << ": steps() score=" << score << " stop=" << stop
+                          << " cascade=" << match << " | batch score=" << r.score << " stop=" << r.stop
+                          << " cascade=" << r.cascade_match << "\n";
+            }
+            mismatches++;
+        }
+    }
+
+    double stepsSeconds = std::chrono::duration<double>(t1 - t0).count();
+    double batchSeconds = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "steps() time: " << std::fixed << std::setprecision(3) << stepsSeconds * 1000.0 << " ms ("
+              << std::setprecision(0) << scripts.size() / stepsSeconds << " scripts/s)\n";
+    std::cout << "Batch time:   " << std::fixed << std::setprecision(3) << batchSeconds * 1000.0 << " ms ("
+              << std::setprecision(0) << scripts.size() / batchSeconds << " scripts/s)\n";
+
+    if (mismatches == 0) {
+        std::cout << "✅ Batch results match steps() for all " << scripts.size() << " scripts\n";
+    } else {
+        std::cout << "❌ " << mismatches << " scripts differ between batch and steps()\n";
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    std::string inputFile = argc > 1 ? argv[1] : "SS02_scripts.json";
+    std::cout << "=== SS02 Batch Evaluator (" << SS02BatchEvaluator::isa_name() << ", "
+              << SS02BatchEvaluator::LANES << " lanes) ===\n";
+
+    try {
+        auto config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
+        int mismatches = 0;
+        mismatches += checkScriptSet(config.base_scripts, "BASE", "base");
+        mismatches += checkScriptSet(config.free_scripts, "FREE", "free");
+        return mismatches == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
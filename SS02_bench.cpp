@@ -0,0 +1,362 @@
+#include "SS02Pay.hpp"
+#include "SS03Pay.hpp"
+#include "ScriptConfig.h"
+#include "BoardAnalyzer.h"
+#include "ReelConverter.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <filesystem>
+#include <cstdio>
+#include <sstream>
+
+// Benchmark suite for the cascade engine (SS02 and SS03).
+//
+// Every benchmark runs one pass over its corpus per iteration: find_matches,
+// eliminate_matches, apply_gravity and get_score over the boards of every cascade step,
+// steps() over whole scripts, findBoardOverlap over the column pairs of the smart reel
+// conversion, plus ScriptConfig::loadFromFile and BoardAnalyzer::exportResultsToJson.
+// Corpora: SS02_scripts.json and the board-format files in FG_hist/ (SS02), majiang_222.json
+// (SS03). Each benchmark is repeated and the median pass time is reported with the spread
+// across repetitions, so runs can be compared over time.
+
+namespace {
+
+struct BenchCase {
+    std::string name;
+    double scripts = 0.0;       // Scripts covered by one pass
+    double bytes = 0.0;         // Bytes processed by one pass (0 = not meaningful)
+    std::function<long long()> run;
+};
+
+struct BenchResult {
+    std::string name;
+    long long passes = 0;
+    double medianSeconds = 0.0;
+    double spread = 0.0;        // (max - min) / median over repetitions
+    double scriptsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+};
+
+volatile long long g_sink = 0;  // Keeps results observable so passes are not optimized away
+
+BenchResult runCase(const BenchCase& bench, double minTime, int repetitions) {
+    using Clock = std::chrono::steady_clock;
+    g_sink = g_sink + bench.run();  // Warm-up
+
+    // Calibrate the number of passes per repetition to take at least minTime
+    long long passes = 1;
+    for (;;) {
+        auto start = Clock::now();
+        for (long long i = 0; i < passes; ++i) g_sink = g_sink + bench.run();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minTime || passes >= (1LL << 30)) break;
+        passes = seconds <= 0.0 ? passes * 10 : std::max(passes + 1, static_cast<long long>(passes * minTime * 1.2 / seconds));
+    }
+
+    std::vector<double> perPass;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = Clock::now();
+        for (long long i = 0; i < passes; ++i) g_sink = g_sink + bench.run();
+        perPass.push_back(std::chrono::duration<double>(Clock::now() - start).count() / static_cast<double>(passes));
+    }
+    std::sort(perPass.begin(), perPass.end());
+
+    BenchResult result;
+    result.name = bench.name;
+    result.passes = passes;
+    result.medianSeconds = perPass[perPass.size() / 2];
+    result.spread = result.medianSeconds > 0.0 ? (perPass.back() - perPass.front()) / result.medianSeconds : 0.0;
+    result.scriptsPerSecond = result.medianSeconds > 0.0 ? bench.scripts / result.medianSeconds : 0.0;
+    result.bytesPerSecond = result.medianSeconds > 0.0 ? bench.bytes / result.medianSeconds : 0.0;
+    return result;
+}
+
+// steps() differs between the games
+auto runSteps(SlotSS02& game, const ScriptApp::ScriptData& s) { return game.steps(s.script, s.special_multipliers); }
+auto runSteps(SlotSS03& game, const ScriptApp::ScriptData& s) { return game.steps(s.script); }
+
+// Inputs of every engine call made while evaluating one section of a corpus
+template <typename Game>
+struct SectionTrace {
+    std::shared_ptr<Game> game;
+    std::shared_ptr<const ScriptApp::ScriptConfig> config;   // Owns the scripts below
+    std::vector<const ScriptApp::ScriptData*> scripts;
+    std::vector<Board> matchBoards;                  // Boards find_matches is called on
+    std::vector<MatchPatterns> patterns;             // Their matches
+    std::vector<Board> eliminated;                   // Boards after eliminate_matches
+    struct ColumnPair { std::vector<int> previous, current; size_t patternIndex; int col; };
+    std::vector<ColumnPair> columns;                 // findBoardOverlap inputs
+};
+
+template <typename Game>
+SectionTrace<Game> traceSection(const std::map<int, ScriptApp::ScriptData>& scripts, const std::string& gameType) {
+    SectionTrace<Game> trace;
+    trace.game = std::make_shared<Game>(true, 20.0f, gameType);
+    Game& game = *trace.game;
+    for (const auto& [index, scriptData] : scripts) {
+        if (scriptData.script.empty()) continue;
+        try {
+            auto [final_board, total_score, actual_stop, stepPatterns, boards_match] = runSteps(game, scriptData);
+            trace.scripts.push_back(&scriptData);
+            size_t firstPattern = trace.patterns.size();
+            for (size_t step = 0; step < stepPatterns.size(); ++step) {
+                const Board& board = scriptData.script[step];
+                trace.matchBoards.push_back(board);
+                trace.patterns.push_back(stepPatterns[step]);
+                trace.eliminated.push_back(game.eliminate_matches(board, stepPatterns[step]));
+            }
+            const int width = static_cast<int>(scriptData.script[0][0].size());
+            for (size_t b = 1; b < scriptData.script.size(); ++b) {
+                for (int col = 0; col < width; ++col) {
+                    trace.columns.push_back({ReelConverter::boardColumn(scriptData.script[b - 1], col),
+                                             ReelConverter::boardColumn(scriptData.script[b], col),
+                                             b - 1 < stepPatterns.size() ? firstPattern + b - 1 : SIZE_MAX, col});
+                }
+            }
+        } catch (const std::exception&) {
+            // Boards the engine rejects are not part of the corpus
+        }
+    }
+    return trace;
+}
+
+template <typename Game>
+void addEngineCases(std::vector<BenchCase>& cases, const std::string& prefix, const std::string& section,
+                    const std::shared_ptr<SectionTrace<Game>>& t) {
+    if (t->scripts.empty()) return;
+    const double scripts = static_cast<double>(t->scripts.size());
+    const std::string name = prefix + "/" + section + "/";
+    cases.push_back({name + "find_matches", scripts, 0.0, [t]() {
+        long long sum = 0;
+        for (const auto& board : t->matchBoards) sum += t->game->find_matches(board).first.size();
+        return sum;
+    }});
+    cases.push_back({name + "eliminate_matches", scripts, 0.0, [t]() {
+        long long sum = 0;
+        for (size_t i = 0; i < t->matchBoards.size(); ++i) sum += t->game->eliminate_matches(t->matchBoards[i], t->patterns[i]).size();
+        return sum;
+    }});
+    cases.push_back({name + "apply_gravity", scripts, 0.0, [t]() {
+        long long sum = 0;
+        for (const auto& board : t->eliminated) sum += t->game->apply_gravity(board)[0][0];
+        return sum;
+    }});
+    cases.push_back({name + "get_score", scripts, 0.0, [t]() {
+        double sum = 0.0;
+        for (const auto& patterns : t->patterns) sum += t->game->get_score(patterns);
+        return static_cast<long long>(sum);
+    }});
+    cases.push_back({name + "steps", scripts, 0.0, [t]() {
+        long long sum = 0;
+        for (const auto* s : t->scripts) sum += static_cast<long long>(std::get<1>(runSteps(*t->game, *s)));
+        return sum;
+    }});
+    cases.push_back({name + "findBoardOverlap", scripts, 0.0, [t]() {
+        static const MatchPatterns none;
+        long long sum = 0;
+        for (const auto& c : t->columns) {
+            const MatchPatterns& patterns = c.patternIndex < t->patterns.size() ? t->patterns[c.patternIndex] : none;
+            sum += ReelConverter::findBoardOverlap(c.previous, c.current, patterns, c.col);
+        }
+        return sum;
+    }});
+}
+
+// Returns false for files without board-format scripts
+template <typename Game>
+bool addCorpusCases(std::vector<BenchCase>& cases, const std::string& prefix, const std::string& path) {
+    const double bytes = static_cast<double>(std::filesystem::file_size(path));
+    auto config = std::make_shared<ScriptApp::ScriptConfig>(ScriptApp::ScriptConfig::loadFromFile(path));
+    const double scripts = static_cast<double>(config->base_scripts.size() + config->free_scripts.size());
+    if (scripts == 0.0) return false;
+    const std::string file = std::filesystem::path(path).filename().string();
+    std::cout << "  " << prefix << " " << file << ": " << config->base_scripts.size() << " base, "
+              << config->free_scripts.size() << " free, " << std::fixed << std::setprecision(2)
+              << bytes / (1024.0 * 1024.0) << " MB\n";
+
+    cases.push_back({prefix + "/" + file + "/loadFromFile", scripts, bytes, [path]() {
+        auto loaded = ScriptApp::ScriptConfig::loadFromFile(path);
+        return static_cast<long long>(loaded.base_scripts.size() + loaded.free_scripts.size());
+    }});
+
+    auto base = std::make_shared<SectionTrace<Game>>(traceSection<Game>(config->base_scripts, "base"));
+    auto free = std::make_shared<SectionTrace<Game>>(traceSection<Game>(config->free_scripts, "free"));
+    base->config = config;
+    free->config = config;
+    addEngineCases<Game>(cases, prefix + "/" + file, "base", base);
+    addEngineCases<Game>(cases, prefix + "/" + file, "free", free);
+
+    // Results export as done by the test programs, to a scratch file
+    auto context = std::make_shared<AnalysisContext>();
+    double baseTotal = 0.0, freeTotal = 0.0;
+    for (auto* trace : {base.get(), free.get()}) {
+        for (const auto* s : trace->scripts) {
+            auto [final_board, total_score, actual_stop, patterns, boards_match] = runSteps(*trace->game, *s);
+            (trace == base.get() ? baseTotal : freeTotal) += total_score;
+            context->allResults.push_back({0, static_cast<double>(s->payout), static_cast<double>(total_score),
+                                           s->stop, actual_stop, false, false, !boards_match, {}});
+        }
+    }
+    const std::string scratch = "bench_export.tmp.json";
+    const size_t baseCount = base->scripts.size(), freeCount = free->scripts.size();
+    auto exportResults = [context, scratch, baseCount, freeCount, baseTotal, freeTotal]() {
+        // exportResultsToJson reports to stdout; keep the benchmark table readable
+        std::ostringstream discard;
+        std::streambuf* out = std::cout.rdbuf(discard.rdbuf());
+        BoardAnalyzer::exportResultsToJson(scratch, baseCount, freeCount, baseTotal, baseTotal,
+                                           freeTotal, freeTotal, 0.005, *context);
+        std::cout.rdbuf(out);
+        return static_cast<long long>(std::filesystem::file_size(scratch));
+    };
+    const double exportBytes = static_cast<double>(exportResults());
+    cases.push_back({prefix + "/" + file + "/exportResultsToJson", scripts, exportBytes, exportResults});
+    return true;
+}
+
+std::string formatRate(double value) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (value >= 1e9) oss << value / 1e9 << "G";
+    else if (value >= 1e6) oss << value / 1e6 << "M";
+    else if (value >= 1e3) oss << value / 1e3 << "k";
+    else oss << value;
+    return oss.str();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string corpusDir = ".";
+    std::string filter;
+    std::string jsonFile;
+    double minTime = 0.2;
+    int repetitions = 5;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--corpus" && i + 1 < argc) {
+            corpusDir = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::stod(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cerr << "Usage: SS02_bench [--corpus DIR] [--filter SUBSTRING] [--min-time SECONDS]"
+                         " [--repetitions N] [--json results.json] [--list]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02/SS03 Cascade Engine Benchmark ===\n\n";
+
+    try {
+        namespace fs = std::filesystem;
+        std::vector<BenchCase> cases;
+        std::cout << "Corpus:\n";
+
+        // SS02: the main script file plus the board-format histories in FG_hist/
+        // (reel-format files there are converter output and are skipped)
+        std::vector<std::string> ss02Files;
+        if (fs::exists(fs::path(corpusDir) / "SS02_scripts.json")) {
+            ss02Files.push_back((fs::path(corpusDir) / "SS02_scripts.json").string());
+        }
+        if (fs::is_directory(fs::path(corpusDir) / "FG_hist")) {
+            std::vector<std::string> history;
+            for (const auto& entry : fs::directory_iterator(fs::path(corpusDir) / "FG_hist")) {
+                if (entry.path().extension() == ".json") history.push_back(entry.path().string());
+            }
+            std::sort(history.begin(), history.end());
+            ss02Files.insert(ss02Files.end(), history.begin(), history.end());
+        }
+        int skipped = 0;
+        for (const auto& path : ss02Files) {
+            try {
+                if (!addCorpusCases<SlotSS02>(cases, "SS02", path)) skipped++;
+            } catch (const std::exception&) {
+                skipped++;
+            }
+        }
+        if (skipped > 0) {
+            std::cout << "  (" << skipped << " reel-format or unreadable files skipped)\n";
+        }
+
+        const fs::path ss03File = fs::path(corpusDir) / "majiang_222.json";
+        if (!fs::exists(ss03File) || !addCorpusCases<SlotSS03>(cases, "SS03", ss03File.string())) {
+            std::cout << "⚠️  " << ss03File.string() << " has no SS03 scripts, SS03 benchmarks skipped\n";
+        }
+        if (cases.empty()) {
+            throw std::runtime_error("No corpus files found in " + corpusDir);
+        }
+
+        if (!filter.empty()) {
+            cases.erase(std::remove_if(cases.begin(), cases.end(),
+                                       [&](const BenchCase& c) { return c.name.find(filter) == std::string::npos; }),
+                        cases.end());
+        }
+        if (list) {
+            for (const auto& c : cases) std::cout << c.name << "\n";
+            return 0;
+        }
+
+        std::cout << "\n" << cases.size() << " benchmarks, " << repetitions << " repetitions of >= "
+                  << std::setprecision(2) << minTime << " s each\n\n";
+        std::cout << std::left << std::setw(58) << "Benchmark" << std::right << std::setw(10) << "Passes"
+                  << std::setw(12) << "ms/pass" << std::setw(8) << "+/-%" << std::setw(12) << "scripts/s"
+                  << std::setw(10) << "MB/s" << "\n";
+
+        std::vector<BenchResult> results;
+        for (const auto& bench : cases) {
+            BenchResult r = runCase(bench, minTime, repetitions);
+            results.push_back(r);
+            std::cout << std::left << std::setw(58) << r.name << std::right << std::setw(10) << r.passes
+                      << std::setw(12) << std::fixed << std::setprecision(3) << r.medianSeconds * 1000.0
+                      << std::setw(8) << std::setprecision(1) << r.spread * 100.0
+                      << std::setw(12) << formatRate(r.scriptsPerSecond);
+            if (r.bytesPerSecond > 0.0) {
+                std::cout << std::setw(10) << std::setprecision(1) << r.bytesPerSecond / (1024.0 * 1024.0);
+            }
+            std::cout << "\n";
+        }
+        std::remove("bench_export.tmp.json");
+
+        if (!jsonFile.empty()) {
+            nlohmann::json output;
+            output["min_time"] = minTime;
+            output["repetitions"] = repetitions;
+            output["benchmarks"] = nlohmann::json::array();
+            for (const auto& r : results) {
+                output["benchmarks"].push_back({
+                    {"name", r.name},
+                    {"passes", r.passes},
+                    {"seconds_per_pass", r.medianSeconds},
+                    {"spread", r.spread},
+                    {"scripts_per_second", r.scriptsPerSecond},
+                    {"bytes_per_second", r.bytesPerSecond}
+                });
+            }
+            std::ofstream outFile(jsonFile);
+            if (!outFile.is_open()) {
+                throw std::runtime_error("Cannot write to " + jsonFile);
+            }
+            outFile << output.dump(2) << "\n";
+            std::cout << "\n✅ Results written to " << jsonFile << "\n";
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
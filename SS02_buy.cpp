@@ -0,0 +1,191 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "SS02Simulator.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+// Buy feature RTP: the player pays buyCost bets for one free game session whose spins are
+// drawn from the "buy_free" section of Insert_Script.json (the free scripts when there is
+// none). buy_free spins are free game spins - MULTIPLIER cells draw from their multiple_table -
+// and retrigger like any free spin. The exact RTP, variance and win distribution come from
+// SS02AnalyticRtp; a multithreaded session simulation over the same ScriptOutcomeCache
+// cross-checks them.
+
+namespace {
+
+std::string bucketLabel(size_t i) {
+    const auto& edges = SimulationStats::RATIO_EDGES;
+    std::ostringstream label;
+    if (i == 0) {
+        label << "< " << edges[0] << "x";
+    } else if (i == edges.size()) {
+        label << ">= " << edges.back() << "x";
+    } else {
+        label << edges[i - 1] << "x - " << edges[i] << "x";
+    }
+    return label.str();
+}
+
+// Mass of the exact distribution per win / stake bucket
+std::array<double, SimulationStats::BUCKETS> exactBuckets(const PayoutDistribution& d, double stake) {
+    std::array<double, SimulationStats::BUCKETS> buckets{};
+    for (size_t i = 0; i < d.pmf.size(); ++i) {
+        buckets[SimulationStats::bucket(static_cast<double>(i) * d.binWidth / stake)] += d.pmf[i];
+    }
+    return buckets;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string outputFile = "SS02_buy.json";
+    std::string tableFile;
+    double cost = -1.0;
+    uint64_t sessions = 1000000;
+    uint64_t seed = 12345;
+    size_t gridSize = 1 << 16;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters params = RtpParameters::fromGame(game);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cost" && i + 1 < argc) {
+            cost = std::stod(argv[++i]);
+        } else if (arg == "--retrigger" && i + 1 < argc) {
+            params.fgRetrigger = std::stod(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            params.fgRounds = std::stoi(argv[++i]);
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            params.volatility = argv[++i];
+        } else if (arg == "--multiplier-table" && i + 1 < argc) {
+            tableFile = argv[++i];
+        } else if (arg == "--bet" && i + 1 < argc) {
+            params.bet = std::stod(argv[++i]);
+        } else if (arg == "--sessions" && i + 1 < argc) {
+            sessions = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--grid" && i + 1 < argc) {
+            gridSize = std::stoul(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_buy [scripts.json|Insert_Script.json] [--cost BETS] [--retrigger P] [--rounds N]"
+                         " [--volatility low|high] [--multiplier-table FILE] [--bet B] [--sessions N] [--seed N]"
+                         " [--threads N] [--grid N] [-o output.json]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Buy Feature RTP ===\n\n";
+
+    try {
+        auto config = loadSS02Scripts(scriptsFile);
+        params.buyCost = cost > 0.0 ? cost : config.buy_free_game_multiplier;
+        if (!tableFile.empty()) {
+            std::ifstream file(tableFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open " + tableFile);
+            }
+            file >> params.multiplierTable;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+        RtpReport report = SS02AnalyticRtp(cache).solve(params, std::max<size_t>(gridSize, 2));
+        double solveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const double stake = params.buyCost * params.bet;
+
+        std::cout << "Scripts: " << cache.free.size() << " free, " << cache.buy.size() << " buy_free"
+                  << (cache.buy.empty() ? " (bought sessions play the free scripts)" : "") << "\n";
+        std::cout << "Cost: " << std::fixed << std::setprecision(0) << params.buyCost << "x bet (" << stake << ")"
+                  << ", retrigger " << std::setprecision(4) << params.fgRetrigger << ", rounds " << params.fgRounds
+                  << ", multipliers " << (tableFile.empty() ? params.volatility : tableFile) << "\n\n";
+
+        std::cout << "Exact (" << std::setprecision(1) << solveMs << " ms):\n" << std::setprecision(4)
+                  << "  Spin mean:         " << report.buySpinMean << " (" << report.sessionLengthMean
+                  << " spins per session)\n"
+                  << "  Feature win mean:  " << report.buyMean << " (" << report.buyMean / stake << "x cost)\n"
+                  << "  Feature std dev:   " << std::sqrt(report.buyVariance) << " ("
+                  << std::sqrt(report.buyVariance) / stake << "x cost)\n"
+                  << "  P(win >= cost):    " << report.buy.exceedance(stake) << "\n"
+                  << "  Buy RTP:           " << std::setprecision(6) << report.buyRtp << "\n\n";
+
+        const auto exact = exactBuckets(report.buy, stake);
+        SimulationStats sim;
+        double simMs = 0.0;
+        int failed = 0;
+        if (sessions > 0) {
+            start = std::chrono::steady_clock::now();
+            sim = SessionSimulator(cache, params).run(SimulationMode::Buy, sessions, seed, threads);
+            simMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            const double se = std::sqrt(sim.variance() / static_cast<double>(sim.trials));
+            std::cout << "Simulated " << sim.trials << " buys in " << std::setprecision(1) << simMs << " ms (" << threads
+                      << " threads, " << std::setprecision(0) << sim.trials / (simMs / 1000.0) << " buys/s):\n"
+                      << std::setprecision(4) << "  Feature win mean:  " << sim.mean << " +- " << se << "\n"
+                      << "  Feature std dev:   " << std::sqrt(sim.variance()) << "\n"
+                      << "  Max win:           " << sim.maxWin << " (" << sim.maxWin / stake << "x cost)\n"
+                      << "  Buy RTP:           " << std::setprecision(6) << sim.mean / stake << " +- " << se / stake << "\n";
+            if (std::abs(sim.mean - report.buyMean) <= 4.0 * se + 1e-9) {
+                std::cout << "✅ Simulation agrees with the exact buy RTP within 4 standard errors\n\n";
+            } else {
+                std::cout << "❌ Simulation differs from the exact buy RTP by more than 4 standard errors\n\n";
+                failed = 1;
+            }
+        }
+
+        std::cout << "Feature win / cost:\n" << std::left << std::setw(16) << "  Bucket" << std::right << std::setw(12)
+                  << "Exact" << std::setw(12) << "Simulated" << "\n";
+        for (size_t i = 0; i < SimulationStats::BUCKETS; ++i) {
+            std::cout << "  " << std::left << std::setw(14) << bucketLabel(i) << std::right << std::setprecision(6)
+                      << std::setw(12) << exact[i];
+            if (sim.trials > 0) std::cout << std::setw(12) << static_cast<double>(sim.histogram[i]) / sim.trials;
+            std::cout << "\n";
+        }
+
+        nlohmann::json out;
+        out["scripts_file"] = scriptsFile;
+        out["parameters"] = {{"bet", params.bet}, {"buy_cost", params.buyCost}, {"fg_retrigger", params.fgRetrigger},
+                             {"fg_rounds", params.fgRounds}, {"volatility", params.volatility},
+                             {"multiplier_table", tableFile}};
+        out["exact"] = {{"spin_mean", report.buySpinMean}, {"mean", report.buyMean},
+                        {"variance", report.buyVariance}, {"rtp", report.buyRtp},
+                        {"p_win_at_least_cost", report.buy.exceedance(stake)}};
+        nlohmann::json buckets = nlohmann::json::array();
+        for (size_t i = 0; i < SimulationStats::BUCKETS; ++i) {
+            nlohmann::json b = {{"bucket", bucketLabel(i)}, {"exact", exact[i]}};
+            if (sim.trials > 0) b["simulated"] = static_cast<double>(sim.histogram[i]) / sim.trials;
+            buckets.push_back(b);
+        }
+        out["win_over_cost"] = buckets;
+        if (sim.trials > 0) {
+            out["simulated"] = {{"buys", sim.trials}, {"seed", seed}, {"mean", sim.mean}, {"variance", sim.variance()},
+                                {"rtp", sim.mean / stake}, {"max_win", sim.maxWin}};
+        }
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        file << out.dump(2) << "\n";
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return failed;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
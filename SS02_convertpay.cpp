@@ -1,175 +1,115 @@
 #include "ScriptConfig.h"
 #include "SS02Pay.hpp"
+#define SS02_INSTRUMENT_MAIN
+#include "Instrumentation.h"
+#include "ReelConverter.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <random>
 #include <algorithm>
 #include <set>
+#include <map>
+#include <tuple>
+#include <chrono>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
 
-// Function to find overlap using subsequence matching
-// Finds longest consecutive prefix of currentBoard that appears as a subsequence in previousBoard
-// Does not allow prefix to end with eliminated symbols
-int findBoardOverlap(const std::vector<int>& previousBoard, const std::vector<int>& currentBoard, 
-                     const MatchPatterns& eliminationPatterns, int currentCol) {
-    int maxOverlap = 0;
-    
-    // Try all possible prefix lengths of currentBoard (from longest to shortest)
-    for (int prefixLen = static_cast<int>(currentBoard.size()); prefixLen >= 1; --prefixLen) {
-        
-        // Check if the last symbol of this prefix is an eliminated symbol
-        bool endsWithEliminatedSymbol = false;
-        int lastSymbol = currentBoard[prefixLen - 1];
-        
-        for (const auto& [symbol, positions] : eliminationPatterns) {
-            for (const auto& [row, col] : positions) {
-                if (col == currentCol && symbol == lastSymbol) {
-                    endsWithEliminatedSymbol = true;
-                    break;
-                }
-            }
-            if (endsWithEliminatedSymbol) break;
-        }
-        
-        // Skip this prefix if it ends with an eliminated symbol
-        if (endsWithEliminatedSymbol) {
-            continue;
-        }
-        
-        // Check if this prefix exists as a subsequence in previousBoard
-        int prevIndex = 0;
-        int matchCount = 0;
-        
-        for (int currIndex = 0; currIndex < prefixLen; ++currIndex) {
-            // Look for currentBoard[currIndex] in previousBoard starting from prevIndex
-            while (prevIndex < static_cast<int>(previousBoard.size()) && 
-                   previousBoard[prevIndex] != currentBoard[currIndex]) {
-                prevIndex++;
-            }
-            
-            if (prevIndex < static_cast<int>(previousBoard.size())) {
-                // Found a match
-                matchCount++;
-                prevIndex++; // Move to next position for next search
-            } else {
-                // No match found for this element
-                break;
-            }
+// One entry of a converted base/free array, in the layout of the backend's Insert_Script.json.
+// `stop` overrides the per-reel stop (the simple conversion reports boards * 5).
+std::string formatReelEntry(int index, const ScriptApp::ScriptData& scriptData,
+                            const std::vector<std::vector<int>>& reels, int stop = -1) {
+    std::ostringstream out;
+    out << "    {\n      \"number\": " << index << ",\n      \"stopover\": " << scriptData.stop;
+    if (scriptData.is_free) {
+        // Add multiple_table field for free section scripts
+        out << ",\n      \"multiple_table\": " << scriptData.multiple_table;
+    }
+    out << ",\n      \"script\": [\n";
+    for (size_t col = 0; col < reels.size(); ++col) {
+        if (col > 0) out << ",\n";
+        out << "        {\n          \"index\": " << col << ",\n";
+        out << "          \"stop\": " << (stop >= 0 ? stop : static_cast<int>(reels[col].size()))
+            << ",\n          \"reel\": [";
+        for (size_t i = 0; i < reels[col].size(); ++i) {
+            if (i > 0) out << ", ";
+            out << reels[col][i];
         }
-        
-        // If all elements in the prefix were found as a subsequence
-        if (matchCount == prefixLen) {
-            maxOverlap = prefixLen;
-            return maxOverlap; // Return the first (longest) match found
+        out << "]\n        }";
+    }
+    out << "\n      ]\n    }";
+    return out.str();
+}
+
+// Simple conversion: every board column stacked bottom-up, boards one after another
+std::string simpleEntry(int index, const ScriptApp::ScriptData& scriptData) {
+    std::vector<std::vector<int>> reels(6);
+    for (const auto& board : scriptData.script) {
+        for (int col = 0; col < 6; ++col) {
+            auto column = ReelConverter::boardColumn(board, col);
+            reels[col].insert(reels[col].end(), column.begin(), column.end());
         }
     }
-    
-    return maxOverlap;
+    return formatReelEntry(index, scriptData, reels, static_cast<int>(scriptData.script.size()) * 5);
+}
+
+// Smart conversion of one script; `game` must match the script's section
+std::string smartEntry(SlotSS02& game, int index, const ScriptApp::ScriptData& scriptData) {
+    auto [final_board, total_score, actual_stop, patterns, boards_match] = game.steps(scriptData.script, scriptData.special_multipliers);
+    return formatReelEntry(index, scriptData, ReelConverter::buildSmartReels(scriptData.script, patterns));
+}
+
+// `"base": [...]` / `"free": [...]` from formatted entries
+std::string formatSection(const std::string& name, const std::vector<std::string>& entries) {
+    std::string out = "\"" + name + "\": [\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i > 0) out += ",\n";
+        out += entries[i];
+    }
+    return out + "\n  ]";
+}
+
+// Converter output file: the base and free arrays without outer braces. Empty sections are left out.
+std::string formatConvertedFile(const std::vector<std::string>& base, const std::vector<std::string>& free) {
+    std::string out;
+    if (!base.empty()) out += "  " + formatSection("base", base);
+    if (!free.empty()) {
+        if (!base.empty()) out += ",\n";
+        out += "  " + formatSection("free", free);
+    }
+    return out;
 }
 
 // Function to convert source format to the new format
 void convertJsonFormat(const std::string& inputFile, const std::string& outputFile) {
     try {
-        auto config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
-        
-        std::ofstream outFile(outputFile);
-        
-        // Process base scripts
-        if (!config.base_scripts.empty()) {
-            SlotSS02 baseGame(true, 20.0f, "base"); // Use "base" game type
-            std::vector<std::tuple<int, std::vector<MatchPatterns>, int, float>> base_elimination_data;
-            
-            for (const auto& [index, scriptData] : config.base_scripts) {
-                auto [final_board, total_score, actual_stop, patterns, boards_match] = baseGame.steps(scriptData.script, scriptData.special_multipliers);
-                base_elimination_data.emplace_back(index, patterns, actual_stop, total_score);
-            }
-            
-            outFile << "  \"base\": [\n";
-            
-            bool isFirst = true;
-            for (const auto& [index, scriptData] : config.base_scripts) {
-                if (!isFirst) outFile << ",\n";
-                isFirst = false;
-                
-                outFile << "    {\n      \"number\": " << index << ",\n      \"stopover\": " << scriptData.stop;
-                outFile << ",\n      \"script\": [\n";
-                
-                for (int col = 0; col < 6; ++col) {
-                    if (col > 0) outFile << ",\n";
-                    outFile << "        {\n          \"index\": " << col << ",\n";
-                    
-                    int totalStops = scriptData.script.size() * 5;
-                    outFile << "          \"stop\": " << totalStops << ",\n          \"reel\": [";
-                    
-                    bool firstValue = true;
-                    for (const auto& board : scriptData.script) {
-                        for (int row = static_cast<int>(board.size()) - 1; row >= 0; --row) {
-                            if (board[row].size() > static_cast<size_t>(col)) {
-                                if (!firstValue) outFile << ", ";
-                                firstValue = false;
-                                outFile << board[row][col];
-                            }
-                        }
-                    }
-                    outFile << "]\n        }";
-                }
-                outFile << "\n      ]\n    }";
-            }
-            outFile << "\n  ]";
+        ScriptApp::ScriptConfig config;
+        {
+            Instrumentation::ScopedTimer timer("load");
+            config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
         }
+        Instrumentation::instance().counter("scripts") +=
+            static_cast<long long>(config.base_scripts.size() + config.free_scripts.size());
         
-        // Process free scripts
-        if (!config.free_scripts.empty()) {
-            if (!config.base_scripts.empty()) {
-                outFile << ",\n";
-            }
-            
-            SlotSS02 freeGame(true, 20.0f, "free"); // Use "free" game type
-            std::vector<std::tuple<int, std::vector<MatchPatterns>, int, float>> free_elimination_data;
-            
-            for (const auto& [index, scriptData] : config.free_scripts) {
-                auto [final_board, total_score, actual_stop, patterns, boards_match] = freeGame.steps(scriptData.script, scriptData.special_multipliers);
-                free_elimination_data.emplace_back(index, patterns, actual_stop, total_score);
-            }
-            
-            outFile << "  \"free\": [\n";
-            
-            bool isFirst = true;
-            for (const auto& [index, scriptData] : config.free_scripts) {
-                if (!isFirst) outFile << ",\n";
-                isFirst = false;
-                
-                outFile << "    {\n      \"number\": " << index << ",\n      \"stopover\": " << scriptData.stop;
-                
-                // Add multiple_table field for free section scripts
-                outFile << ",\n      \"multiple_table\": " << scriptData.multiple_table;
-                
-                outFile << ",\n      \"script\": [\n";
-                
-                for (int col = 0; col < 6; ++col) {
-                    if (col > 0) outFile << ",\n";
-                    outFile << "        {\n          \"index\": " << col << ",\n";
-                    
-                    int totalStops = scriptData.script.size() * 5;
-                    outFile << "          \"stop\": " << totalStops << ",\n          \"reel\": [";
-                    
-                    bool firstValue = true;
-                    for (const auto& board : scriptData.script) {
-                        for (int row = static_cast<int>(board.size()) - 1; row >= 0; --row) {
-                            if (board[row].size() > static_cast<size_t>(col)) {
-                                if (!firstValue) outFile << ", ";
-                                firstValue = false;
-                                outFile << board[row][col];
-                            }
-                        }
-                    }
-                    outFile << "]\n        }";
-                }
-                outFile << "\n      ]\n    }";
-            }
-            outFile << "\n  ]";
+        std::vector<std::string> base, free;
+        for (const auto& [index, scriptData] : config.base_scripts) {
+            base.push_back(simpleEntry(index, scriptData));
+        }
+        for (const auto& [index, scriptData] : config.free_scripts) {
+            free.push_back(simpleEntry(index, scriptData));
         }
         
+        std::ofstream outFile(outputFile);
+        outFile << formatConvertedFile(base, free);
         outFile.close();
         
     } catch (const std::exception& e) {
@@ -180,160 +120,30 @@ void convertJsonFormat(const std::string& inputFile, const std::string& outputFi
 // Smart conversion with board overlap detection
 void convertJsonFormatAdvanced(const std::string& inputFile, const std::string& outputFile) {
     try {
-        auto config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
-        
-        std::ofstream outFile(outputFile);
+        ScriptApp::ScriptConfig config;
+        {
+            Instrumentation::ScopedTimer timer("load");
+            config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
+        }
+        Instrumentation::instance().counter("scripts") +=
+            static_cast<long long>(config.base_scripts.size() + config.free_scripts.size());
         
-        // Process base scripts
+        std::vector<std::string> base, free;
         if (!config.base_scripts.empty()) {
             SlotSS02 baseGame(true, 20.0f, "base"); // Use "base" game type
-            std::map<int, std::vector<MatchPatterns>> base_elimination_data;
-            
             for (const auto& [index, scriptData] : config.base_scripts) {
-                auto [final_board, total_score, actual_stop, patterns, boards_match] = baseGame.steps(scriptData.script, scriptData.special_multipliers);
-                base_elimination_data[index] = patterns;
+                base.push_back(smartEntry(baseGame, index, scriptData));
             }
-            
-            outFile << "  \"base\": [\n";
-            
-            bool isFirst = true;
-            for (const auto& [index, scriptData] : config.base_scripts) {
-                if (!isFirst) outFile << ",\n";
-                isFirst = false;
-                
-                outFile << "    {\n      \"number\": " << index << ",\n      \"stopover\": " << scriptData.stop;
-                outFile << ",\n      \"script\": [\n";
-                
-                for (int col = 0; col < 6; ++col) {
-                    if (col > 0) outFile << ",\n";
-                    outFile << "        {\n          \"index\": " << col << ",\n";
-                    
-                    std::vector<int> finalReel;
-                    
-                    for (size_t boardIdx = 0; boardIdx < scriptData.script.size(); ++boardIdx) {
-                        const auto& board = scriptData.script[boardIdx];
-                        std::vector<int> currentBoardColumn;
-                        for (int row = static_cast<int>(board.size()) - 1; row >= 0; --row) {
-                            if (board[row].size() > static_cast<size_t>(col)) {
-                                currentBoardColumn.push_back(board[row][col]);
-                            }
-                        }
-                        
-                        if (boardIdx == 0) {
-                            finalReel.insert(finalReel.end(), currentBoardColumn.begin(), currentBoardColumn.end());
-                        } else {
-                            std::vector<int> previousBoardColumn;
-                            const auto& previousBoard = scriptData.script[boardIdx - 1];
-                            for (int row = static_cast<int>(previousBoard.size()) - 1; row >= 0; --row) {
-                                if (previousBoard[row].size() > static_cast<size_t>(col)) {
-                                    previousBoardColumn.push_back(previousBoard[row][col]);
-                                }
-                            }
-                            
-                            MatchPatterns eliminationPatterns;
-                            if (boardIdx - 1 < base_elimination_data[index].size()) {
-                                eliminationPatterns = base_elimination_data[index][boardIdx - 1];
-                            }
-                            
-                            int maxOverlap = findBoardOverlap(previousBoardColumn, currentBoardColumn, eliminationPatterns, col);
-                            
-                            for (size_t i = maxOverlap; i < currentBoardColumn.size(); ++i) {
-                                finalReel.push_back(currentBoardColumn[i]);
-                            }
-                        }
-                    }
-                    
-                    outFile << "          \"stop\": " << finalReel.size() << ",\n          \"reel\": [";
-                    for (size_t i = 0; i < finalReel.size(); ++i) {
-                        if (i > 0) outFile << ", ";
-                        outFile << finalReel[i];
-                    }
-                    outFile << "]\n        }";
-                }
-                outFile << "\n      ]\n    }";
-            }
-            outFile << "\n  ]";
         }
-        
-        // Process free scripts
         if (!config.free_scripts.empty()) {
-            if (!config.base_scripts.empty()) {
-                outFile << ",\n";
-            }
-            
             SlotSS02 freeGame(true, 20.0f, "free"); // Use "free" game type
-            std::map<int, std::vector<MatchPatterns>> free_elimination_data;
-            
             for (const auto& [index, scriptData] : config.free_scripts) {
-                auto [final_board, total_score, actual_stop, patterns, boards_match] = freeGame.steps(scriptData.script, scriptData.special_multipliers);
-                free_elimination_data[index] = patterns;
+                free.push_back(smartEntry(freeGame, index, scriptData));
             }
-            
-            outFile << "  \"free\": [\n";
-            
-            bool isFirst = true;
-            for (const auto& [index, scriptData] : config.free_scripts) {
-                if (!isFirst) outFile << ",\n";
-                isFirst = false;
-                
-                outFile << "    {\n      \"number\": " << index << ",\n      \"stopover\": " << scriptData.stop;
-                
-                // Add multiple_table field for free section scripts
-                outFile << ",\n      \"multiple_table\": " << scriptData.multiple_table;
-                
-                outFile << ",\n      \"script\": [\n";
-                
-                for (int col = 0; col < 6; ++col) {
-                    if (col > 0) outFile << ",\n";
-                    outFile << "        {\n          \"index\": " << col << ",\n";
-                    
-                    std::vector<int> finalReel;
-                    
-                    for (size_t boardIdx = 0; boardIdx < scriptData.script.size(); ++boardIdx) {
-                        const auto& board = scriptData.script[boardIdx];
-                        std::vector<int> currentBoardColumn;
-                        for (int row = static_cast<int>(board.size()) - 1; row >= 0; --row) {
-                            if (board[row].size() > static_cast<size_t>(col)) {
-                                currentBoardColumn.push_back(board[row][col]);
-                            }
-                        }
-                        
-                        if (boardIdx == 0) {
-                            finalReel.insert(finalReel.end(), currentBoardColumn.begin(), currentBoardColumn.end());
-                        } else {
-                            std::vector<int> previousBoardColumn;
-                            const auto& previousBoard = scriptData.script[boardIdx - 1];
-                            for (int row = static_cast<int>(previousBoard.size()) - 1; row >= 0; --row) {
-                                if (previousBoard[row].size() > static_cast<size_t>(col)) {
-                                    previousBoardColumn.push_back(previousBoard[row][col]);
-                                }
-                            }
-                            
-                            MatchPatterns eliminationPatterns;
-                            if (boardIdx - 1 < free_elimination_data[index].size()) {
-                                eliminationPatterns = free_elimination_data[index][boardIdx - 1];
-                            }
-                            
-                            int maxOverlap = findBoardOverlap(previousBoardColumn, currentBoardColumn, eliminationPatterns, col);
-                            
-                            for (size_t i = maxOverlap; i < currentBoardColumn.size(); ++i) {
-                                finalReel.push_back(currentBoardColumn[i]);
-                            }
-                        }
-                    }
-                    
-                    outFile << "          \"stop\": " << finalReel.size() << ",\n          \"reel\": [";
-                    for (size_t i = 0; i < finalReel.size(); ++i) {
-                        if (i > 0) outFile << ", ";
-                        outFile << finalReel[i];
-                    }
-                    outFile << "]\n        }";
-                }
-                outFile << "\n      ]\n    }";
-            }
-            outFile << "\n  ]";
         }
         
+        std::ofstream outFile(outputFile);
+        outFile << formatConvertedFile(base, free);
         outFile.close();
         
     } catch (const std::exception& e) {
@@ -341,122 +151,6 @@ void convertJsonFormatAdvanced(const std::string& inputFile, const std::string&
     }
 }
 
-// Test function using existing elimination data and json reel data
-void testSymbolEliminationWithReelData() {
-    std::cout << "\n=== SYMBOL ELIMINATION VALIDATION TEST ===\n";
-    std::cout << "This test validates that the slot game mechanics are correctly balanced:\n";
-    std::cout << "• For each script, we simulate the cascading slot game to count eliminated symbols\n";
-    std::cout << "• We read the corresponding reel data from the smart conversion file\n";
-    std::cout << "• We verify: Number of eliminated symbols = Number of symbols being added from reels\n";
-    std::cout << "• Formula: Total Eliminated = Sum(all reel lengths) - 30\n";
-    std::cout << "• This ensures perfect symbol conservation when board size stays constant at 30\n";
-    std::cout << "• Each eliminated symbol is replaced by exactly one new symbol from the reels\n\n";
-    
-    try {
-        // Get elimination data from the original config
-        auto config = ScriptApp::ScriptConfig::loadFromFile("BG_hist/BG_333.json");
-        
-        // Read reel data from smart conversion file
-        std::ifstream smartFile("BG_hist/BG_smart.json");
-        if (!smartFile.is_open()) {
-            throw std::runtime_error("Unable to open smart conversion file");
-        }
-        
-        nlohmann::json smartJson;
-        smartFile >> smartJson;
-        smartFile.close();
-        
-        SlotSS02 game(true, 20.0f); // cascade enabled
-        
-        int testCount = static_cast<int>(config.base_scripts.size()); // Test ALL scripts
-        int passedTests = 0;
-        int failedTests = 0;
-        
-        std::cout << "Testing " << testCount << " scripts...\n";
-        
-        for (int testIdx = 0; testIdx < testCount; ++testIdx) {
-            const auto& [index, scriptData] = *std::next(config.base_scripts.begin(), testIdx);
-            
-            try {
-                // Get elimination data from game simulation
-                auto [final_board, total_score, actual_stop, patterns, boards_match] = game.steps(scriptData.script, scriptData.special_multipliers);
-                
-                // Count total eliminated symbols
-                int total_eliminated_symbols = 0;
-                
-                for (size_t board_idx = 0; board_idx < patterns.size(); ++board_idx) {
-                    const auto& step_patterns = patterns[board_idx];
-                    
-                    for (const auto& [symbol, positions] : step_patterns) {
-                        int count = positions.size();
-                        total_eliminated_symbols += count;
-                    }
-                }
-                
-                // Find corresponding reel data in smart JSON
-                int total_reel_symbols = 0;
-                bool found_script = false;
-                
-                // Determine the section name in the smart JSON
-                std::string smartSectionName = "base"; // default
-                if (smartJson.contains("free") && !smartJson.contains("base")) {
-                    smartSectionName = "free";
-                }
-                
-                for (const auto& smart_script : smartJson[smartSectionName]) {
-                    if (smart_script["number"].get<int>() == index) {
-                        found_script = true;
-                        // Sum all reel lengths for this script
-                        for (const auto& reel_data : smart_script["script"]) {
-                            total_reel_symbols += reel_data["reel"].size();
-                        }
-                        break;
-                    }
-                }
-                
-                if (!found_script) {
-                    std::cout << "\n❌ Script " << index << " not found in smart conversion file\n";
-                    failedTests++;
-                    continue;
-                }
-                
-                int expected_eliminated = total_reel_symbols - 30; // Total reel symbols - board size
-                
-                if (total_eliminated_symbols == expected_eliminated) {
-                    passedTests++;
-                } else {
-                    std::cout << "\n❌ FAIL Script " << index << ":\n";
-                    std::cout << "  Eliminated: " << total_eliminated_symbols << ", Expected: " << expected_eliminated;
-                    std::cout << ", Difference: " << (total_eliminated_symbols - expected_eliminated) << "\n";
-                    failedTests++;
-                }
-                
-            } catch (const std::exception& e) {
-                std::cout << "\n❌ ERROR Script " << index << ": " << e.what() << "\n";
-                failedTests++;
-            }
-        }
-        
-        std::cout << "\n=== SYMBOL ELIMINATION VALIDATION RESULTS ===\n";
-        std::cout << "• Total tests: " << testCount << " scripts\n";
-        std::cout << "• Passed: " << passedTests << " scripts\n";
-        std::cout << "• Failed: " << failedTests << " scripts\n";
-        std::cout << "• Success rate: " << (testCount > 0 ? (passedTests * 100.0 / testCount) : 0) << "%\n";
-        
-        if (failedTests == 0) {
-            std::cout << "\n✅ VALIDATION SUCCESSFUL: All scripts maintain perfect symbol conservation!\n";
-            std::cout << "   This confirms that the slot game mechanics and reel conversion are correct.\n";
-        } else {
-            std::cout << "\n❌ VALIDATION ISSUES DETECTED: " << failedTests << " scripts failed validation.\n";
-            std::cout << "   This indicates potential problems with game mechanics or reel conversion.\n";
-        }
-        std::cout << "\n";
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error in elimination vs reel test: " << e.what() << "\n";
-    }
-}
-
 // Function to replace base and free content in Insert_Script.json
 void replaceInsertScriptContent(const std::string& smartJsonFile, const std::string& insertScriptFile) {
     try {
@@ -550,18 +244,326 @@ void replaceInsertScriptContent(const std::string& smartJsonFile, const std::str
     }
 }
 
-int main() {
+// Finds `"name": <array or object>` at or after `startPos`, as replace_base_free.py does.
+// Returns the [begin, end) range of the whole member, or npos when it is missing.
+std::pair<size_t, size_t> findJsonSection(const std::string& content, const std::string& name, size_t startPos) {
+    const std::string key = "\"" + name + "\"";
+    for (size_t pos = content.find(key, startPos); pos != std::string::npos; pos = content.find(key, pos + 1)) {
+        size_t value = content.find_first_not_of(" \t\r\n", pos + key.size());
+        if (value == std::string::npos || content[value] != ':') continue;
+        value = content.find_first_not_of(" \t\r\n", value + 1);
+        if (value == std::string::npos || (content[value] != '[' && content[value] != '{')) continue;
+        const char open = content[value], close = open == '[' ? ']' : '}';
+        int depth = 0;
+        for (size_t i = value; i < content.size(); ++i) {
+            if (content[i] == open) depth++;
+            else if (content[i] == close && --depth == 0) return {pos, i + 1};
+        }
+        break;
+    }
+    return {std::string::npos, std::string::npos};
+}
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool readFile(const std::string& filename, std::string& content) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Incremental form of the build-and-update pipeline. Converted entries are cached by a hash of
+// their source JSON entry, so after an edit only the changed scripts are re-evaluated; the
+// output files are reassembled from cached entries and written only when they changed, and
+// the base/free arrays of Insert_Script.json are spliced in place (everything else in that
+// file keeps its bytes).
+class ConvertWatcher {
+public:
+    ConvertWatcher(std::string inputFile, std::string insertScriptFile)
+        : inputFile_(std::move(inputFile)), insertScriptFile_(std::move(insertScriptFile)),
+          baseGame_(true, 20.0f, "base"), freeGame_(true, 20.0f, "free") {}
+
+    // Re-reads the script file; returns false (keeping the previous outputs) if it does not parse
+    bool updateScripts() {
+        auto start = std::chrono::steady_clock::now();
+        nlohmann::json j;
+        try {
+            std::ifstream file(inputFile_);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open " + inputFile_);
+            }
+            file >> j;
+        } catch (const std::exception& e) {
+            std::cout << "❌ " << inputFile_ << ": " << e.what() << " (keeping previous outputs)\n";
+            return false;
+        }
+        const nlohmann::json& data = j.contains("result") ? j.at("result") : j;
+
+        size_t evaluated = 0, reused = 0, mismatches = 0;
+        std::map<std::pair<bool, int>, Entry> next;
+        try {
+            for (bool isFree : {false, true}) {
+                const char* section = isFree ? "free" : "base";
+                if (!data.contains(section)) continue;
+                for (const auto& source : data.at(section)) {
+                    const int index = source.at("index").get<int>();
+                    const uint64_t hash = fnv1a(source.dump());
+                    auto cached = entries_.find({isFree, index});
+                    if (cached != entries_.end() && cached->second.hash == hash) {
+                        next[{isFree, index}] = cached->second;
+                        reused++;
+                        continue;
+                    }
+                    Entry entry;
+                    entry.hash = hash;
+                    entry.data = ScriptApp::ScriptConfig::parseEntry(source, isFree);
+                    SlotSS02& game = isFree ? freeGame_ : baseGame_;
+                    auto [final_board, total_score, actual_stop, patterns, boards_match] =
+                        game.steps(entry.data.script, entry.data.special_multipliers);
+                    entry.simple = simpleEntry(index, entry.data);
+                    entry.smart = formatReelEntry(index, entry.data, ReelConverter::buildSmartReels(entry.data.script, patterns));
+                    if (static_cast<int>(total_score) != entry.data.payout || actual_stop != entry.data.stop || !boards_match) {
+                        if (mismatches++ < 10) {
+                            std::cout << "❌ " << section << " script " << index << ": payout " << static_cast<int>(total_score)
+                                      << " (expected " << entry.data.payout << "), stop " << actual_stop
+                                      << " (expected " << entry.data.stop << ")" << (boards_match ? "" : ", cascading mismatch") << "\n";
+                        }
+                    }
+                    next[{isFree, index}] = std::move(entry);
+                    evaluated++;
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cout << "❌ " << inputFile_ << ": " << e.what() << " (keeping previous outputs)\n";
+            return false;
+        }
+        size_t removed = 0;
+        for (const auto& [key, entry] : entries_) {
+            if (!next.count(key)) removed++;
+        }
+        entries_ = std::move(next);
+
+        std::vector<std::string> simpleBase, simpleFree;
+        base_.clear();
+        free_.clear();
+        for (const auto& [key, entry] : entries_) {
+            (key.first ? simpleFree : simpleBase).push_back(entry.simple);
+            (key.first ? free_ : base_).push_back(entry.smart);
+        }
+        int written = writeIfChanged("SS02_scripts_converted.json", formatConvertedFile(simpleBase, simpleFree)) +
+                      writeIfChanged("SS02_scripts_smart.json", formatConvertedFile(base_, free_));
+        written += updateInsertScript();
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (mismatches ? "⚠️  " : "✅ ") << inputFile_ << ": " << evaluated << " scripts re-evaluated, "
+                  << reused << " cached" << (removed > 0 ? ", " + std::to_string(removed) + " removed" : "")
+                  << (mismatches ? ", " + std::to_string(mismatches) + " mismatches" : "")
+                  << "; " << written << " files written in " << std::fixed << std::setprecision(1) << ms << " ms\n";
+        return true;
+    }
+
+    // Splices the current base/free arrays into Insert_Script.json; returns 1 if it was rewritten
+    int updateInsertScript() {
+        std::string content;
+        if (!readFile(insertScriptFile_, content)) {
+            std::cout << "⚠️  " << insertScriptFile_ << " not found, skipping backend update\n";
+            return 0;
+        }
+        size_t data = content.find("\"data\"");
+        auto [baseBegin, baseEnd] = findJsonSection(content, "base", data == std::string::npos ? 0 : data);
+        auto [freeBegin, freeEnd] = findJsonSection(content, "free", data == std::string::npos ? 0 : data);
+        if (data == std::string::npos || baseBegin == std::string::npos || freeBegin == std::string::npos) {
+            std::cout << "❌ " << insertScriptFile_ << " has no data.base / data.free arrays, not updated\n";
+            return 0;
+        }
+        // Replace the later section first so the earlier range stays valid
+        std::vector<std::tuple<size_t, size_t, std::string>> edits = {
+            {baseBegin, baseEnd, formatSection("base", base_)},
+            {freeBegin, freeEnd, formatSection("free", free_)}
+        };
+        std::sort(edits.begin(), edits.end(), [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+        std::string updated = content;
+        for (const auto& [begin, end, text] : edits) updated.replace(begin, end - begin, text);
+        return writeIfChanged(insertScriptFile_, updated);
+    }
+
+    const std::string& inputFile() const { return inputFile_; }
+    const std::string& insertScriptFile() const { return insertScriptFile_; }
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        ScriptApp::ScriptData data;
+        std::string simple, smart;
+    };
+
+    int writeIfChanged(const std::string& filename, const std::string& content) {
+        std::string existing;
+        if (readFile(filename, existing) && existing == content) return 0;
+        std::ofstream out(filename, std::ios::binary);
+        if (!out.is_open()) {
+            std::cout << "❌ Cannot write to " << filename << "\n";
+            return 0;
+        }
+        out << content;
+        return 1;
+    }
+
+    std::string inputFile_, insertScriptFile_;
+    SlotSS02 baseGame_, freeGame_;
+    std::map<std::pair<bool, int>, Entry> entries_;
+    std::vector<std::string> base_, free_;    // Smart entries in output order
+};
+
+std::atomic<bool> g_stopWatch{false};
+
+void onWatchSignal(int) {
+    g_stopWatch = true;
+}
+
+#ifdef __linux__
+// Watches the directories of both files (editors often replace a file by renaming over it)
+// and reruns the affected part of the pipeline after a short quiet period
+int watchPipeline(const std::string& inputFile, const std::string& insertScriptFile) {
+    namespace fs = std::filesystem;
+    ConvertWatcher watcher(inputFile, insertScriptFile);
+    std::cout << "=== SS02 Convert Watch Mode ===\n\n";
+    watcher.updateScripts();
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: inotify_init1: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    auto watchDir = [&](const std::string& file) {
+        fs::path dir = fs::path(file).parent_path();
+        if (dir.empty()) dir = ".";
+        int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0) {
+            throw std::runtime_error("Cannot watch " + dir.string() + ": " + std::strerror(errno));
+        }
+        return std::make_pair(wd, fs::path(file).filename().string());
+    };
+    const auto scriptsWatch = watchDir(inputFile);
+    const auto insertWatch = watchDir(insertScriptFile);
+
+    std::signal(SIGINT, onWatchSignal);
+    std::signal(SIGTERM, onWatchSignal);
+    std::cout << "👀 Watching " << inputFile << " and " << insertScriptFile << " (Ctrl-C to stop)\n" << std::flush;
+
+    alignas(inotify_event) char buffer[16384];
+    while (!g_stopWatch) {
+        bool scriptsChanged = false, insertChanged = false;
+        // Block until the first event, then collect events until 50 ms pass without one
+        for (int timeout = 500; !g_stopWatch;) {
+            pollfd p{fd, POLLIN, 0};
+            if (::poll(&p, 1, timeout) <= 0) {
+                if (scriptsChanged || insertChanged) break;
+                continue;
+            }
+            ssize_t n;
+            while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* ptr = buffer; ptr < buffer + n;) {
+                    auto* event = reinterpret_cast<inotify_event*>(ptr);
+                    if (event->len > 0) {
+                        std::string name = event->name;
+                        if (event->wd == scriptsWatch.first && name == scriptsWatch.second) scriptsChanged = true;
+                        if (event->wd == insertWatch.first && name == insertWatch.second) insertChanged = true;
+                    }
+                    ptr += sizeof(inotify_event) + event->len;
+                }
+            }
+            timeout = 50;
+        }
+        if (g_stopWatch) break;
+        if (scriptsChanged) {
+            watcher.updateScripts();
+        } else if (insertChanged && watcher.updateInsertScript()) {
+            std::cout << "✅ " << insertScriptFile << " changed, base/free arrays restored\n";
+        }
+        std::cout << std::flush;
+    }
+    ::close(fd);
+    std::cout << "Watch mode stopped\n";
+    return 0;
+}
+#else
+int watchPipeline(const std::string&, const std::string&) {
+    std::cerr << "Error: --watch needs inotify (Linux)\n";
+    return 1;
+}
+#endif
+
+int main(int argc, char* argv[]) {
     std::string inputFile = "SS02_scripts.json";
+    bool profile = false;
+    std::string profileJson;
+    bool perfCounters = false;
+    bool watch = false;
+    std::string insertScriptFile = "FG_hist/Insert_Script.json";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--profile-json" && i + 1 < argc) {
+            profileJson = argv[++i];
+        } else if (arg == "--perf") {
+            perfCounters = true;
+        } else if (arg == "--watch") {
+            watch = true;
+        } else if (arg == "--insert-script" && i + 1 < argc) {
+            insertScriptFile = argv[++i];
+        } else if (arg[0] != '-') {
+            inputFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_convertpay [scripts.json] [--profile] [--profile-json FILE] [--perf]\n"
+                         "       SS02_convertpay [scripts.json] --watch [--insert-script FG_hist/Insert_Script.json]\n";
+            return 1;
+        }
+    }
+    if (watch) {
+        try {
+            return watchPipeline(inputFile, insertScriptFile);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    if (perfCounters && !Instrumentation::instance().enableHardwareCounters()) {
+        std::cout << "⚠️  Hardware counters unavailable, reporting wall time only\n";
+    }
     
     std::cout << "Simple conversion...\n";
-    convertJsonFormat(inputFile, "SS02_scripts_converted.json");
+    {
+        Instrumentation::ScopedTimer timer("simple conversion");
+        convertJsonFormat(inputFile, "SS02_scripts_converted.json");
+    }
 
     std::cout << "Smart conversion...\n";
-    convertJsonFormatAdvanced(inputFile, "SS02_scripts_smart.json");
+    {
+        Instrumentation::ScopedTimer timer("smart conversion");
+        convertJsonFormatAdvanced(inputFile, "SS02_scripts_smart.json");
+    }
 
     std::cout << "All conversions completed!\n";
     std::cout << "Output files:\n";
     std::cout << "  - SS02_scripts_converted.json (simple conversion)\n";
     std::cout << "  - SS02_scripts_smart.json (smart conversion with overlap detection)\n";
+
+    if (profile || perfCounters) {
+        Instrumentation::instance().printReport();
+    }
+    if (!profileJson.empty() && !Instrumentation::instance().exportJson(profileJson)) {
+        std::cerr << "⚠️  Warning: Could not open " << profileJson << " for writing\n";
+    }
     return 0;
 }
@@ -0,0 +1,674 @@
+#include "SS02Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include "SS02Analytic.hpp"
+#include "ScriptConfig.h"
+#include "ReelConverter.h"
+#include "ScriptStream.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <map>
+#include <filesystem>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Long-running evaluator for tuning tools. Listens on a Unix domain socket and keeps script
+// sets, their cascade outcomes (ScriptOutcomeCache) and every answered query resident, so a
+// repeated query is a map lookup instead of a process start, a JSON parse and a re-evaluation.
+//
+// Protocol: one JSON object per line in each direction. Requests carry "cmd" and an optional
+// "id" that is echoed back:
+//   {"cmd": "load",     "file": "SS02_scripts.json"}
+//   {"cmd": "validate", "file": ...}
+//   {"cmd": "rtp",      "file": ..., "trigger": P, "retrigger": P, "rounds": N,
+//                       "volatility": "low", "bet": B, "flat_multipliers": false, "grid": N}
+//   {"cmd": "convert",  "file": ..., "section": "base"|"free", "index": N (optional)}
+//   {"cmd": "stats"} / {"cmd": "unload", "file": ...} / {"cmd": "shutdown"}
+// Responses are {"ok": true, "cached": bool, "elapsed_us": T, "result": ...} or
+// {"ok": false, "error": "..."}. Script sets are reloaded when the file's mtime changes.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* kDefaultSocket = "/tmp/ss02d.sock";
+
+std::atomic<bool> g_stop{false};
+
+void onSignal(int) {
+    g_stop = true;
+}
+
+// One script set with everything derived from it. The outcome cache is built at load time;
+// query results are filled in on first use.
+struct ScriptSet {
+    std::string path;
+    fs::file_time_type mtime;
+    ScriptApp::ScriptConfig config;
+    ScriptOutcomeCache outcomes;
+    double loadMs = 0.0;
+
+    std::mutex mutex;                                   // Guards the query caches below
+    nlohmann::json validation;                          // null until first validate
+    std::map<std::string, nlohmann::json> rtp;          // Keyed by the normalized parameters
+    std::map<std::pair<bool, int>, nlohmann::json> reels;
+};
+
+struct Counters {
+    std::atomic<uint64_t> requests{0}, hits{0}, misses{0}, errors{0}, connections{0};
+};
+
+// Loaded script sets by canonical path. Each path has its own slot so a slow load only
+// blocks requests for the same file.
+class ScriptSetStore {
+public:
+    // Returns the set for `file`, loading it on first use or when the file changed on disk
+    std::shared_ptr<ScriptSet> get(const std::string& file, bool& loaded) {
+        const std::string path = fs::weakly_canonical(fs::path(file)).string();
+        std::shared_ptr<Slot> slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& s = slots_[path];
+            if (!s) s = std::make_shared<Slot>();
+            slot = s;
+        }
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        std::error_code ec;
+        auto mtime = fs::last_write_time(path, ec);
+        if (ec) {
+            throw std::runtime_error("Cannot open " + file);
+        }
+        loaded = false;
+        if (!slot->set || slot->set->mtime != mtime) {
+            auto start = std::chrono::steady_clock::now();
+            auto set = std::make_shared<ScriptSet>();
+            set->path = path;
+            set->mtime = mtime;
+            set->config = ScriptApp::ScriptConfig::loadFromFile(path);
+            set->outcomes = ScriptOutcomeCache::build(set->config);
+            set->loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            slot->set = set;
+            loaded = true;
+        }
+        return slot->set;
+    }
+
+    bool unload(const std::string& file) {
+        const std::string path = fs::weakly_canonical(fs::path(file)).string();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_.erase(path) > 0;
+    }
+
+    nlohmann::json describe() {
+        std::vector<std::shared_ptr<Slot>> slots;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [path, slot] : slots_) slots.push_back(slot);
+        }
+        nlohmann::json sets = nlohmann::json::array();
+        for (const auto& slot : slots) {
+            std::lock_guard<std::mutex> lock(slot->mutex);
+            if (!slot->set) continue;
+            std::lock_guard<std::mutex> cacheLock(slot->set->mutex);
+            sets.push_back({
+                {"file", slot->set->path},
+                {"base", slot->set->config.base_scripts.size()},
+                {"free", slot->set->config.free_scripts.size()},
+                {"load_ms", slot->set->loadMs},
+                {"cached_rtp", slot->set->rtp.size()},
+                {"cached_reels", slot->set->reels.size()},
+                {"validated", !slot->set->validation.is_null()}
+            });
+        }
+        return sets;
+    }
+
+private:
+    struct Slot {
+        std::mutex mutex;
+        std::shared_ptr<ScriptSet> set;
+    };
+
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<Slot>> slots_;
+};
+
+nlohmann::json validateSection(const std::map<int, ScriptApp::ScriptData>& scripts, const std::string& gameType) {
+    SlotSS02 game(true, 20.0f, gameType);
+    SS02BatchEvaluator evaluator(game);
+    std::vector<const std::vector<Board>*> boards;
+    std::vector<int> specials;
+    for (const auto& [index, data] : scripts) {
+        boards.push_back(&data.script);
+        specials.push_back(data.special_multipliers);
+    }
+    auto results = evaluator.evaluate(boards, specials);
+
+    double expectedSum = 0.0, calculatedSum = 0.0;
+    int payoutMismatches = 0, stopMismatches = 0, cascadingMismatches = 0;
+    nlohmann::json examples = nlohmann::json::array();
+    size_t i = 0;
+    for (const auto& [index, data] : scripts) {
+        const auto& r = results[i++];
+        expectedSum += data.payout;
+        calculatedSum += r.score;
+        bool payoutMismatch = r.score != data.payout;
+        bool stopMismatch = r.stop != data.stop;
+        if (payoutMismatch) payoutMismatches++;
+        if (stopMismatch) stopMismatches++;
+        if (!r.cascade_match) cascadingMismatches++;
+        if ((payoutMismatch || stopMismatch || !r.cascade_match) && examples.size() < 5) {
+            examples.push_back({{"index", index}, {"payout", r.score}, {"expected_payout", data.payout},
+                                {"stop", r.stop}, {"expected_stop", data.stop}, {"cascade_match", r.cascade_match}});
+        }
+    }
+    const double n = scripts.empty() ? 1.0 : static_cast<double>(scripts.size());
+    return {
+        {"scripts", scripts.size()},
+        {"expected_average_payout", expectedSum / n},
+        {"calculated_average_payout", calculatedSum / n},
+        {"payout_mismatches", payoutMismatches},
+        {"stop_mismatches", stopMismatches},
+        {"cascading_mismatches", cascadingMismatches},
+        {"examples", examples}
+    };
+}
+
+// Parameters of an rtp request, defaulting to the SS02 game's own values
+RtpParameters rtpParameters(const nlohmann::json& request, size_t& gridSize) {
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters params = RtpParameters::fromGame(game);
+    params.fgTrigger = request.value("trigger", params.fgTrigger);
+    params.fgRetrigger = request.value("retrigger", params.fgRetrigger);
+    params.fgRounds = request.value("rounds", params.fgRounds);
+    params.volatility = request.value("volatility", params.volatility);
+    params.bet = request.value("bet", params.bet);
+    params.drawMultipliers = !request.value("flat_multipliers", false);
+    gridSize = request.value("grid", static_cast<size_t>(0));
+    RtpParameters::checkVolatility(params.volatility);
+    return params;
+}
+
+nlohmann::json rtpJson(const RtpParameters& params, const RtpReport& report, size_t gridSize) {
+    nlohmann::json j;
+    j["parameters"] = {
+        {"bet", params.bet},
+        {"fg_trigger", params.fgTrigger},
+        {"fg_retrigger", params.fgRetrigger},
+        {"fg_rounds", params.fgRounds},
+        {"volatility", params.volatility},
+        {"draw_multipliers", params.drawMultipliers}
+    };
+    j["base"] = {{"mean", report.baseMean}, {"variance", report.baseVariance}};
+    j["free_spin"] = {{"mean", report.freeSpinMean}, {"variance", report.freeSpinVariance},
+                      {"script_mean", report.freeScriptMean}};
+    j["fg_length"] = {{"mean", report.sessionLengthMean}, {"variance", report.sessionLengthVariance}};
+    j["fg_session"] = {{"mean", report.sessionMean}, {"variance", report.sessionVariance}};
+    j["spin"] = {{"mean", report.spinMean}, {"variance", report.spinVariance}};
+    j["rtp"] = {{"base", report.baseRtp}, {"free", report.freeRtp}, {"total", report.rtp}};
+    if (gridSize > 0) {
+        for (const auto& [key, d] : {std::make_pair("fg_session", &report.session), std::make_pair("spin", &report.spin)}) {
+            j[key]["distribution"]["bin_width"] = d->binWidth;
+            for (double q : {0.5, 0.9, 0.99, 0.999, 0.9999}) {
+                std::ostringstream name;
+                name << "p" << q * 100.0;
+                j[key]["distribution"]["quantiles"][name.str()] = d->quantile(q);
+            }
+        }
+    }
+    return j;
+}
+
+// Converter output for one script, in the SS02_scripts_smart.json entry layout
+nlohmann::json reelEntry(int index, const ScriptApp::ScriptData& data, bool isFree) {
+    SlotSS02 game(true, 20.0f, isFree ? "free" : "base");
+    auto [final_board, total_score, actual_stop, patterns, boards_match] = game.steps(data.script, data.special_multipliers);
+    auto reels = ReelConverter::buildSmartReels(data.script, patterns);
+    nlohmann::json entry = {{"number", index}, {"stopover", data.stop}};
+    if (isFree) entry["multiple_table"] = data.multiple_table;
+    entry["script"] = nlohmann::json::array();
+    for (size_t col = 0; col < reels.size(); ++col) {
+        entry["script"].push_back({{"index", col}, {"stop", reels[col].size()}, {"reel", reels[col]}});
+    }
+    return entry;
+}
+
+class Daemon {
+public:
+    explicit Daemon(std::string defaultFile) : defaultFile_(std::move(defaultFile)) {}
+
+    Counters& counters() { return counters_; }
+
+    // Answers one request line; never throws
+    std::string handle(const std::string& line) {
+        auto start = std::chrono::steady_clock::now();
+        counters_.requests++;
+        nlohmann::json response;
+        nlohmann::json request;
+        try {
+            request = nlohmann::json::parse(line);
+            bool cached = false;
+            response["result"] = dispatch(request, cached);
+            response["cached"] = cached;
+            response["ok"] = true;
+            (cached ? counters_.hits : counters_.misses)++;
+        } catch (const std::exception& e) {
+            counters_.errors++;
+            response = {{"ok", false}, {"error", e.what()}};
+        }
+        if (request.is_object() && request.contains("id")) response["id"] = request["id"];
+        response["elapsed_us"] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return response.dump() + "\n";
+    }
+
+private:
+    nlohmann::json dispatch(const nlohmann::json& request, bool& cached) {
+        const std::string cmd = request.at("cmd").get<std::string>();
+        const std::string file = request.value("file", defaultFile_);
+
+        if (cmd == "stats") {
+            cached = true;
+            return {
+                {"uptime_s", std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count()},
+                {"requests", counters_.requests.load()},
+                {"cache_hits", counters_.hits.load()},
+                {"cache_misses", counters_.misses.load()},
+                {"errors", counters_.errors.load()},
+                {"connections", counters_.connections.load()},
+                {"script_sets", store_.describe()}
+            };
+        }
+        if (cmd == "shutdown") {
+            g_stop = true;
+            return {{"stopping", true}};
+        }
+        if (cmd == "unload") {
+            return {{"unloaded", store_.unload(file)}};
+        }
+
+        bool loaded = false;
+        auto set = store_.get(file, loaded);
+        if (cmd == "load") {
+            cached = !loaded;
+            return {{"file", set->path}, {"base", set->config.base_scripts.size()},
+                    {"free", set->config.free_scripts.size()}, {"load_ms", set->loadMs}};
+        }
+        if (cmd == "validate") {
+            std::lock_guard<std::mutex> lock(set->mutex);
+            cached = !set->validation.is_null();
+            if (!cached) {
+                set->validation = {{"base", validateSection(set->config.base_scripts, "base")},
+                                   {"free", validateSection(set->config.free_scripts, "free")}};
+            }
+            return set->validation;
+        }
+        if (cmd == "rtp") {
+            size_t gridSize = 0;
+            RtpParameters params = rtpParameters(request, gridSize);
+            const std::string key = nlohmann::json({params.fgTrigger, params.fgRetrigger, params.fgRounds,
+                                                    params.volatility, params.bet, params.drawMultipliers,
+                                                    gridSize}).dump();
+            {
+                std::lock_guard<std::mutex> lock(set->mutex);
+                auto it = set->rtp.find(key);
+                if (it != set->rtp.end()) {
+                    cached = true;
+                    return it->second;
+                }
+            }
+            // Solved outside the lock so independent parameter sets run in parallel
+            RtpReport report = SS02AnalyticRtp(set->outcomes).solve(params, gridSize);
+            nlohmann::json result = rtpJson(params, report, gridSize);
+            std::lock_guard<std::mutex> lock(set->mutex);
+            set->rtp.emplace(key, result);
+            return result;
+        }
+        if (cmd == "convert") {
+            const std::string section = request.value("section", "base");
+            if (section != "base" && section != "free") {
+                throw std::runtime_error("section must be \"base\" or \"free\"");
+            }
+            const bool isFree = section == "free";
+            const auto& scripts = isFree ? set->config.free_scripts : set->config.base_scripts;
+            std::vector<int> indices;
+            if (request.contains("index")) {
+                int index = request.at("index").get<int>();
+                if (!scripts.count(index)) {
+                    throw std::runtime_error("No " + section + " script with index " + std::to_string(index));
+                }
+                indices.push_back(index);
+            } else {
+                for (const auto& [index, data] : scripts) indices.push_back(index);
+            }
+            cached = true;
+            nlohmann::json entries = nlohmann::json::array();
+            for (int index : indices) {
+                {
+                    std::lock_guard<std::mutex> lock(set->mutex);
+                    auto it = set->reels.find({isFree, index});
+                    if (it != set->reels.end()) {
+                        entries.push_back(it->second);
+                        continue;
+                    }
+                }
+                cached = false;
+                nlohmann::json entry = reelEntry(index, scripts.at(index), isFree);
+                std::lock_guard<std::mutex> lock(set->mutex);
+                set->reels.emplace(std::make_pair(isFree, index), entry);
+                entries.push_back(std::move(entry));
+            }
+            return request.contains("index") ? entries[0] : entries;
+        }
+        throw std::runtime_error("Unknown cmd \"" + cmd + "\"");
+    }
+
+    std::string defaultFile_;
+    ScriptSetStore store_;
+    Counters counters_;
+    const std::chrono::steady_clock::time_point started_ = std::chrono::steady_clock::now();
+};
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads newline-terminated lines from a socket
+class LineReader {
+public:
+    explicit LineReader(int fd) : fd_(fd) {}
+
+    bool next(std::string& line) {
+        for (;;) {
+            size_t newline = buffer_.find('\n', scanned_);
+            if (newline != std::string::npos) {
+                line = buffer_.substr(0, newline);
+                buffer_.erase(0, newline + 1);
+                scanned_ = 0;
+                return true;
+            }
+            scanned_ = buffer_.size();
+            char chunk[65536];
+            ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+    }
+
+private:
+    int fd_;
+    std::string buffer_;
+    size_t scanned_ = 0;
+};
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+// One client connection, owned by the polling thread. Requests on a connection are answered
+// in order: at most one of its lines is with a worker at a time.
+struct Connection {
+    std::string buffer;                 // Received bytes not yet split into lines
+    std::deque<std::string> lines;      // Complete requests waiting for a worker
+    bool busy = false;                  // A worker is answering one of its requests
+    bool closed = false;                // Client hung up; closed once its worker is done
+};
+
+struct Job {
+    int fd = -1;
+    std::string line;
+};
+
+int serve(const std::string& socketPath, const std::string& defaultFile, unsigned workers, bool preload) {
+    Daemon daemon(defaultFile);
+    if (preload) {
+        std::cout << daemon.handle(nlohmann::json({{"cmd", "load"}, {"file", defaultFile}}).dump());
+    }
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    sockaddr_un addr = socketAddress(socketPath);
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listenFd, 64) < 0) {
+        ::close(listenFd);
+        throw std::runtime_error("Cannot listen on " + socketPath + ": " + std::strerror(errno));
+    }
+    // Workers write a byte here after every answered request to wake the poll loop
+    int wake[2];
+    if (::pipe2(wake, O_NONBLOCK | O_CLOEXEC) < 0) {
+        ::close(listenFd);
+        throw std::runtime_error(std::string("pipe: ") + std::strerror(errno));
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "✅ Listening on " << socketPath << " with " << workers << " workers\n" << std::flush;
+
+    // The polling thread owns every connection and hands single requests to the pool, so idle
+    // clients hold no worker
+    BoundedQueue<Job> jobs(1024);
+    std::mutex doneMutex;
+    std::vector<std::pair<int, bool>> done;   // fd, response delivered
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < workers; ++t) {
+        pool.emplace_back([&]() {
+            Job job;
+            while (jobs.pop(job)) {
+                const bool sent = sendAll(job.fd, daemon.handle(job.line));
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done.emplace_back(job.fd, sent);
+                }
+                const char byte = 1;
+                (void)!::write(wake[1], &byte, 1);
+            }
+        });
+    }
+
+    std::map<int, Connection> connections;
+    auto dispatch = [&](int fd, Connection& c) {
+        if (c.busy || c.lines.empty()) return;
+        c.busy = true;
+        Job job{fd, std::move(c.lines.front())};
+        c.lines.pop_front();
+        jobs.push(std::move(job));
+    };
+    auto finishJobs = [&]() {
+        char drain[256];
+        while (::read(wake[0], drain, sizeof(drain)) > 0) {}
+        std::vector<std::pair<int, bool>> finished;
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            finished.swap(done);
+        }
+        for (const auto& [fd, sent] : finished) {
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& c = it->second;
+            c.busy = false;
+            if (!sent) c.closed = true;
+            if (c.closed) {
+                ::close(fd);
+                connections.erase(it);
+            } else if (!g_stop) {
+                dispatch(fd, c);
+            }
+        }
+    };
+    auto readConnection = [&](int fd, Connection& c) {
+        char chunk[65536];
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) return;
+        if (n <= 0) {
+            c.closed = true;
+            return;
+        }
+        c.buffer.append(chunk, static_cast<size_t>(n));
+        size_t start = 0;
+        for (size_t newline; (newline = c.buffer.find('\n', start)) != std::string::npos; start = newline + 1) {
+            std::string line = c.buffer.substr(start, newline - start);
+            if (line.find_first_not_of(" \t\r") != std::string::npos) c.lines.push_back(std::move(line));
+        }
+        c.buffer.erase(0, start);
+        dispatch(fd, c);
+    };
+
+    std::vector<pollfd> fds;
+    while (!g_stop) {
+        fds.assign({{listenFd, POLLIN, 0}, {wake[0], POLLIN, 0}});
+        for (const auto& [fd, c] : connections) {
+            if (!c.closed) fds.push_back({fd, POLLIN, 0});
+        }
+        int ready = ::poll(fds.data(), fds.size(), 200);
+        if (ready <= 0) continue;
+        if (fds[1].revents) finishJobs();
+        for (size_t i = 2; i < fds.size(); ++i) {
+            if (!fds[i].revents) continue;
+            auto it = connections.find(fds[i].fd);
+            if (it == connections.end()) continue;
+            readConnection(it->first, it->second);
+            if (it->second.closed && !it->second.busy) {
+                ::close(it->first);
+                connections.erase(it);
+            }
+        }
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                daemon.counters().connections++;
+                connections.emplace(fd, Connection());
+            }
+        }
+    }
+
+    // Let requests already with the pool deliver their responses (the reply to "shutdown"
+    // among them), then cut off clients that stop reading so no worker stays blocked in send
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    auto anyBusy = [&]() {
+        for (const auto& [fd, c] : connections) {
+            if (c.busy) return true;
+        }
+        return false;
+    };
+    while (anyBusy() && std::chrono::steady_clock::now() < deadline) {
+        pollfd p{wake[0], POLLIN, 0};
+        ::poll(&p, 1, 50);
+        finishJobs();
+    }
+    for (const auto& [fd, c] : connections) {
+        if (c.busy) ::shutdown(fd, SHUT_RDWR);
+    }
+    jobs.close();
+    for (auto& t : pool) t.join();
+    for (const auto& [fd, c] : connections) ::close(fd);
+    ::close(wake[0]);
+    ::close(wake[1]);
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+
+    std::cout << "Stopped after " << daemon.counters().requests << " requests ("
+              << daemon.counters().hits << " cached, " << daemon.counters().errors << " errors)\n";
+    return 0;
+}
+
+// Client mode: sends one request `repeat` times over one connection and prints the last reply
+int send(const std::string& socketPath, const std::string& request, int repeat) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = socketAddress(socketPath);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Cannot connect to " + socketPath + ": " + std::strerror(errno));
+    }
+    LineReader reader(fd);
+    std::string reply;
+    std::vector<double> latencies;
+    for (int i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        if (!sendAll(fd, request + "\n") || !reader.next(reply)) {
+            ::close(fd);
+            throw std::runtime_error("Connection closed by daemon");
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    ::close(fd);
+    std::cout << reply << "\n";
+    if (repeat > 1) {
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0.0;
+        for (double l : latencies) sum += l;
+        std::cerr << repeat << " round trips: mean " << std::fixed << std::setprecision(1) << sum / repeat
+                  << " us, p50 " << latencies[latencies.size() / 2] << " us, p99 "
+                  << latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)] << " us\n";
+    }
+    return nlohmann::json::parse(reply).value("ok", false) ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string socketPath = kDefaultSocket;
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string request;
+    int repeat = 1;
+    bool preload = true;
+    unsigned workers = std::max(2u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--no-preload") {
+            preload = false;
+        } else if (arg == "--send" && i + 1 < argc) {
+            request = argv[++i];
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_daemon [scripts.json] [--socket PATH] [--workers N] [--no-preload]\n"
+                         "       SS02_daemon --send '{\"cmd\":\"rtp\",\"trigger\":0.006}' [--socket PATH] [--repeat N]\n";
+            return 1;
+        }
+    }
+
+    try {
+        if (!request.empty()) {
+            return send(socketPath, request, repeat);
+        }
+        std::cout << "=== SS02 Evaluation Daemon ===\n\n";
+        return serve(socketPath, scriptsFile, workers, preload);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
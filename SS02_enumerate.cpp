@@ -0,0 +1,178 @@
+#include "SS02Pay.hpp"
+#include "CompositionEnumerator.hpp"
+#include "SS02Generator.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+// Enumerates every feasible composition of a DeepDive composition config
+// (Backup/DeepDiveBG_Comp_Config.json, Backup/DeepDiveFG_Comp_Config.json).
+//
+// Output:
+//   - "input_values": distinct non-zero payouts, ready for a DeepDive_*_Selection file
+//   - "payouts":      number of compositions per payout
+//   - "base"/"free":  example compositions per payout in SS02_generate's composition format
+
+int main(int argc, char* argv[]) {
+    std::string configFile;
+    std::string outputFile;
+    std::string section;
+    int examples = 1;
+    int maxPayout = 0;
+    bool verify = true;
+    std::string gameConfigFile;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg == "--section" && i + 1 < argc) {
+            section = argv[++i];
+        } else if (arg == "--examples" && i + 1 < argc) {
+            examples = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--max-payout" && i + 1 < argc) {
+            maxPayout = std::stoi(argv[++i]);
+        } else if (arg == "--game-config" && i + 1 < argc) {
+            gameConfigFile = argv[++i];
+        } else if (arg == "--no-verify") {
+            verify = false;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (configFile.empty()) {
+            configFile = arg;
+        } else {
+            configFile.clear();
+            break;
+        }
+    }
+    if (configFile.empty()) {
+        std::cerr << "Usage: SS02_enumerate <DeepDive_Comp_Config.json> [-o output.json] [--section base|free]"
+                     " [--examples N] [--max-payout N] [--game-config GameConfig.json] [--no-verify] [--threads N]\n";
+        return 1;
+    }
+
+    std::cout << "=== SS02 Composition Enumerator ===\n\n";
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        SlotSS02 game(true, 20.0f, "base");
+        DeepDiveProblem problem = DeepDiveProblem::loadFromFile(configFile, game);
+        if (section.empty()) {
+            section = problem.isFree ? "free" : "base";
+        }
+        if (outputFile.empty()) {
+            outputFile = "SS02_compositions_" + section + ".json";
+        }
+        if (!gameConfigFile.empty() && maxPayout <= 0) {
+            // Max-win caps from GameConfig.json (BG_max / FG_max)
+            std::ifstream gameConfig(gameConfigFile);
+            if (!gameConfig.is_open()) {
+                throw std::runtime_error("Unable to open game config file: " + gameConfigFile);
+            }
+            nlohmann::json gc;
+            gameConfig >> gc;
+            maxPayout = gc.value(section == "free" ? "FG_max" : "BG_max", 0);
+        }
+
+        std::cout << "Problem: " << problem.name << " (" << section << ")\n";
+        if (maxPayout > 0) std::cout << "Max payout: " << maxPayout << "\n";
+        std::cout << "Terms: " << problem.termNames.size() << ", max count " << problem.globalMaxCount
+                  << ", max nonzero " << problem.maxNonzeroCounts << ", total count ["
+                  << problem.totalCountMin << ", " << problem.totalCountMax << "]\n";
+
+        CompositionEnumerator enumerator(problem);
+        RefillSolver solver(game);
+        // Spare candidates replace examples the generator cannot realize
+        constexpr int kSpareExamples = 4;
+        auto groups = enumerator.enumerate(threads, examples + (verify ? kSpareExamples : 0), maxPayout);
+
+        long long total = 0;
+        for (const auto& [payout, group] : groups) total += group.compositions;
+        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        nlohmann::json output;
+        output["problem_name"] = problem.name;
+        output["section"] = section;
+        output["total_compositions"] = total;
+        output["distinct_payouts"] = groups.size();
+
+        // Realize each candidate through the generator under a few seeds; payouts without a
+        // reliably realizable candidate are left out of input_values
+        constexpr int kVerifySeeds = 3;
+        SS02ScriptGenerator generator(section, 1);
+        int unrealizable = 0, droppedPayouts = 0;
+
+        nlohmann::json inputValues = nlohmann::json::array();
+        nlohmann::json payouts = nlohmann::json::array();
+        nlohmann::json compositions = nlohmann::json::array();
+        int payoutId = 1;
+        for (const auto& [payout, group] : groups) {
+            int id = payout == 0 ? 0 : payoutId;
+            int kept = 0;
+            for (const auto& example : group.examples) {
+                if (kept == examples) break;
+                nlohmann::json j = example.toJson(problem, solver);
+                if (verify) {
+                    try {
+                        CompositionSpec spec = CompositionSpec::fromJson(j);
+                        for (int seed = 1; seed <= kVerifySeeds; ++seed) {
+                            generator.reseed(seed);
+                            generator.generate(spec);
+                        }
+                    } catch (const std::exception&) {
+                        unrealizable++;
+                        continue;
+                    }
+                }
+                j["payout_id"] = id;
+                compositions.push_back(j);
+                kept++;
+            }
+            if (kept == 0) {
+                droppedPayouts++;
+                continue;
+            }
+            payouts.push_back({{"payout", payout}, {"compositions", group.compositions}});
+            if (payout > 0) {
+                inputValues.push_back(payout);
+                payoutId++;
+            }
+        }
+        output["input_values"] = inputValues;
+        output["payouts"] = payouts;
+        output[section] = compositions;
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        outFile << output.dump(2) << "\n";
+        outFile.close();
+
+        std::cout << "\n✅ Enumerated " << total << " compositions with " << groups.size() << " distinct payouts in "
+                  << std::fixed << std::setprecision(3) << duration << " s (" << threads << " threads)\n";
+        if (!groups.empty()) {
+            std::cout << "   Payout range: " << groups.begin()->first << " - " << groups.rbegin()->first << "\n";
+        }
+        if (verify) {
+            if (droppedPayouts == 0) {
+                std::cout << "✅ Every payout has examples realized through SS02_generate";
+                if (unrealizable > 0) std::cout << " (" << unrealizable << " candidates replaced)";
+                std::cout << "\n";
+            } else {
+                std::cout << "⚠️  " << unrealizable << " candidate compositions could not be realized; "
+                          << droppedPayouts << " payouts dropped\n";
+            }
+        }
+        std::cout << "   Output: " << outputFile << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
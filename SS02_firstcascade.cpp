@@ -0,0 +1,192 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <algorithm>
+
+// Exact first-cascade payout distribution and terminal-board probability for boards drawn
+// cell by cell from per-symbol weights (FirstCascadeDistribution in SS02Analytic.hpp).
+// Weights come from --weights or, by default, from the symbol frequencies of the first
+// boards of a script section. --verify N cross-checks the result with N random boards
+// scored by SlotSS02 itself.
+
+namespace {
+
+std::vector<double> parseWeights(const std::string& text) {
+    std::vector<double> weights;
+    std::istringstream iss(text);
+    std::string item;
+    while (std::getline(iss, item, ',')) weights.push_back(std::stod(item));
+    return weights;
+}
+
+struct MonteCarlo {
+    double mean = 0.0;
+    double terminal = 0.0;
+    std::map<int, double> pmf;
+};
+
+MonteCarlo sampleBoards(SlotSS02& game, const std::vector<double>& weights, long long boards, uint64_t seed) {
+    std::vector<int> values;
+    for (size_t s = 0; s < weights.size(); ++s) {
+        values.push_back(s < game.get_symbols().size() ? game.get_symbols()[s] : SlotSS02::get_multiplier_symbol());
+    }
+    std::discrete_distribution<size_t> draw(weights.begin(), weights.end());
+    std::mt19937_64 rng(seed);
+    Board board(game.get_board_height(), std::vector<int>(game.get_board_width()));
+    MonteCarlo mc;
+    for (long long i = 0; i < boards; ++i) {
+        for (auto& row : board) {
+            for (int& cell : row) cell = values[draw(rng)];
+        }
+        auto [patterns, hasMatch] = game.find_matches(board);
+        const int score = static_cast<int>(game.get_score(patterns));
+        mc.mean += score;
+        if (!hasMatch) mc.terminal += 1.0;
+        mc.pmf[score] += 1.0;
+    }
+    mc.mean /= static_cast<double>(boards);
+    mc.terminal /= static_cast<double>(boards);
+    for (auto& [payout, p] : mc.pmf) p /= static_cast<double>(boards);
+    return mc;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string section = "base";
+    std::string weightsText;
+    std::string outputFile;
+    long long verifyBoards = 0;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--section" && i + 1 < argc) {
+            section = argv[++i];
+        } else if (arg == "--weights" && i + 1 < argc) {
+            weightsText = argv[++i];
+        } else if (arg == "--verify" && i + 1 < argc) {
+            verifyBoards = std::stoll(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_firstcascade [scripts.json] [--section base|free] [--weights w0,...,w8[,wMultiplier]]"
+                         " [--verify BOARDS] [--threads N] [-o output.json]\n";
+            return 1;
+        }
+    }
+    if (section != "base" && section != "free") {
+        std::cerr << "Error: section must be base or free\n";
+        return 1;
+    }
+    if (outputFile.empty()) {
+        outputFile = "SS02_first_cascade_" + section + ".json";
+    }
+
+    std::cout << "=== SS02 First Cascade Distribution ===\n\n";
+
+    try {
+        SlotSS02 game(true, 20.0f, section);
+        std::vector<double> weights;
+        if (weightsText.empty()) {
+            auto config = loadSS02Scripts(scriptsFile);
+            weights = FirstCascadeDistribution::weightsFromScripts(section == "free" ? config.free_scripts : config.base_scripts);
+            std::cout << "Weights: symbol frequencies of the " << section << " first boards in " << scriptsFile << "\n";
+        } else {
+            weights = parseWeights(weightsText);
+        }
+        double total = 0.0;
+        for (double w : weights) total += w;
+        std::cout << "Symbol probabilities:";
+        for (double w : weights) std::cout << " " << std::fixed << std::setprecision(4) << (total > 0.0 ? w / total : 0.0);
+        std::cout << "\n\n";
+
+        auto start = std::chrono::steady_clock::now();
+        FirstCascadeReport report = FirstCascadeDistribution(game).solve(weights, threads);
+        double solveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        double mass = 0.0;
+        size_t support = 0;
+        for (double p : report.payout.pmf) {
+            mass += p;
+            if (p > 0.0) support++;
+        }
+        std::cout << "Solved in " << std::setprecision(1) << solveMs << " ms (" << threads << " threads), "
+                  << support << " payout values, total mass " << std::setprecision(12) << mass << "\n";
+        std::cout << std::setprecision(6);
+        std::cout << "Terminal board probability: " << report.terminalProbability << "\n";
+        std::cout << "First step payout mean:     " << report.mean << "\n";
+        std::cout << "First step payout std dev:  " << std::sqrt(report.variance) << "\n";
+        std::cout << "P(payout >= 100):           " << report.payout.exceedance(100.0) << "\n";
+        std::cout << "\nCluster probability per symbol:\n";
+        for (size_t s = 0; s < report.clusterProbability.size(); ++s) {
+            std::cout << "  Symbol " << s << ": " << report.clusterProbability[s] << "\n";
+        }
+
+        int failed = 0;
+        if (verifyBoards > 0) {
+            start = std::chrono::steady_clock::now();
+            MonteCarlo mc = sampleBoards(game, weights, verifyBoards, 12345);
+            double mcMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            double tv = 0.0;
+            for (const auto& [payout, p] : mc.pmf) {
+                tv += std::abs(p - (static_cast<size_t>(payout) < report.payout.pmf.size() ? report.payout.pmf[payout] : 0.0));
+            }
+            for (size_t pay = 0; pay < report.payout.pmf.size(); ++pay) {
+                if (!mc.pmf.count(static_cast<int>(pay))) tv += report.payout.pmf[pay];
+            }
+            const double n = static_cast<double>(verifyBoards);
+            const double terminalSe = std::sqrt(report.terminalProbability * (1.0 - report.terminalProbability) / n);
+            const double meanSe = std::sqrt(report.variance / n);
+            const bool ok = std::abs(mc.terminal - report.terminalProbability) <= 4.0 * terminalSe + 1e-12 &&
+                            std::abs(mc.mean - report.mean) <= 4.0 * meanSe + 1e-12;
+            std::cout << "\nMonte Carlo, " << verifyBoards << " boards (" << std::setprecision(1) << mcMs << " ms):\n"
+                      << std::setprecision(6) << "  Terminal probability: " << mc.terminal << "\n"
+                      << "  Payout mean:          " << mc.mean << "\n"
+                      << "  Total variation:      " << 0.5 * tv << "\n";
+            if (ok) {
+                std::cout << "✅ Monte Carlo agrees with the exact distribution within 4 standard errors\n";
+            } else {
+                std::cout << "❌ Monte Carlo differs from the exact distribution by more than 4 standard errors\n";
+                failed = 1;
+            }
+        }
+
+        nlohmann::json out;
+        out["section"] = section;
+        out["weights"] = weights;
+        out["terminal_probability"] = report.terminalProbability;
+        out["mean"] = report.mean;
+        out["std_dev"] = std::sqrt(report.variance);
+        out["cluster_probability"] = report.clusterProbability;
+        nlohmann::json pmf = nlohmann::json::object();
+        for (size_t pay = 0; pay < report.payout.pmf.size(); ++pay) {
+            if (report.payout.pmf[pay] > 0.0) pmf[std::to_string(pay)] = report.payout.pmf[pay];
+        }
+        out["pmf"] = pmf;
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        file << out.dump(2) << "\n";
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return failed;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
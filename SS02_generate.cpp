@@ -0,0 +1,258 @@
+#include "SS02Pay.hpp"
+#include "SS02Generator.hpp"
+#include "ScriptConfig.h"
+#include "SeedMix.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <ctime>
+#include <sstream>
+#include <algorithm>
+
+// Native SS02 script generator.
+//
+// Input is a composition file:
+//   {
+//     "base": [ { "steps": [[{"symbol": 8, "count": 8}]], "repeat": 3 }, { "steps": [], "repeat": 600 } ],
+//     "free": [ { "steps": [[{"symbol": 2, "count": 10}]], "special_multipliers": 3, "multiplier_count": 1 } ]
+//   }
+// or, with --from-scripts, an existing script file whose cascades are re-used as compositions.
+// Output follows the SS02_scripts.json schema.
+
+namespace {
+
+struct Job {
+    bool isFree;
+    size_t composition;
+    int outputIndex;
+};
+
+std::vector<CompositionSpec> readCompositions(const nlohmann::json& j, const std::string& section) {
+    std::vector<CompositionSpec> specs;
+    if (!j.contains(section)) return specs;
+    int nextPayoutId = 1;
+    for (const auto& entry : j.at(section)) {
+        CompositionSpec spec = CompositionSpec::fromJson(entry);
+        if (!entry.contains("payout_id")) {
+            spec.payout_id = spec.steps.empty() ? 0 : nextPayoutId++;
+        }
+        specs.push_back(spec);
+    }
+    return specs;
+}
+
+// Derive one composition per script from the cascades found by steps()
+std::vector<CompositionSpec> compositionsFromScripts(const std::map<int, ScriptApp::ScriptData>& scripts,
+                                                     const std::string& gameType) {
+    SlotSS02 game(true, 20.0f, gameType);
+    std::vector<CompositionSpec> specs;
+    for (const auto& [index, scriptData] : scripts) {
+        auto [final_board, total_score, actual_stop, patterns, boards_match] = game.steps(scriptData.script, scriptData.special_multipliers);
+        CompositionSpec spec;
+        for (const auto& stepPatterns : patterns) {
+            std::vector<ClusterSpec> clusters;
+            for (const auto& [symbol, positions] : stepPatterns) {
+                clusters.push_back({symbol, static_cast<int>(positions.size())});
+            }
+            std::sort(clusters.begin(), clusters.end(),
+                      [](const ClusterSpec& a, const ClusterSpec& b) { return a.symbol < b.symbol; });
+            spec.steps.push_back(clusters);
+        }
+        spec.special_multipliers = scriptData.special_multipliers;
+        spec.payout_id = scriptData.payout_id;
+        if (gameType == "free") {
+            for (const auto& row : final_board) {
+                spec.multiplier_count += static_cast<int>(std::count(row.begin(), row.end(), SlotSS02::get_multiplier_symbol()));
+            }
+        }
+        specs.push_back(spec);
+    }
+    return specs;
+}
+
+std::string makeSessionId(uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    uint64_t a = rng(), b = rng();
+    oss << std::setw(8) << (a >> 32) << "-" << std::setw(4) << ((a >> 16) & 0xFFFF) << "-"
+        << std::setw(4) << (a & 0xFFFF) << "-" << std::setw(4) << (b >> 48) << "-"
+        << std::setw(12) << (b & 0xFFFFFFFFFFFFULL);
+    return oss.str();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string inputFile;
+    std::string outputFile = "SS02_scripts_generated.json";
+    bool fromScripts = false;
+    uint64_t seed = 20251024;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--from-scripts") {
+            fromScripts = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (inputFile.empty()) {
+            inputFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_generate <compositions.json> [-o output.json] [--seed N] [--threads N] [--from-scripts]\n";
+            return 1;
+        }
+    }
+    if (inputFile.empty()) {
+        std::cerr << "Usage: SS02_generate <compositions.json> [-o output.json] [--seed N] [--threads N] [--from-scripts]\n";
+        return 1;
+    }
+
+    std::cout << "=== SS02 Script Generator ===\n\n";
+    auto start = std::chrono::steady_clock::now();
+
+    try {
+        std::vector<CompositionSpec> baseSpecs, freeSpecs;
+        if (fromScripts) {
+            auto config = ScriptApp::ScriptConfig::loadFromFile(inputFile);
+            baseSpecs = compositionsFromScripts(config.base_scripts, "base");
+            freeSpecs = compositionsFromScripts(config.free_scripts, "free");
+        } else {
+            std::ifstream file(inputFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Unable to open composition file: " + inputFile);
+            }
+            nlohmann::json j;
+            file >> j;
+            baseSpecs = readCompositions(j, "base");
+            freeSpecs = readCompositions(j, "free");
+        }
+
+        // Expand repeats into jobs; output order is fixed before any thread starts
+        std::vector<Job> jobs;
+        int baseCount = 0, freeCount = 0;
+        for (size_t i = 0; i < baseSpecs.size(); ++i) {
+            for (int r = 0; r < baseSpecs[i].repeat; ++r) jobs.push_back({false, i, baseCount++});
+        }
+        for (size_t i = 0; i < freeSpecs.size(); ++i) {
+            for (int r = 0; r < freeSpecs[i].repeat; ++r) jobs.push_back({true, i, freeCount++});
+        }
+        std::cout << "Base compositions: " << baseSpecs.size() << " (" << baseCount << " scripts)\n";
+        std::cout << "Free compositions: " << freeSpecs.size() << " (" << freeCount << " scripts)\n";
+        std::cout << "Threads: " << threads << ", seed: " << seed << "\n";
+
+        std::vector<GeneratedScript> baseOut(baseCount), freeOut(freeCount);
+        std::atomic<size_t> nextJob{0};
+        std::mutex errorMutex;
+        std::vector<std::string> errors;
+
+        auto worker = [&]() {
+            SS02ScriptGenerator baseGen("base", seed), freeGen("free", seed);
+            for (size_t j = nextJob++; j < jobs.size(); j = nextJob++) {
+                const Job& job = jobs[j];
+                auto& gen = job.isFree ? freeGen : baseGen;
+                const auto& spec = job.isFree ? freeSpecs[job.composition] : baseSpecs[job.composition];
+                gen.reseed(mixSeed(seed, j));
+                try {
+                    (job.isFree ? freeOut : baseOut)[job.outputIndex] = gen.generate(spec);
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    errors.push_back(std::string(job.isFree ? "free" : "base") + " composition " +
+                                     std::to_string(job.composition) + ": " + e.what());
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+
+        if (!errors.empty()) {
+            for (size_t i = 0; i < errors.size() && i < 5; ++i) std::cerr << "❌ " << errors[i] << "\n";
+            throw std::runtime_error(std::to_string(errors.size()) + " scripts could not be generated");
+        }
+
+        // First boards must be unique within a section; regenerate any collision against the
+        // boards kept so far (zero-payout scripts draw an unseen terminal board directly)
+        int regenerated = 0;
+        auto ensureUnique = [&](std::vector<GeneratedScript>& out, const std::vector<CompositionSpec>& specs,
+                                const std::string& gameType, bool isFree) {
+            SS02ScriptGenerator gen(gameType, seed);
+            BoardHashIndex seen;
+            size_t jobBase = isFree ? static_cast<size_t>(baseCount) : 0;
+            for (size_t i = 0; i < out.size(); ++i) {
+                if (seen.insert(out[i].script[0])) continue;
+                gen.reseed(mixSeed(seed ^ 0xD1B54A32D192ED03ULL, jobBase + i));
+                out[i] = gen.generateUnique(specs[jobs[jobBase + i].composition], seen);
+                regenerated++;
+            }
+        };
+        ensureUnique(baseOut, baseSpecs, "base", false);
+        ensureUnique(freeOut, freeSpecs, "free", true);
+
+        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        nlohmann::json output;
+        output["session_id"] = makeSessionId(seed);
+        output["game_type"] = "SS02";
+        output["base"] = nlohmann::json::array();
+        output["free"] = nlohmann::json::array();
+        int baseZero = 0, freeZero = 0;
+        for (size_t i = 0; i < baseOut.size(); ++i) {
+            output["base"].push_back(baseOut[i].toJson(static_cast<int>(i)));
+            if (baseOut[i].payout == 0) baseZero++;
+        }
+        for (size_t i = 0; i < freeOut.size(); ++i) {
+            output["free"].push_back(freeOut[i].toJson(static_cast<int>(i)));
+            if (freeOut[i].payout == 0) freeZero++;
+        }
+
+        std::time_t now = std::time(nullptr);
+        char generatedAt[32];
+        std::strftime(generatedAt, sizeof(generatedAt), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        auto countCompositions = [](const std::vector<CompositionSpec>& specs) {
+            std::set<int> ids;
+            for (const auto& spec : specs) if (!spec.steps.empty()) ids.insert(spec.payout_id);
+            return static_cast<int>(ids.size());
+        };
+        output["metadata"] = {
+            {"total_base_scripts", baseOut.size()},
+            {"total_free_scripts", freeOut.size()},
+            {"generated_at", generatedAt},
+            {"duration_seconds", duration},
+            {"enable_fg", !freeOut.empty()},
+            {"bg_compositions", countCompositions(baseSpecs)},
+            {"fg_compositions", countCompositions(freeSpecs)},
+            {"bg_zero_payout_number", baseZero},
+            {"fg_zero_payout_number", freeZero}
+        };
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        outFile << output.dump(2) << "\n";
+        outFile.close();
+
+        std::cout << "\n✅ Generated " << baseOut.size() << " base and " << freeOut.size() << " free scripts in "
+                  << std::fixed << std::setprecision(3) << duration << " s\n";
+        std::cout << "   Zero-payout scripts: base " << baseZero << ", free " << freeZero << "\n";
+        if (regenerated > 0) {
+            std::cout << "   Regenerated " << regenerated << " scripts with duplicate first boards\n";
+        }
+        std::cout << "   Output: " << outputFile << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
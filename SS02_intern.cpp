@@ -0,0 +1,174 @@
+#include "SS02Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include "BoardPool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+
+// Loads one or more script files into a shared board pool (BoardPool.hpp) and reports how
+// much storage interning saves over per-script Board vectors. Every script is then evaluated
+// with the memoizing InternedEvaluator and cross-checked against the batch engine and, where
+// the file carries them, the expected payouts and stops.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+double mb(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+struct PassResult {
+    double ms = 0.0;
+    size_t disagreements = 0;      // InternedEvaluator vs SS02BatchEvaluator
+    size_t payoutMismatches = 0;   // Against the file's payout / stop
+    size_t stopMismatches = 0;
+};
+
+// One pass over all scripts; `evaluators` keep their memo across passes
+PassResult evaluateAll(const InternedScriptSet& set, InternedEvaluator& baseEval, InternedEvaluator& freeEval,
+                       const std::vector<BatchScriptResult>* reference, std::vector<BatchScriptResult>& results) {
+    PassResult pass;
+    results.resize(set.scripts.size());
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < set.scripts.size(); ++i) {
+        const InternedScript& s = set.scripts[i];
+        results[i] = (s.is_free ? freeEval : baseEval).evaluate(set.ids(s), static_cast<int>(s.board_count), s.special_multipliers);
+    }
+    pass.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    for (size_t i = 0; i < set.scripts.size(); ++i) {
+        const InternedScript& s = set.scripts[i];
+        const BatchScriptResult& r = results[i];
+        if (reference) {
+            const BatchScriptResult& b = (*reference)[i];
+            if (r.score != b.score || r.stop != b.stop || r.cascade_match != b.cascade_match) pass.disagreements++;
+        }
+        if (s.has_payout && r.score != s.payout) pass.payoutMismatches++;
+        if (r.stop != s.stop) pass.stopMismatches++;
+    }
+    return pass;
+}
+
+// Batch engine over the same scripts, boards gathered into contiguous packed buffers
+std::vector<BatchScriptResult> evaluateBatch(const InternedScriptSet& set, double& ms) {
+    SlotSS02 baseGame(true, 20.0f, "base"), freeGame(true, 20.0f, "free");
+    SS02BatchEvaluator baseEval(baseGame), freeEval(freeGame);
+    std::vector<BatchScriptResult> results(set.scripts.size());
+    auto start = std::chrono::steady_clock::now();
+    for (bool isFree : {false, true}) {
+        std::vector<uint8_t> cells;
+        std::vector<size_t> which, offsets;
+        for (size_t i = 0; i < set.scripts.size(); ++i) {
+            const InternedScript& s = set.scripts[i];
+            if (s.is_free != isFree) continue;
+            which.push_back(i);
+            offsets.push_back(cells.size());
+            for (uint32_t b = 0; b < s.board_count; ++b) {
+                const uint8_t* c = set.pool.cells(set.ids(s)[b]);
+                cells.insert(cells.end(), c, c + BoardPool::CELLS);
+            }
+        }
+        std::vector<PackedScript> packed(which.size());
+        for (size_t k = 0; k < which.size(); ++k) {
+            packed[k].boards = cells.data() + offsets[k];
+            packed[k].board_count = static_cast<int>(set.scripts[which[k]].board_count);
+            packed[k].special_multipliers = set.scripts[which[k]].special_multipliers;
+        }
+        std::vector<BatchScriptResult> section(packed.size());
+        (isFree ? freeEval : baseEval).evaluate(packed.data(), packed.size(), section.data());
+        for (size_t k = 0; k < which.size(); ++k) results[which[k]] = section[k];
+    }
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return results;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            std::cerr << "Usage: SS02_intern [scripts.json ...]   (default: SS02_scripts.json FG_hist/Script*.json)\n";
+            return 1;
+        }
+    }
+    if (files.empty()) {
+        files.push_back("SS02_scripts.json");
+        std::vector<std::string> hist;
+        if (fs::is_directory("FG_hist")) {
+            for (const auto& entry : fs::directory_iterator("FG_hist")) {
+                const std::string name = entry.path().filename().string();
+                if (name.rfind("Script", 0) == 0 && entry.path().extension() == ".json") hist.push_back(entry.path().string());
+            }
+        }
+        std::sort(hist.begin(), hist.end());
+        files.insert(files.end(), hist.begin(), hist.end());
+    }
+
+    std::cout << "=== SS02 Board Interning ===\n\n";
+
+    try {
+        InternedScriptSet set;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& file : files) {
+            const size_t boardsBefore = set.pool.size(), refsBefore = set.boardIds.size();
+            const size_t added = set.loadFile(file);
+            const size_t refs = set.boardIds.size() - refsBefore;
+            const size_t distinct = set.pool.size() - boardsBefore;
+            std::cout << "  " << std::left << std::setw(28) << file << std::right << std::setw(6) << added << " scripts, "
+                      << std::setw(7) << refs << " boards, " << std::setw(7) << distinct << " new ("
+                      << std::fixed << std::setprecision(1) << (refs > 0 ? 100.0 * (refs - distinct) / refs : 0.0)
+                      << "% already pooled)\n";
+        }
+        double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        size_t singleBoard = 0;
+        for (const auto& s : set.scripts) {
+            if (s.board_count == 1) singleBoard++;
+        }
+        std::cout << "\nScripts: " << set.scripts.size() << " (" << singleBoard << " single-board)\n";
+        std::cout << "Boards:  " << set.boardIds.size() << " referenced, " << set.pool.size() << " distinct ("
+                  << std::setprecision(2) << (set.pool.size() > 0 ? static_cast<double>(set.boardIds.size()) / set.pool.size() : 0.0)
+                  << "x reuse)\n";
+        std::cout << "Memory:  " << std::setprecision(2) << mb(set.bytes()) << " MB interned vs "
+                  << mb(set.expandedBytes()) << " MB as Board vectors ("
+                  << std::setprecision(1) << (set.bytes() > 0 ? static_cast<double>(set.expandedBytes()) / set.bytes() : 0.0)
+                  << "x smaller, allocator overhead not counted)\n";
+        std::cout << "Load:    " << std::setprecision(1) << loadMs << " ms\n\n";
+
+        double batchMs = 0.0;
+        std::vector<BatchScriptResult> reference = evaluateBatch(set, batchMs);
+
+        SlotSS02 baseGame(true, 20.0f, "base"), freeGame(true, 20.0f, "free");
+        InternedEvaluator baseEval(baseGame, set.pool), freeEval(freeGame, set.pool);
+        std::vector<BatchScriptResult> results;
+        PassResult cold = evaluateAll(set, baseEval, freeEval, &reference, results);
+        const size_t analyzed = baseEval.boardsAnalyzed() + freeEval.boardsAnalyzed();
+        const size_t steps = baseEval.stepsEvaluated() + freeEval.stepsEvaluated();
+        PassResult warm = evaluateAll(set, baseEval, freeEval, &reference, results);
+
+        std::cout << "Cascade steps:   " << steps << " evaluated, " << analyzed << " distinct boards analyzed ("
+                  << std::setprecision(1) << (steps > 0 ? 100.0 * (1.0 - static_cast<double>(analyzed) / (steps + set.scripts.size())) : 0.0)
+                  << "% of board evaluations memoized)\n";
+        std::cout << "Interned (cold): " << std::setprecision(1) << cold.ms << " ms\n";
+        std::cout << "Interned (warm): " << warm.ms << " ms\n";
+        std::cout << "Batch engine:    " << batchMs << " ms (" << SS02BatchEvaluator::isa_name() << ", incl. gathering boards)\n\n";
+
+        std::cout << "Payout mismatches: " << cold.payoutMismatches << ", stop mismatches: " << cold.stopMismatches << "\n";
+        if (cold.disagreements == 0 && warm.disagreements == 0) {
+            std::cout << "✅ Interned evaluation agrees with the batch engine on all " << set.scripts.size() << " scripts\n";
+            return cold.payoutMismatches + cold.stopMismatches == 0 ? 0 : 1;
+        }
+        std::cout << "❌ " << cold.disagreements << " scripts disagree with the batch engine\n";
+        return 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
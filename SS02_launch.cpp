@@ -0,0 +1,330 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "SS02Simulator.hpp"
+#include "OutcomeFile.h"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <thread>
+#include <algorithm>
+#include <map>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Multi-process Monte Carlo RTP: the parent evaluates the scripts once into an outcome file
+// (OutcomeFile.h), maps it read-only and forks N worker processes. Each worker simulates a
+// disjoint, block-aligned range of batches - and so a disjoint set of the per-batch RNG
+// streams mixSeed(seed, b) - and saves its SimulationState as a checkpoint. The parent merges
+// the shard states in batch order, which gives exactly the result of a single-process run of
+// the same seed and trial count (--verify runs that too and compares them bit for bit).
+// Workers checkpoint periodically; --resume continues every shard from its last checkpoint.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Shard {
+    uint64_t first = 0, end = 0;   // Batches [first, end)
+    std::string path;
+};
+
+struct WorkerJob {
+    SimulationMode mode = SimulationMode::Spin;
+    uint64_t trials = 0;
+    uint64_t seed = 0;
+    unsigned threads = 1;
+    double checkpointInterval = 300.0;
+    bool resume = false;
+};
+
+// Contiguous runs of whole blocks, as even as possible; the last shard ends at the last batch
+std::vector<Shard> planShards(uint64_t trials, unsigned workers, const std::string& dir) {
+    const uint64_t batches = (trials + SessionSimulator::BATCH - 1) / SessionSimulator::BATCH;
+    const uint64_t blocks = (batches + SimulationState::BLOCK_BATCHES - 1) / SimulationState::BLOCK_BATCHES;
+    std::vector<Shard> shards;
+    for (uint64_t w = 0; w < workers; ++w) {
+        const uint64_t b0 = blocks * w / workers, b1 = blocks * (w + 1) / workers;
+        if (b0 == b1) continue;
+        Shard shard;
+        shard.first = b0 * SimulationState::BLOCK_BATCHES;
+        shard.end = std::min(b1 * SimulationState::BLOCK_BATCHES, batches);
+        shard.path = (fs::path(dir) / ("shard_" + std::to_string(shard.first) + "_" + std::to_string(shard.end) + ".ckpt")).string();
+        shards.push_back(shard);
+    }
+    return shards;
+}
+
+// Body of a forked worker; returns its exit code
+int runShard(const SessionSimulator& simulator, const WorkerJob& job, const Shard& shard, uint64_t fingerprint) {
+    try {
+        SimulationState state;
+        state.firstBatch = state.nextBatch = shard.first;
+        if (job.resume && fs::exists(shard.path)) {
+            state = SimulationState::load(shard.path, fingerprint);
+        }
+        StoppingRule rule;
+        rule.halfWidth = 0.0;
+        rule.minTrials = 0;
+        rule.maxTrials = std::min(job.trials, shard.end * SessionSimulator::BATCH);
+
+        auto lastSave = std::chrono::steady_clock::now();
+        simulator.runUntil(job.mode, rule, job.seed, job.threads, state, [&](const SimulationState& current) {
+            const auto now = std::chrono::steady_clock::now();
+            if (std::chrono::duration<double>(now - lastSave).count() < job.checkpointInterval) return;
+            current.save(shard.path);
+            lastSave = now;
+        });
+        state.save(shard.path);
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: worker for batches " << shard.first << "-" << shard.end << ": " << e.what() << "\n";
+        return 1;
+    }
+}
+
+bool identical(const SimulationStats& a, const SimulationStats& b) {
+    return a.trials == b.trials && a.mean == b.mean && a.m2 == b.m2 && a.maxWin == b.maxWin &&
+           a.histogram == b.histogram && a.batches == b.batches && a.batchMean == b.batchMean && a.batchM2 == b.batchM2;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string outputFile = "SS02_launch.json";
+    std::string outcomesFile = "SS02_outcomes.bin";
+    std::string shardDir = "SS02_launch_shards";
+    std::string tableFile;
+    std::string modeName = "spin";
+    double cost = -1.0;
+    double confidence = 0.99;
+    bool verify = false;
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    VarianceReduction reduction;
+    WorkerJob job;
+    job.trials = 1ULL << 28;
+    job.seed = 12345;
+
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters params = RtpParameters::fromGame(game);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--workers" && i + 1 < argc) {
+            workers = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            job.threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--trials" && i + 1 < argc) {
+            job.trials = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            job.seed = std::stoull(argv[++i]);
+        } else if (arg == "--mode" && i + 1 < argc) {
+            modeName = argv[++i];
+        } else if (arg == "--confidence" && i + 1 < argc) {
+            confidence = std::stod(argv[++i]);
+        } else if (arg == "--stratify") {
+            reduction.stratify = true;
+        } else if (arg == "--is-trigger" && i + 1 < argc) {
+            reduction.triggerRate = std::stod(argv[++i]);
+        } else if (arg == "--is-multiplier" && i + 1 < argc) {
+            reduction.multiplierTilt = std::stod(argv[++i]);
+        } else if (arg == "--control-variate") {
+            reduction.controlVariate = true;
+        } else if (arg == "--trigger" && i + 1 < argc) {
+            params.fgTrigger = std::stod(argv[++i]);
+        } else if (arg == "--retrigger" && i + 1 < argc) {
+            params.fgRetrigger = std::stod(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            params.fgRounds = std::stoi(argv[++i]);
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            params.volatility = argv[++i];
+        } else if (arg == "--multiplier-table" && i + 1 < argc) {
+            tableFile = argv[++i];
+        } else if (arg == "--cost" && i + 1 < argc) {
+            cost = std::stod(argv[++i]);
+        } else if (arg == "--outcomes" && i + 1 < argc) {
+            outcomesFile = argv[++i];
+        } else if (arg == "--shard-dir" && i + 1 < argc) {
+            shardDir = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            job.checkpointInterval = std::stod(argv[++i]);
+        } else if (arg == "--resume") {
+            job.resume = true;
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_launch [scripts.json] [--workers N] [--threads N] [--trials N] [--seed N]"
+                         " [--mode spin|buy] [--confidence C] [--stratify] [--is-trigger Q] [--is-multiplier TILT]"
+                         " [--control-variate] [--trigger P] [--retrigger P] [--rounds N] [--volatility low|high]"
+                         " [--multiplier-table FILE] [--cost BETS] [--outcomes FILE] [--shard-dir DIR]"
+                         " [--checkpoint-interval SEC] [--resume] [--verify] [-o output.json]\n";
+            return 1;
+        }
+    }
+    if (modeName != "spin" && modeName != "buy") {
+        std::cerr << "Error: mode must be spin or buy\n";
+        return 1;
+    }
+    if (job.trials == 0) {
+        std::cerr << "Error: --trials must be positive\n";
+        return 1;
+    }
+    job.mode = modeName == "buy" ? SimulationMode::Buy : SimulationMode::Spin;
+
+    std::cout << "=== SS02 Multi-Process Simulation ===\n\n";
+
+    try {
+        auto config = loadSS02Scripts(scriptsFile);
+        params.buyCost = cost > 0.0 ? cost : config.buy_free_game_multiplier;
+        if (!tableFile.empty()) {
+            std::ifstream file(tableFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open " + tableFile);
+            }
+            file >> params.multiplierTable;
+        }
+
+        // The parent's cache only lives long enough for the exact solve and the outcome file
+        double exactRtp = 0.0;
+        {
+            ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+            RtpReport report = SS02AnalyticRtp(cache).solve(params, 0);
+            exactRtp = job.mode == SimulationMode::Buy ? report.buyRtp : report.rtp;
+            OutcomeFile::write(outcomesFile, cache);
+        }
+        OutcomeFile::Mapping outcomes(outcomesFile);
+        SessionSimulator simulator(outcomes.view(), params, reduction);
+        const uint64_t fingerprint = simulator.fingerprint(job.mode, job.seed);
+        const double stake = simulator.stake(job.mode);
+
+        const std::vector<Shard> shards = planShards(job.trials, workers, shardDir);
+        fs::create_directories(shardDir);
+        std::cout << "Outcomes: " << outcomesFile << " (" << outcomes.view().base.size() << " base, "
+                  << outcomes.view().free.size() << " free, " << outcomes.view().buy.size() << " buy), mapped read-only\n"
+                  << "Mode: " << modeName << ", " << job.trials << " trials, seed " << job.seed << ", " << shards.size()
+                  << " workers x " << job.threads << " threads\n\n";
+
+        // Fork from a single-threaded parent; workers leave through _exit so they never flush
+        // or destroy the parent's state
+        auto start = std::chrono::steady_clock::now();
+        std::cout.flush();
+        std::map<pid_t, size_t> running;
+        for (size_t w = 0; w < shards.size(); ++w) {
+            const pid_t pid = ::fork();
+            if (pid < 0) {
+                throw std::runtime_error("fork failed");
+            }
+            if (pid == 0) {
+                ::_exit(runShard(simulator, job, shards[w], fingerprint));
+            }
+            running[pid] = w;
+        }
+        int failed = 0;
+        while (!running.empty()) {
+            int status = 0;
+            const pid_t pid = ::wait(&status);
+            if (pid < 0) {
+                throw std::runtime_error("wait failed");
+            }
+            auto it = running.find(pid);
+            if (it == running.end()) continue;
+            const Shard& shard = shards[it->second];
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                std::cout << "✅ Worker " << it->second << " (batches " << shard.first << "-" << shard.end << ") done after "
+                          << std::fixed << std::setprecision(1) << seconds << " s\n";
+            } else {
+                std::cout << "❌ Worker " << it->second << " (batches " << shard.first << "-" << shard.end << ") failed\n";
+                failed++;
+            }
+            running.erase(it);
+        }
+        if (failed > 0) {
+            throw std::runtime_error(std::to_string(failed) + " workers failed; rerun with --resume to continue from their checkpoints");
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // Merge in batch order, then let runUntil compute the interval on the complete state
+        SimulationState state = SimulationState::load(shards.front().path, fingerprint);
+        for (size_t w = 1; w < shards.size(); ++w) state.merge(SimulationState::load(shards[w].path, fingerprint));
+        StoppingRule fixed;
+        fixed.halfWidth = 0.0;
+        fixed.confidence = confidence;
+        fixed.minTrials = fixed.maxTrials = job.trials;
+        SimulationRun run = simulator.runUntil(job.mode, fixed, job.seed, 1, state);
+        const SimulationStats& s = run.stats;
+        if (s.trials != job.trials) {
+            throw std::runtime_error("Merged shards hold " + std::to_string(s.trials) + " trials, expected " +
+                                     std::to_string(job.trials));
+        }
+        const double rtp = s.mean / stake;
+        const double se = run.halfWidth / fixed.zScore();
+
+        std::cout << "\nTrials:     " << s.trials << " in " << std::setprecision(1) << ms / 1000.0 << " s ("
+                  << std::setprecision(0) << s.trials / (ms / 1000.0) << "/s)\n"
+                  << std::setprecision(6) << "RTP:        " << rtp << " +- " << run.halfWidth << " ("
+                  << std::setprecision(2) << confidence * 100.0 << "%)\n"
+                  << std::setprecision(6) << "Exact RTP:  " << exactRtp << "\n"
+                  << std::setprecision(2) << "Max win:    " << s.maxWin / stake << "x stake\n";
+
+        int mismatch = 0;
+        if (std::abs(rtp - exactRtp) <= 4.0 * se + 1e-12) {
+            std::cout << "✅ Simulated RTP within 4 standard errors of the exact RTP\n";
+        } else {
+            std::cout << "❌ Simulated RTP differs from the exact RTP by more than 4 standard errors\n";
+            mismatch = 1;
+        }
+        bool same = false;
+        if (verify) {
+            start = std::chrono::steady_clock::now();
+            const SimulationStats single = simulator.run(job.mode, job.trials, job.seed, workers * job.threads);
+            const double singleMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            same = identical(single, s);
+            if (same) {
+                std::cout << "✅ Identical to the single-process run (" << std::setprecision(1) << singleMs / 1000.0 << " s)\n";
+            } else {
+                std::cout << "❌ Merged result differs from the single-process run\n";
+                mismatch = 1;
+            }
+        }
+
+        nlohmann::json out;
+        out["scripts_file"] = scriptsFile;
+        out["outcomes_file"] = outcomesFile;
+        out["mode"] = modeName;
+        out["seed"] = job.seed;
+        out["workers"] = shards.size();
+        nlohmann::json shardList = nlohmann::json::array();
+        for (const auto& shard : shards) shardList.push_back({{"batches", {shard.first, shard.end}}, {"checkpoint", shard.path}});
+        out["shards"] = shardList;
+        out["trials"] = s.trials;
+        out["rtp"] = rtp;
+        out["half_width"] = run.halfWidth;
+        out["confidence"] = confidence;
+        out["exact_rtp"] = exactRtp;
+        out["std_dev"] = std::sqrt(s.variance());
+        out["max_win"] = s.maxWin;
+        out["win_over_stake_histogram"] = s.histogram;
+        if (verify) out["identical_to_single_process"] = same;
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        file << out.dump(2) << "\n";
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return mismatch;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
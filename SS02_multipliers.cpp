@@ -0,0 +1,195 @@
+#include "MultiplierOptimizer.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+// Tunes the integer weights of the free game multiplier tables (ids 1 and 2, multipliers
+// 102-200) against the free scripts' base payouts and multiple_table assignments, so that
+// the FG RTP lands in the GameConfig.json window, the free session std dev matches a target
+// and no single free spin can win more than FG_max (a per-spin cap, as in SS02_select and
+// SS02_enumerate; a session of several spins may exceed it). Candidates are scored with the closed-form
+// moments of MultiplierOptimizer; the winner is re-checked with SS02AnalyticRtp. --fg-rtp
+// replaces the window with RTP +- 0.0005.
+
+namespace {
+
+void printWeights(const MultiplierOptimizer& optimizer, const std::vector<std::vector<int>>& weights) {
+    for (size_t t = 0; t < optimizer.tableCount(); ++t) {
+        std::cout << "  Table " << optimizer.tableId(t) << ":";
+        for (size_t i = 0; i < weights[t].size(); ++i) {
+            std::cout << " " << optimizer.multipliers(t)[i] << "x" << weights[t][i]
+                      << (optimizer.allowed(t, i) ? "" : "*");
+        }
+        std::cout << (optimizer.used(t) ? "" : "   (no script draws from this table, left unchanged)") << "\n";
+    }
+}
+
+void printResult(const std::string& label, const MultiplierResult& r) {
+    std::cout << std::left << std::setw(10) << label << std::right << std::fixed << std::setprecision(5)
+              << "FG RTP " << r.freeRtp << std::setprecision(2) << "   spin mean " << r.freeSpinMean
+              << "   session mean " << r.sessionMean << "   session SD " << std::sqrt(r.sessionVariance)
+              << "   max win " << r.maxWin << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string gameConfigFile = "Backup/GameConfig.json";
+    std::string outputFile = "SS02_multiplier_table_tuned.json";
+    std::string volatility;
+    double fgRtp = -1.0;
+    double fgStdDev = -1.0;
+    double maxWin = -1.0;
+    double stdDevWeight = 1.0;
+    int maxWeight = 20;
+    int restarts = 16;
+    int iterations = 200000;
+    uint64_t seed = 12345;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--game-config" && i + 1 < argc) {
+            gameConfigFile = argv[++i];
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            volatility = argv[++i];
+        } else if (arg == "--fg-rtp" && i + 1 < argc) {
+            fgRtp = std::stod(argv[++i]);
+        } else if (arg == "--fg-sd" && i + 1 < argc) {
+            fgStdDev = std::stod(argv[++i]);
+        } else if (arg == "--sd-weight" && i + 1 < argc) {
+            stdDevWeight = std::stod(argv[++i]);
+        } else if (arg == "--max-win" && i + 1 < argc) {
+            maxWin = std::stod(argv[++i]);
+        } else if (arg == "--max-weight" && i + 1 < argc) {
+            maxWeight = std::stoi(argv[++i]);
+        } else if (arg == "--restarts" && i + 1 < argc) {
+            restarts = std::stoi(argv[++i]);
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_multipliers [scripts.json] [--game-config GameConfig.json] [--volatility low|high]"
+                         " [--fg-rtp RTP] [--fg-sd SD] [--sd-weight W] [--max-win PAYOUT] [--max-weight N]"
+                         " [--restarts N] [--iterations N] [--seed N] [--threads N] [-o output.json]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Multiplier Table Optimizer ===\n\n";
+
+    try {
+        SlotSS02 game(true, 20.0f, "free");
+        RtpParameters params = RtpParameters::fromGame(game);
+        if (!volatility.empty()) params.volatility = volatility;
+
+        // FG RTP window, free game structure and max win from GameConfig.json
+        MultiplierTarget target;
+        std::ifstream configFile(gameConfigFile);
+        if (configFile.is_open()) {
+            nlohmann::json gameConfig;
+            configFile >> gameConfig;
+            target = MultiplierTarget::fromGameConfig(gameConfig);
+            params.bet = gameConfig.value("base_bet", params.bet);
+            params.fgTrigger = gameConfig.value("FG_trigger", params.fgTrigger);
+            params.fgRetrigger = gameConfig.value("FG_retrigger", params.fgRetrigger);
+            params.fgRounds = gameConfig.value("FG_rounds", params.fgRounds);
+            std::cout << "Game config: " << gameConfigFile << "\n";
+        } else if (fgRtp < 0.0) {
+            throw std::runtime_error("Cannot open " + gameConfigFile + "; pass --fg-rtp instead");
+        }
+        if (fgRtp >= 0.0) {
+            target.freeRtpMin = fgRtp - 0.0005;
+            target.freeRtpMax = fgRtp + 0.0005;
+        }
+        if (maxWin >= 0.0) target.maxWin = maxWin;
+        target.stdDevWeight = stdDevWeight;
+
+        auto start = std::chrono::steady_clock::now();
+        auto config = loadSS02Scripts(scriptsFile);
+        ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+        const nlohmann::json startTables = params.multiplierTables();
+
+        // The session std dev target defaults to that of the live tables, before any clamping
+        MultiplierOptimizer baseline(cache, params, startTables, target, maxWeight);
+        const MultiplierResult current = baseline.evaluate(baseline.liveWeights());
+        target.sessionStdDev = fgStdDev >= 0.0 ? fgStdDev : std::sqrt(current.sessionVariance);
+        MultiplierOptimizer optimizer(cache, params, startTables, target, maxWeight);
+        double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Scripts: " << cache.free.size() << " free (" << std::fixed << std::setprecision(1) << loadMs
+                  << " ms to evaluate)\n";
+        std::cout << "Free games: trigger " << std::setprecision(4) << params.fgTrigger << ", " << params.fgRounds
+                  << " rounds, retrigger " << params.fgRetrigger << ", bet " << std::setprecision(0) << params.bet << "\n";
+        std::cout << "Target: FG RTP [" << std::setprecision(5) << target.freeRtpMin << ", " << target.freeRtpMax
+                  << "], session SD " << std::setprecision(2) << target.sessionStdDev << ", max win per spin "
+                  << (target.maxWin > 0.0 ? std::to_string(static_cast<long long>(target.maxWin)) : "none") << "\n\n";
+
+        std::cout << "Live tables (" << params.volatility << "), * = over the max win:\n";
+        printWeights(optimizer, optimizer.liveWeights());
+        printResult("Start", current);
+        if (optimizer.initialWeights() != optimizer.liveWeights()) {
+            std::cout << "Search starts from the live tables with * entries zeroed and weights clamped to "
+                      << maxWeight << "\n";
+        }
+
+        start = std::chrono::steady_clock::now();
+        MultiplierResult best = optimizer.optimize(threads, seed, restarts, iterations);
+        double searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "\nSearched " << restarts << " x " << iterations << " moves in " << std::setprecision(1) << searchMs
+                  << " ms (" << threads << " threads)\n\nTuned tables:\n";
+        printWeights(optimizer, best.weights);
+        printResult("Tuned", best);
+
+        // The closed-form moments must agree with the full analytic solve
+        const nlohmann::json tuned = optimizer.toJson(best.weights);
+        params.multiplierTable = tuned;
+        RtpReport report = SS02AnalyticRtp(cache).solve(params, 0);
+        const double rtpError = std::abs(report.freeRtp - best.freeRtp);
+        const double sdError = std::abs(std::sqrt(report.sessionVariance) - std::sqrt(best.sessionVariance));
+        int failed = 0;
+        if (rtpError <= 1e-9 && sdError <= 1e-6 * std::max(1.0, std::sqrt(report.sessionVariance))) {
+            std::cout << "✅ SS02AnalyticRtp agrees: FG RTP " << std::setprecision(5) << report.freeRtp << ", total RTP "
+                      << report.rtp << "\n";
+        } else {
+            std::cout << "❌ SS02AnalyticRtp disagrees: FG RTP " << std::setprecision(8) << report.freeRtp
+                      << ", session SD " << std::sqrt(report.sessionVariance) << "\n";
+            failed = 1;
+        }
+        if (best.feasible) {
+            std::cout << "✅ FG RTP within the target window and max win within the cap\n";
+        } else {
+            std::cout << "⚠️  No weights reach the target window under the cap; closest found is shown\n";
+        }
+
+        nlohmann::json out = tuned;
+        out["volatility_start"] = params.volatility;
+        out["fg_rtp"] = best.freeRtp;
+        out["session_std_dev"] = std::sqrt(best.sessionVariance);
+        out["max_win"] = best.maxWin;
+        out["feasible"] = best.feasible;
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        file << out.dump(2) << "\n";
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return failed;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
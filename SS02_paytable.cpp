@@ -0,0 +1,162 @@
+#include "SS02Rescore.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+// What-if pay tables: records every script's cascade as a (symbol, cluster size) histogram
+// once, then rescores the whole script set under each candidate pay table without running a
+// cascade again. Reports RTP (SS02AnalyticRtp), payout variance and how many scripts would
+// no longer pay their recorded payout. The game's current table is always the first row.
+
+namespace {
+
+struct SectionStats {
+    double mean = 0.0;
+    double variance = 0.0;
+    size_t mismatches = 0;   // Rescored payout != payout recorded in the script file
+};
+
+SectionStats sectionStats(const ClusterHistogram& h, const std::vector<double>& payouts, size_t candidate, bool isFree) {
+    SectionStats s;
+    const size_t begin = isFree ? h.baseRows : 0, end = isFree ? h.rows() : h.baseRows;
+    if (end == begin) return s;
+    double sum = 0.0, sumSq = 0.0;
+    for (size_t r = begin; r < end; ++r) {
+        const double p = payouts[candidate * h.rows() + r];
+        sum += p;
+        sumSq += p * p;
+        if (p != h.recordedPayout[r]) s.mismatches++;
+    }
+    const double n = static_cast<double>(end - begin);
+    s.mean = sum / n;
+    s.variance = std::max(0.0, sumSq / n - s.mean * s.mean);
+    return s;
+}
+
+// "SYMBOL:FACTOR[,SYMBOL:FACTOR...]" -> a candidate scaling those symbols' pays
+PayTable scaledCandidate(const PayTable& defaults, const std::string& text) {
+    PayTable table = defaults;
+    table.name = "scale " + text;
+    std::istringstream iss(text);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        size_t colon = item.find(':');
+        if (colon == std::string::npos) throw std::runtime_error("Expected SYMBOL:FACTOR, got " + item);
+        int symbol = std::stoi(item.substr(0, colon));
+        if (symbol < 0 || symbol >= SS02BatchEvaluator::NUM_SYMBOLS) throw std::runtime_error("Invalid symbol in " + item);
+        double factor = std::stod(item.substr(colon + 1));
+        for (double& pay : table.pay[symbol]) pay *= factor;
+    }
+    return table;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string candidatesFile;
+    std::string outputFile = "SS02_paytable.csv";
+    std::vector<std::string> scales;
+    bool drawMultipliers = true;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--candidates" && i + 1 < argc) {
+            candidatesFile = argv[++i];
+        } else if (arg == "--scale" && i + 1 < argc) {
+            scales.push_back(argv[++i]);
+        } else if (arg == "--flat-multipliers") {
+            drawMultipliers = false;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_paytable [scripts.json] [--candidates FILE] [--scale SYM:FACTOR[,...]]..."
+                         " [--flat-multipliers] [--threads N] [-o paytable.csv]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Pay Table Rescoring ===\n\n";
+
+    try {
+        SlotSS02 game(true, 20.0f, "free");
+        RtpParameters params = RtpParameters::fromGame(game);
+        params.drawMultipliers = drawMultipliers;
+
+        std::vector<PayTable> candidates{PayTable::fromGame(game)};
+        if (!candidatesFile.empty()) {
+            auto loaded = PayTable::loadCandidates(candidatesFile, candidates[0]);
+            candidates.insert(candidates.end(), loaded.begin(), loaded.end());
+        }
+        for (const auto& scale : scales) candidates.push_back(scaledCandidate(candidates[0], scale));
+
+        auto start = std::chrono::steady_clock::now();
+        auto config = loadSS02Scripts(scriptsFile);
+        ClusterHistogram histogram = ClusterHistogram::build(config);
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Scripts: " << histogram.baseRows << " base, " << histogram.rows() - histogram.baseRows << " free, "
+                  << histogram.feature.size() << " histogram entries (" << std::fixed << std::setprecision(1)
+                  << buildMs << " ms to record)\n";
+
+        start = std::chrono::steady_clock::now();
+        PayTableRescorer rescorer(histogram);
+        std::vector<double> payouts = rescorer.payouts(candidates, threads);
+        double rescoreMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Rescored " << candidates.size() << " pay tables in " << std::setprecision(2) << rescoreMs << " ms ("
+                  << threads << " threads)\n";
+
+        // The current table must reproduce the engine exactly
+        size_t disagreements = 0;
+        for (size_t r = 0; r < histogram.rows(); ++r) {
+            if (payouts[r] != histogram.enginePayout[r]) disagreements++;
+        }
+        if (disagreements == 0) {
+            std::cout << "✅ Current pay table reproduces the engine payout of all " << histogram.rows() << " scripts\n\n";
+        } else {
+            std::cout << "❌ Current pay table disagrees with the engine on " << disagreements << " scripts\n\n";
+        }
+
+        std::ofstream csv(outputFile);
+        if (!csv.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        csv << "name,rtp,base_rtp,free_rtp,spin_std_dev,base_mean,base_std_dev,free_mean,free_std_dev,"
+               "base_mismatches,free_mismatches\n";
+        csv << std::setprecision(10);
+
+        std::cout << std::left << std::setw(22) << "Pay table" << std::right << std::setw(9) << "RTP" << std::setw(9)
+                  << "Base" << std::setw(9) << "Free" << std::setw(10) << "SpinSD" << std::setw(10) << "BaseAvg"
+                  << std::setw(10) << "FreeAvg" << std::setw(10) << "BaseMism" << std::setw(10) << "FreeMism" << "\n";
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            RtpReport report = SS02AnalyticRtp(rescorer.outcomes(payouts, c)).solve(params, 0);
+            SectionStats base = sectionStats(histogram, payouts, c, false);
+            SectionStats free = sectionStats(histogram, payouts, c, true);
+
+            csv << candidates[c].name << "," << report.rtp << "," << report.baseRtp << "," << report.freeRtp << ","
+                << std::sqrt(report.spinVariance) << "," << base.mean << "," << std::sqrt(base.variance) << ","
+                << free.mean << "," << std::sqrt(free.variance) << "," << base.mismatches << "," << free.mismatches << "\n";
+
+            std::cout << std::left << std::setw(22) << candidates[c].name.substr(0, 21) << std::right << std::fixed
+                      << std::setprecision(4) << std::setw(9) << report.rtp << std::setw(9) << report.baseRtp
+                      << std::setw(9) << report.freeRtp << std::setprecision(2) << std::setw(10)
+                      << std::sqrt(report.spinVariance) << std::setw(10) << base.mean << std::setw(10) << free.mean
+                      << std::setw(10) << base.mismatches << std::setw(10) << free.mismatches << "\n";
+        }
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return disagreements == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
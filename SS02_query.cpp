@@ -0,0 +1,299 @@
+#include "ResultsTable.h"
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+
+// Filters and aggregates the columnar results written by SS02_test (script_results.ss02r)
+// without loading the JSON report, e.g. all free scripts paying over 1000 whose first board
+// has a symbol 0 cluster:
+//   SS02_query --section free --where "calculated_payout>1000" --symbol 0
+
+namespace {
+
+struct Condition {
+    std::string column;
+    std::string op;
+    double value = 0.0;
+};
+
+struct SymbolFilter {
+    int symbol = 0;
+    int minCount = 1;
+};
+
+const char* kColumns[] = {"index", "expected_payout", "calculated_payout", "expected_stop", "actual_stop", "pattern_count"};
+
+double columnValue(const ResultsTable& t, size_t row, const std::string& column) {
+    if (column == "index") return t.index[row];
+    if (column == "expected_payout") return t.expectedPayout[row];
+    if (column == "calculated_payout") return t.calculatedPayout[row];
+    if (column == "expected_stop") return t.expectedStop[row];
+    if (column == "actual_stop") return t.actualStop[row];
+    if (column == "pattern_count") return t.patternCount[row];
+    throw std::runtime_error("Unknown column: " + column);
+}
+
+std::string trim(const std::string& text) {
+    const size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+// "column op value", spaces around the operator allowed
+Condition parseCondition(const std::string& text) {
+    for (const char* op : {">=", "<=", "==", "!=", ">", "<"}) {
+        size_t pos = text.find(op);
+        if (pos == std::string::npos) continue;
+        Condition c;
+        c.column = trim(text.substr(0, pos));
+        c.op = op;
+        const std::string value = trim(text.substr(pos + c.op.size()));
+        size_t used = 0;
+        try {
+            c.value = std::stod(value, &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used == 0 || used != value.size()) {
+            throw std::runtime_error("Invalid value in condition: " + text);
+        }
+        bool known = false;
+        for (const char* column : kColumns) known = known || c.column == column;
+        if (!known) throw std::runtime_error("Unknown column: " + c.column);
+        return c;
+    }
+    throw std::runtime_error("Condition needs one of > >= < <= == !=: " + text);
+}
+
+bool holds(const Condition& c, double v) {
+    if (c.op == ">") return v > c.value;
+    if (c.op == ">=") return v >= c.value;
+    if (c.op == "<") return v < c.value;
+    if (c.op == "<=") return v <= c.value;
+    if (c.op == "==") return v == c.value;
+    return v != c.value;
+}
+
+SymbolFilter parseSymbol(const std::string& text) {
+    SymbolFilter f;
+    size_t colon = text.find(':');
+    try {
+        f.symbol = std::stoi(text.substr(0, colon));
+        if (colon != std::string::npos) f.minCount = std::stoi(text.substr(colon + 1));
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid symbol filter: " + text);
+    }
+    return f;
+}
+
+uint8_t parseMismatch(const std::string& text) {
+    if (text == "payout") return ResultsTable::PAYOUT_MISMATCH;
+    if (text == "stop") return ResultsTable::STOP_MISMATCH;
+    if (text == "cascade") return ResultsTable::CASCADING_MISMATCH;
+    if (text == "any") return ResultsTable::PAYOUT_MISMATCH | ResultsTable::STOP_MISMATCH | ResultsTable::CASCADING_MISMATCH;
+    throw std::runtime_error("Unknown mismatch kind: " + text + " (payout, stop, cascade or any)");
+}
+
+struct Aggregate {
+    size_t count = 0;
+    double expected = 0.0;
+    double calculated = 0.0;
+    double minPayout = std::numeric_limits<double>::infinity();
+    double maxPayout = -std::numeric_limits<double>::infinity();
+    size_t mismatches = 0;
+
+    void add(const ResultsTable& t, size_t row) {
+        count++;
+        expected += t.expectedPayout[row];
+        calculated += t.calculatedPayout[row];
+        minPayout = std::min(minPayout, t.calculatedPayout[row]);
+        maxPayout = std::max(maxPayout, t.calculatedPayout[row]);
+        if (t.mismatch[row] != 0) mismatches++;
+    }
+};
+
+// Group keys; a row lands in several symbol groups when its first board has several clusters
+std::vector<std::string> groupKeys(const ResultsTable& t, size_t row, const std::string& groupBy) {
+    if (groupBy == "section") return {t.isFree(row) ? "free" : "base"};
+    if (groupBy == "stop") return {std::to_string(t.actualStop[row])};
+    if (groupBy == "payout") {
+        // Decades of the calculated payout: 0, 1-9, 10-99, ...
+        double p = t.calculatedPayout[row];
+        if (p <= 0) return {"0"};
+        long long lo = 1;
+        while (lo * 10 <= p) lo *= 10;
+        return {std::to_string(lo) + "-" + std::to_string(lo * 10 - 1)};
+    }
+    if (groupBy == "symbol") {
+        std::vector<std::string> keys;
+        for (uint32_t p = 0; p < ResultsTable::MAX_PATTERNS; ++p) {
+            int16_t symbol = t.patternSymbol[row * ResultsTable::MAX_PATTERNS + p];
+            if (symbol >= 0) keys.push_back(std::to_string(symbol));
+        }
+        if (keys.empty()) keys.push_back("none");
+        return keys;
+    }
+    throw std::runtime_error("Unknown group: " + groupBy + " (section, symbol, stop or payout)");
+}
+
+// Numeric keys sort numerically, everything else after them
+bool keyLess(const std::string& a, const std::string& b) {
+    auto number = [](const std::string& s) {
+        try {
+            return std::stod(s);
+        } catch (const std::exception&) {
+            return std::numeric_limits<double>::infinity();
+        }
+    };
+    double na = number(a), nb = number(b);
+    return na != nb ? na < nb : a < b;
+}
+
+std::string patternsText(const ResultsTable& t, size_t row) {
+    std::ostringstream out;
+    for (uint32_t p = 0; p < ResultsTable::MAX_PATTERNS; ++p) {
+        int16_t symbol = t.patternSymbol[row * ResultsTable::MAX_PATTERNS + p];
+        if (symbol < 0) continue;
+        if (out.tellp() > 0) out << ' ';
+        out << symbol << 'x' << static_cast<int>(t.patternSize[row * ResultsTable::MAX_PATTERNS + p]);
+    }
+    return out.str();
+}
+
+void printRows(const ResultsTable& t, const std::vector<size_t>& rows, size_t limit, bool csv) {
+    const std::string sep = csv ? "," : "  ";
+    if (csv) {
+        std::cout << "section,index,expected_payout,calculated_payout,expected_stop,actual_stop,mismatch,patterns\n";
+    } else {
+        std::cout << std::left << std::setw(6) << "sect" << std::right << std::setw(8) << "index" << std::setw(12) << "expected"
+                  << std::setw(12) << "calculated" << std::setw(6) << "stop" << std::setw(6) << "act" << std::setw(6) << "mism"
+                  << "  patterns\n";
+    }
+    for (size_t k = 0; k < rows.size() && k < limit; ++k) {
+        size_t r = rows[k];
+        if (csv) {
+            std::cout << (t.isFree(r) ? "free" : "base") << sep << t.index[r] << sep << t.expectedPayout[r] << sep
+                      << t.calculatedPayout[r] << sep << t.expectedStop[r] << sep << t.actualStop[r] << sep
+                      << static_cast<int>(t.mismatch[r]) << sep << patternsText(t, r) << "\n";
+        } else {
+            std::cout << std::left << std::setw(6) << (t.isFree(r) ? "free" : "base") << std::right << std::setw(8) << t.index[r]
+                      << std::fixed << std::setprecision(0) << std::setw(12) << t.expectedPayout[r] << std::setw(12)
+                      << t.calculatedPayout[r] << std::setw(6) << t.expectedStop[r] << std::setw(6) << t.actualStop[r]
+                      << std::setw(6) << static_cast<int>(t.mismatch[r]) << "  " << patternsText(t, r) << "\n";
+        }
+    }
+    if (!csv && rows.size() > limit) std::cout << "... " << rows.size() - limit << " more\n";
+}
+
+void printAggregates(const std::vector<std::pair<std::string, Aggregate>>& groups, const std::string& groupBy, bool csv) {
+    if (csv) {
+        std::cout << groupBy << ",count,expected_sum,calculated_sum,mean,min,max,mismatches\n";
+        for (const auto& [key, a] : groups) {
+            std::cout << key << "," << a.count << "," << a.expected << "," << a.calculated << ","
+                      << (a.count > 0 ? a.calculated / a.count : 0.0) << "," << (a.count > 0 ? a.minPayout : 0.0) << ","
+                      << (a.count > 0 ? a.maxPayout : 0.0) << "," << a.mismatches << "\n";
+        }
+        return;
+    }
+    std::cout << std::left << std::setw(12) << groupBy << std::right << std::setw(8) << "count" << std::setw(14) << "expected"
+              << std::setw(14) << "calculated" << std::setw(10) << "mean" << std::setw(8) << "min" << std::setw(10) << "max"
+              << std::setw(8) << "mism" << "\n";
+    for (const auto& [key, a] : groups) {
+        std::cout << std::left << std::setw(12) << key << std::right << std::setw(8) << a.count << std::fixed
+                  << std::setprecision(0) << std::setw(14) << a.expected << std::setw(14) << a.calculated
+                  << std::setprecision(2) << std::setw(10) << (a.count > 0 ? a.calculated / a.count : 0.0)
+                  << std::setprecision(0) << std::setw(8) << (a.count > 0 ? a.minPayout : 0.0) << std::setw(10)
+                  << (a.count > 0 ? a.maxPayout : 0.0) << std::setw(8) << a.mismatches << "\n";
+    }
+}
+
+void usage() {
+    std::cerr << "Usage: SS02_query [results.ss02r] [--section base|free] [--where \"COL OP VALUE\"]...\n"
+                 "                  [--symbol S[:MIN]]... [--mismatch payout|stop|cascade|any]\n"
+                 "                  [--group-by section|symbol|stop|payout] [--limit N] [--csv]\n"
+                 "  Columns: index, expected_payout, calculated_payout, expected_stop, actual_stop, pattern_count\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filename = "script_results.ss02r";
+    std::string sectionFilter;
+    std::string groupBy = "section";
+    std::vector<Condition> conditions;
+    std::vector<SymbolFilter> symbols;
+    uint8_t mismatchMask = 0;
+    size_t limit = 0;
+    bool csv = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " needs a value");
+                return argv[++i];
+            };
+            if (arg == "--section") {
+                sectionFilter = value();
+                if (sectionFilter != "base" && sectionFilter != "free") throw std::runtime_error("Section must be base or free");
+            } else if (arg == "--where") {
+                conditions.push_back(parseCondition(value()));
+            } else if (arg == "--symbol") {
+                symbols.push_back(parseSymbol(value()));
+            } else if (arg == "--mismatch") {
+                mismatchMask |= parseMismatch(value());
+            } else if (arg == "--group-by") {
+                groupBy = value();
+            } else if (arg == "--limit") {
+                limit = static_cast<size_t>(std::stoul(value()));
+            } else if (arg == "--csv") {
+                csv = true;
+            } else if (arg[0] != '-') {
+                filename = arg;
+            } else {
+                usage();
+                return 1;
+            }
+        }
+
+        ResultsTable table = ResultsTable::load(filename);
+
+        std::vector<size_t> matched;
+        for (size_t r = 0; r < table.rows(); ++r) {
+            if (!sectionFilter.empty() && table.isFree(r) != (sectionFilter == "free")) continue;
+            if (mismatchMask != 0 && (table.mismatch[r] & mismatchMask) == 0) continue;
+            bool keep = true;
+            for (const auto& c : conditions) keep = keep && holds(c, columnValue(table, r, c.column));
+            for (const auto& s : symbols) keep = keep && table.clusterSize(r, s.symbol) >= s.minCount;
+            if (keep) matched.push_back(r);
+        }
+
+        if (limit > 0) {
+            printRows(table, matched, limit, csv);
+            return 0;
+        }
+
+        std::map<std::string, Aggregate, bool (*)(const std::string&, const std::string&)> groups(keyLess);
+        for (size_t r : matched) {
+            for (const auto& key : groupKeys(table, r, groupBy)) groups[key].add(table, r);
+        }
+        Aggregate total;
+        for (size_t r : matched) total.add(table, r);
+        std::vector<std::pair<std::string, Aggregate>> ordered(groups.begin(), groups.end());
+        if (!csv) {
+            std::cout << "=== " << filename << ": " << matched.size() << " of " << table.rows() << " scripts ===\n";
+        }
+        printAggregates(ordered, groupBy, csv);
+        if (!csv) {
+            std::cout << std::left << std::setw(12) << "total" << std::right << std::setw(8) << total.count << std::fixed
+                      << std::setprecision(0) << std::setw(14) << total.expected << std::setw(14) << total.calculated << "\n";
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,217 @@
+#include "SS02Pay.hpp"
+#include "ScriptConfig.h"
+#include "ReelConverter.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// Replay verifier for converted reels. Every reel script (number / stopover / script[].reel)
+// is played the way the backend consumes it (ReelConverter::replay), the rebuilt boards are
+// scored with SlotSS02 and diffed against the source board scripts. Runs in parallel over all
+// entries; any difference means the reel conversion lost or invented information.
+
+namespace {
+
+struct ReplayIssue {
+    std::string section;
+    int number = 0;
+    std::string reason;
+};
+
+struct SectionSummary {
+    size_t entries = 0;
+    size_t failed = 0;
+};
+
+std::string describeBoardDiff(const std::vector<Board>& replayed, const std::vector<Board>& source) {
+    size_t common = std::min(replayed.size(), source.size());
+    for (size_t b = 0; b < common; ++b) {
+        if (replayed[b] == source[b]) continue;
+        for (size_t row = 0; row < replayed[b].size() && row < source[b].size(); ++row) {
+            for (size_t col = 0; col < replayed[b][row].size() && col < source[b][row].size(); ++col) {
+                if (replayed[b][row][col] != source[b][row][col]) {
+                    return "board " + std::to_string(b) + " differs at (" + std::to_string(row) + "," +
+                           std::to_string(col) + "): replay " + std::to_string(replayed[b][row][col]) +
+                           ", source " + std::to_string(source[b][row][col]);
+                }
+            }
+        }
+        return "board " + std::to_string(b) + " has a different shape";
+    }
+    return "";
+}
+
+// Checks one reel script against its source; returns an empty string when they agree
+std::string verifyEntry(SlotSS02& game, const ReelScript& reel, const ScriptApp::ScriptData* source, bool isFree) {
+    if (!source) {
+        return "no source script with this index";
+    }
+    if (reel.reels.size() != 6) {
+        return "has " + std::to_string(reel.reels.size()) + " reels, expected 6";
+    }
+    ReelReplay replay = ReelConverter::replay(game, reel);
+    if (replay.exhausted) {
+        return "reel exhausted after " + std::to_string(replay.boards.size()) + " boards";
+    }
+    if (static_cast<int>(replay.boards.size()) != reel.stopover) {
+        return "replay stops after " + std::to_string(replay.boards.size()) + " boards, stopover is " +
+               std::to_string(reel.stopover);
+    }
+    if (reel.stopover != source->stop) {
+        return "stopover " + std::to_string(reel.stopover) + ", source stop " + std::to_string(source->stop);
+    }
+    std::string diff = describeBoardDiff(replay.boards, source->script);
+    if (!diff.empty()) {
+        return diff;
+    }
+    if (replay.boards.size() != source->script.size()) {
+        return "replay has " + std::to_string(replay.boards.size()) + " boards, source " +
+               std::to_string(source->script.size());
+    }
+    if (replay.unusedSymbols > 0) {
+        return std::to_string(replay.unusedSymbols) + " reel symbols never dropped";
+    }
+    if (isFree && reel.multiple_table != source->multiple_table) {
+        return "multiple_table " + std::to_string(reel.multiple_table) + ", source " +
+               std::to_string(source->multiple_table);
+    }
+    auto replayed = game.steps(replay.boards, source->special_multipliers);
+    auto expected = game.steps(source->script, source->special_multipliers);
+    if (std::get<1>(replayed) != std::get<1>(expected)) {
+        std::ostringstream oss;
+        oss << "payout " << std::get<1>(replayed) << ", source " << std::get<1>(expected);
+        return oss.str();
+    }
+    return "";
+}
+
+SectionSummary verifySection(const std::vector<ReelScript>& reels,
+                             const std::map<int, ScriptApp::ScriptData>& sources,
+                             const std::string& section, unsigned threads,
+                             std::vector<ReplayIssue>& issues) {
+    std::vector<std::string> reasons(reels.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        SlotSS02 game(true, 20.0f, section);   // SlotSS02 is not shared between threads
+        for (size_t i = next++; i < reels.size(); i = next++) {
+            auto it = sources.find(reels[i].number);
+            try {
+                reasons[i] = verifyEntry(game, reels[i], it == sources.end() ? nullptr : &it->second, section == "free");
+            } catch (const std::exception& e) {
+                reasons[i] = e.what();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    SectionSummary summary;
+    summary.entries = reels.size();
+    for (size_t i = 0; i < reels.size(); ++i) {
+        if (reasons[i].empty()) continue;
+        summary.failed++;
+        issues.push_back({section, reels[i].number, reasons[i]});
+    }
+    if (reels.size() != sources.size()) {
+        issues.push_back({section, -1, std::to_string(reels.size()) + " reel scripts for " +
+                                       std::to_string(sources.size()) + " source scripts"});
+        summary.failed++;
+    }
+    return summary;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string reelFile = "SS02_scripts_smart.json";
+    std::string sourceFile = "SS02_scripts.json";
+    std::string outputFile;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--source" && i + 1 < argc) {
+            sourceFile = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            reelFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_replay [reels.json] [--source SS02_scripts.json] [--threads N] [-o report.json]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Reel Replay Verifier ===\n\n";
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        ReelScriptSet reels = ReelConverter::loadReelFile(reelFile);
+        auto sources = ScriptApp::ScriptConfig::loadFromFile(sourceFile);
+        auto loaded = std::chrono::steady_clock::now();
+
+        std::cout << "Reels:  " << reelFile << " (" << reels.base.size() << " base, " << reels.free.size() << " free)\n";
+        std::cout << "Source: " << sourceFile << " (" << sources.base_scripts.size() << " base, "
+                  << sources.free_scripts.size() << " free)\n";
+        std::cout << "Threads: " << threads << "\n\n";
+
+        std::vector<ReplayIssue> issues;
+        SectionSummary base = verifySection(reels.base, sources.base_scripts, "base", threads, issues);
+        SectionSummary free = verifySection(reels.free, sources.free_scripts, "free", threads, issues);
+        auto end = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < issues.size() && i < 10; ++i) {
+            std::cout << "❌ " << issues[i].section;
+            if (issues[i].number >= 0) std::cout << " #" << issues[i].number;
+            std::cout << ": " << issues[i].reason << "\n";
+        }
+        if (issues.size() > 10) {
+            std::cout << "   ... " << issues.size() - 10 << " more\n";
+        }
+
+        double loadMs = std::chrono::duration<double, std::milli>(loaded - start).count();
+        double replayMs = std::chrono::duration<double, std::milli>(end - loaded).count();
+        size_t entries = base.entries + free.entries;
+        std::cout << "\nBase: " << base.entries - std::min(base.failed, base.entries) << "/" << base.entries << " verified\n";
+        std::cout << "Free: " << free.entries - std::min(free.failed, free.entries) << "/" << free.entries << " verified\n";
+        std::cout << "Replayed " << entries << " entries in " << std::fixed << std::setprecision(1) << replayMs
+                  << " ms (" << std::setprecision(0) << (replayMs > 0.0 ? entries / (replayMs / 1000.0) : 0.0)
+                  << " entries/s, load " << std::setprecision(1) << loadMs << " ms)\n";
+
+        if (!outputFile.empty()) {
+            nlohmann::json report;
+            report["reel_file"] = reelFile;
+            report["source_file"] = sourceFile;
+            report["base"] = {{"entries", base.entries}, {"failed", base.failed}};
+            report["free"] = {{"entries", free.entries}, {"failed", free.failed}};
+            report["issues"] = nlohmann::json::array();
+            for (const auto& issue : issues) {
+                report["issues"].push_back({{"section", issue.section}, {"number", issue.number}, {"reason", issue.reason}});
+            }
+            std::ofstream outFile(outputFile);
+            if (!outFile.is_open()) {
+                throw std::runtime_error("Cannot write to " + outputFile);
+            }
+            outFile << report.dump(2) << "\n";
+            std::cout << "   Report: " << outputFile << "\n";
+        }
+
+        if (issues.empty()) {
+            std::cout << "\n✅ Reel conversion is lossless: every entry replays to its source script\n";
+            return 0;
+        }
+        std::cout << "\n❌ " << issues.size() << " reel entries do not replay to their source scripts\n";
+        return 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
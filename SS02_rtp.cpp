@@ -0,0 +1,149 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+
+// Analytic RTP, variance and payout quantiles of an SS02 script set, including the free
+// game session structure (retriggers) and the multiplier table draws. No simulation.
+
+namespace {
+
+const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999, 0.9999};
+
+void printDistribution(const std::string& title, const PayoutDistribution& d, double bet) {
+    std::cout << title << " (bin width " << std::fixed << std::setprecision(2) << d.binWidth << "):\n";
+    for (double q : kQuantiles) {
+        std::cout << "  P" << std::setw(7) << std::left << std::setprecision(2) << q * 100.0 << std::right
+                  << ": " << std::setw(12) << std::setprecision(2) << d.quantile(q)
+                  << "  (" << std::setprecision(2) << d.quantile(q) / bet << "x bet)\n";
+    }
+}
+
+nlohmann::json distributionJson(const PayoutDistribution& d) {
+    nlohmann::json j;
+    j["bin_width"] = d.binWidth;
+    for (double q : kQuantiles) {
+        std::ostringstream key;
+        key << "p" << q * 100.0;
+        j["quantiles"][key.str()] = d.quantile(q);
+    }
+    return j;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string outputFile = "SS02_rtp.json";
+    size_t gridSize = 1 << 16;
+
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters params = RtpParameters::fromGame(game);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--trigger" && i + 1 < argc) {
+            params.fgTrigger = std::stod(argv[++i]);
+        } else if (arg == "--retrigger" && i + 1 < argc) {
+            params.fgRetrigger = std::stod(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            params.fgRounds = std::stoi(argv[++i]);
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            params.volatility = argv[++i];
+        } else if (arg == "--bet" && i + 1 < argc) {
+            params.bet = std::stod(argv[++i]);
+        } else if (arg == "--flat-multipliers") {
+            params.drawMultipliers = false;
+        } else if (arg == "--grid" && i + 1 < argc) {
+            gridSize = std::stoul(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_rtp [scripts.json] [--trigger P] [--retrigger P] [--rounds N] [--volatility low|high]"
+                         " [--bet B] [--flat-multipliers] [--grid N] [-o output.json]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Analytic RTP ===\n\n";
+
+    try {
+        auto config = loadSS02Scripts(scriptsFile);
+        auto start = std::chrono::steady_clock::now();
+        ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+        auto cached = std::chrono::steady_clock::now();
+        SS02AnalyticRtp solver(cache);
+        RtpReport report = solver.solve(params, gridSize);
+        auto end = std::chrono::steady_clock::now();
+
+        double cacheMs = std::chrono::duration<double, std::milli>(cached - start).count();
+        double solveMs = std::chrono::duration<double, std::milli>(end - cached).count();
+
+        std::cout << "Scripts: " << cache.base.size() << " base, " << cache.free.size() << " free\n";
+        std::cout << "FG trigger: " << std::fixed << std::setprecision(4) << params.fgTrigger
+                  << ", retrigger: " << params.fgRetrigger << ", rounds: " << params.fgRounds
+                  << ", volatility: " << params.volatility
+                  << (params.drawMultipliers ? "" : " (flat multipliers)") << "\n\n";
+
+        std::cout << "Base spin:     mean " << std::setprecision(4) << report.baseMean
+                  << ", std dev " << std::sqrt(report.baseVariance) << "\n";
+        std::cout << "Free spin:     mean " << report.freeSpinMean << ", std dev " << std::sqrt(report.freeSpinVariance)
+                  << " (script payouts: mean " << report.freeScriptMean << ")\n";
+        std::cout << "FG length:     mean " << report.sessionLengthMean
+                  << ", std dev " << std::sqrt(report.sessionLengthVariance) << "\n";
+        std::cout << "FG session:    mean " << report.sessionMean << ", std dev " << std::sqrt(report.sessionVariance) << "\n";
+        std::cout << "Per base spin: mean " << report.spinMean << ", std dev " << std::sqrt(report.spinVariance) << "\n\n";
+
+        std::cout << "Base RTP:  " << std::setprecision(6) << report.baseRtp << "\n";
+        std::cout << "Free RTP:  " << report.freeRtp << "\n";
+        std::cout << "Total RTP: " << report.rtp << "\n\n";
+
+        if (gridSize > 0) {
+            printDistribution("FG session payout quantiles", report.session, params.bet);
+            printDistribution("Per base spin payout quantiles", report.spin, params.bet);
+        }
+
+        nlohmann::json output;
+        output["scripts_file"] = scriptsFile;
+        output["parameters"] = {
+            {"bet", params.bet},
+            {"fg_trigger", params.fgTrigger},
+            {"fg_retrigger", params.fgRetrigger},
+            {"fg_rounds", params.fgRounds},
+            {"volatility", params.volatility},
+            {"draw_multipliers", params.drawMultipliers}
+        };
+        output["base"] = {{"mean", report.baseMean}, {"variance", report.baseVariance}};
+        output["free_spin"] = {{"mean", report.freeSpinMean}, {"variance", report.freeSpinVariance},
+                               {"script_mean", report.freeScriptMean}};
+        output["fg_length"] = {{"mean", report.sessionLengthMean}, {"variance", report.sessionLengthVariance}};
+        output["fg_session"] = {{"mean", report.sessionMean}, {"variance", report.sessionVariance}};
+        output["spin"] = {{"mean", report.spinMean}, {"variance", report.spinVariance}};
+        output["rtp"] = {{"base", report.baseRtp}, {"free", report.freeRtp}, {"total", report.rtp}};
+        if (gridSize > 0) {
+            output["fg_session"]["distribution"] = distributionJson(report.session);
+            output["spin"]["distribution"] = distributionJson(report.spin);
+        }
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        outFile << output.dump(2) << "\n";
+        outFile.close();
+
+        std::cout << "\n✅ Solved in " << std::setprecision(1) << solveMs << " ms (outcome cache " << cacheMs << " ms)\n";
+        std::cout << "   Output: " << outputFile << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
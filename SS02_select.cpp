@@ -0,0 +1,198 @@
+#include "SelectionOptimizer.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <map>
+#include <algorithm>
+
+// Selects num_to_select scripts for one section from a DeepDive selection config
+// (Backup/DeepDive_BG_Selection.json, Backup/DeepDive_FG_Selection.json).
+//
+// Candidate payouts come from the config's "input_values" or, with --compositions, from an
+// SS02_enumerate output; in that case the selection is also written as an SS02_generate
+// composition file with repeat counts. The GameConfig.json RTP window and BG/FG split
+// (Backup/GameConfig.json unless --game-config names another) replace the config's
+// average_range and BG_max / FG_max cap the payouts; --no-game-config keeps average_range.
+
+namespace {
+
+nlohmann::json readJson(const std::string& filename, const std::string& what) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open " + what + ": " + filename);
+    }
+    nlohmann::json j;
+    file >> j;
+    return j;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string configFile;
+    std::string compositionsFile;
+    std::string gameConfigFile = "Backup/GameConfig.json";
+    std::string outputFile;
+    std::string section;
+    uint64_t seed = 20251024;
+    int restarts = 8;
+    int iterations = 200000;
+    double diversityWeight = 1.0;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg == "--compositions" && i + 1 < argc) {
+            compositionsFile = argv[++i];
+        } else if (arg == "--game-config" && i + 1 < argc) {
+            gameConfigFile = argv[++i];
+        } else if (arg == "--no-game-config") {
+            gameConfigFile.clear();
+        } else if (arg == "--section" && i + 1 < argc) {
+            section = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--restarts" && i + 1 < argc) {
+            restarts = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--diversity-weight" && i + 1 < argc) {
+            diversityWeight = std::stod(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (configFile.empty()) {
+            configFile = arg;
+        } else {
+            configFile.clear();
+            break;
+        }
+    }
+    if (configFile.empty()) {
+        std::cerr << "Usage: SS02_select <DeepDive_Selection.json> [--compositions SS02_compositions.json]"
+                     " [--game-config GameConfig.json | --no-game-config] [-o output.json] [--section base|free] [--seed N]"
+                     " [--restarts N] [--iterations N] [--diversity-weight W] [--threads N]\n";
+        return 1;
+    }
+
+    std::cout << "=== SS02 Selection Optimizer ===\n\n";
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        SelectionProblem problem = SelectionProblem::loadFromFile(configFile);
+
+        nlohmann::json compositions;
+        std::vector<int> candidates = problem.values;
+        if (!compositionsFile.empty()) {
+            compositions = readJson(compositionsFile, "composition file");
+            problem.section = compositions.value("section", problem.section);
+            candidates = compositions.at("input_values").get<std::vector<int>>();
+        } else if (candidates.empty()) {
+            throw std::runtime_error(configFile + " lists no input_values; pass --compositions SS02_compositions.json");
+        }
+        if (!section.empty()) problem.section = section;
+
+        int maxPayout = 0;
+        if (!gameConfigFile.empty()) {
+            std::ifstream gameConfig(gameConfigFile);
+            if (!gameConfig.is_open()) {
+                throw std::runtime_error("Unable to open game config file: " + gameConfigFile +
+                                         " (pass --game-config FILE, or --no-game-config to use average_range)");
+            }
+            nlohmann::json gc;
+            gameConfig >> gc;
+            maxPayout = problem.applyGameConfig(gc);
+            std::cout << "Game config: " << gameConfigFile << "\n";
+        }
+        problem.setValues(candidates, maxPayout);
+        if (outputFile.empty()) {
+            outputFile = "SS02_selection_" + problem.section + ".json";
+        }
+
+        const int n = problem.numToSelect;
+        std::cout << "Problem: " << problem.name << " (" << problem.section << ")\n";
+        std::cout << "Candidates: " << problem.values.size() << " payouts";
+        if (maxPayout > 0) std::cout << " (max " << maxPayout << ")";
+        std::cout << "\nSelect: " << n << ", zeros [" << problem.zeroMin << ", " << problem.zeroMax
+                  << "], count per payout [" << problem.minCount << ", " << problem.maxCount << "]\n";
+        std::cout << "Target average: [" << std::fixed << std::setprecision(4)
+                  << static_cast<double>(problem.sumMin) / n << ", " << static_cast<double>(problem.sumMax) / n << "]\n";
+
+        SelectionOptimizer optimizer(problem, diversityWeight);
+        SelectionResult result = optimizer.optimize(threads, seed, restarts, iterations);
+        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!result.feasible) {
+            std::cerr << "❌ No feasible selection found: average " << result.mean(n) << ", "
+                      << result.binDeficit << " bin selections missing\n";
+            throw std::runtime_error("selection constraints not met; try more --iterations or --restarts");
+        }
+
+        nlohmann::json output;
+        output["problem_name"] = problem.name;
+        output["section"] = problem.section;
+        output["num_to_select"] = n;
+        output["zero_count"] = result.zeroCount;
+        output["average"] = result.mean(n);
+        output["variance"] = result.variance(n);
+        output["distinct_payouts"] = result.distinct;
+        nlohmann::json selection = nlohmann::json::array();
+        for (size_t i = 0; i < problem.values.size(); ++i) {
+            if (result.counts[i] > 0) selection.push_back({{"payout", problem.values[i]}, {"count", result.counts[i]}});
+        }
+        output["selection"] = selection;
+
+        if (!compositionsFile.empty()) {
+            // Repeat counts for SS02_generate, spread round-robin over each payout's examples
+            std::map<int, std::vector<nlohmann::json>> examples;
+            for (const auto& entry : compositions.at(problem.section)) {
+                examples[entry.at("payout").get<int>()].push_back(entry);
+            }
+            nlohmann::json entries = nlohmann::json::array();
+            auto emit = [&](int payout, int count, int payoutId) {
+                auto it = examples.find(payout);
+                if (it == examples.end()) {
+                    if (payout != 0) throw std::runtime_error("No composition for payout " + std::to_string(payout));
+                    entries.push_back({{"steps", nlohmann::json::array()}, {"repeat", count}, {"payout_id", 0}});
+                    return;
+                }
+                const auto& list = it->second;
+                for (size_t k = 0; k < list.size() && static_cast<int>(k) < count; ++k) {
+                    nlohmann::json entry = list[k];
+                    entry["repeat"] = count / static_cast<int>(list.size()) +
+                                      (static_cast<int>(k) < count % static_cast<int>(list.size()) ? 1 : 0);
+                    entry["payout_id"] = payoutId;
+                    entries.push_back(entry);
+                }
+            };
+            if (result.zeroCount > 0) emit(0, result.zeroCount, 0);
+            int payoutId = 1;
+            for (size_t i = 0; i < problem.values.size(); ++i) {
+                if (result.counts[i] > 0) emit(problem.values[i], result.counts[i], payoutId++);
+            }
+            output[problem.section] = entries;
+        }
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        outFile << output.dump(2) << "\n";
+        outFile.close();
+
+        std::cout << "\n✅ Selected " << n << " scripts in " << std::setprecision(3) << duration << " s ("
+                  << restarts << " restarts x " << iterations << " moves, " << threads << " threads)\n";
+        std::cout << "   Average payout: " << std::setprecision(4) << result.mean(n)
+                  << ", variance: " << std::setprecision(2) << result.variance(n) << "\n";
+        std::cout << "   Zero payouts: " << result.zeroCount << ", distinct payouts: " << result.distinct << "\n";
+        std::cout << "   Output: " << outputFile << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
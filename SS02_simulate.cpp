@@ -0,0 +1,341 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "SS02Simulator.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+// Monte Carlo RTP of base spins (free games included) or bought features that runs until the
+// RTP confidence interval reaches a target half-width, instead of a guessed spin count.
+// The spin count the exact variance predicts is reported next to the achieved one.
+// --stratify, --is-trigger, --is-multiplier and --control-variate enable the unbiased
+// variance reduction of SessionSimulator; --check-reduction runs each enabled technique
+// against plain sampling on the same trial budget and tests that the estimates agree.
+// --checkpoint saves the run's SimulationState every --checkpoint-interval seconds and at the
+// end; --resume continues from it bit-exactly. --batches runs one block-aligned shard of a
+// fixed run and --merge combines shard checkpoints into the full run (finishing any batches
+// the shards did not cover).
+
+namespace {
+
+struct Variant {
+    std::string name;
+    VarianceReduction reduction;
+};
+
+// Plain sampling, each enabled technique alone and all of them together
+int checkReduction(const ScriptOutcomeCache& cache, const RtpParameters& params, SimulationMode mode,
+                   const VarianceReduction& enabled, uint64_t trials, uint64_t seed, unsigned threads, double exactRtp) {
+    std::vector<Variant> variants{{"plain", {}}};
+    auto single = [&](const std::string& name, auto set) {
+        Variant v{name, {}};
+        set(v.reduction);
+        variants.push_back(v);
+    };
+    if (enabled.stratify) single("stratify", [](VarianceReduction& r) { r.stratify = true; });
+    if (enabled.triggerRate > 0.0) single("is-trigger", [&](VarianceReduction& r) { r.triggerRate = enabled.triggerRate; });
+    if (enabled.multiplierTilt != 0.0) single("is-multiplier", [&](VarianceReduction& r) { r.multiplierTilt = enabled.multiplierTilt; });
+    if (enabled.controlVariate) single("control-variate", [](VarianceReduction& r) { r.controlVariate = true; });
+    if (variants.size() > 2) variants.push_back({"combined", enabled});
+
+    // Batch-mean intervals need MIN_BATCHES batches; with fewer the standard error is unknown
+    const uint64_t minTrials = SimulationStats::MIN_BATCHES * SessionSimulator::BATCH;
+    if (enabled.stratify && trials < minTrials) {
+        std::cerr << "Error: --check-reduction with --stratify needs at least " << minTrials << " trials ("
+                  << SimulationStats::MIN_BATCHES << " batches)\n";
+        return 1;
+    }
+    StoppingRule fixed;
+    fixed.halfWidth = 0.0;
+    fixed.minTrials = fixed.maxTrials = trials;
+    const double z = fixed.zScore();   // runUntil reports the half-width at fixed.confidence
+    const size_t tail = SimulationStats::bucket(100.0);
+    std::cout << "Variance reduction check, " << trials << " trials each:\n"
+              << std::left << std::setw(18) << "  Method" << std::right << std::setw(11) << "RTP" << std::setw(11) << "StdErr"
+              << std::setw(9) << "Time s" << std::setw(10) << "VarRatio" << std::setw(10) << "Speedup" << std::setw(9)
+              << "z plain" << std::setw(9) << "z exact" << std::setw(13) << "P(>=100x)" << "\n";
+
+    int failed = 0;
+    double plainRtp = 0.0, plainSe = 0.0, plainWork = 0.0;
+    for (size_t v = 0; v < variants.size(); ++v) {
+        SessionSimulator simulator(cache, params, variants[v].reduction);
+        auto start = std::chrono::steady_clock::now();
+        SimulationRun run = simulator.runUntil(mode, fixed, seed + v, threads);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double stake = simulator.stake(mode);
+        const double rtp = run.stats.mean / stake;
+        const double se = run.halfWidth / z;
+        double tailMass = 0.0;
+        for (size_t b = tail; b < SimulationStats::BUCKETS; ++b) tailMass += run.stats.histogram[b];
+        tailMass /= static_cast<double>(run.stats.trials);
+        if (v == 0) {
+            plainRtp = rtp;
+            plainSe = se;
+            plainWork = se * se * seconds;
+        }
+        const double zPlain = v == 0 ? 0.0 : (rtp - plainRtp) / std::sqrt(se * se + plainSe * plainSe);
+        const double zExact = (rtp - exactRtp) / se;
+        std::cout << "  " << std::left << std::setw(16) << variants[v].name << std::right << std::fixed << std::setprecision(6)
+                  << std::setw(11) << rtp << std::setw(11) << se << std::setprecision(2) << std::setw(9) << seconds
+                  << std::setw(10) << (plainSe * plainSe) / (se * se) << std::setw(10) << plainWork / (se * se * seconds)
+                  << std::setw(9) << zPlain << std::setw(9) << zExact << std::scientific << std::setprecision(3)
+                  << std::setw(13) << tailMass << std::fixed << "\n";
+        if (std::abs(zPlain) > 4.0 || std::abs(zExact) > 4.0) failed = 1;
+    }
+    if (failed) {
+        std::cout << "❌ A reduced estimator differs from plain sampling or the exact RTP by more than 4 standard errors\n";
+    } else {
+        std::cout << "✅ All estimators agree with plain sampling and the exact RTP within 4 standard errors\n";
+    }
+    std::cout << "   VarRatio: plain variance / variance per trial; Speedup: the same per unit of CPU time\n";
+    return failed;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string outputFile = "SS02_simulate.json";
+    std::string tableFile;
+    std::string modeName = "spin";
+    double cost = -1.0;
+    uint64_t fixedTrials = 0;
+    uint64_t seed = 12345;
+    StoppingRule rule;
+    VarianceReduction reduction;
+    bool check = false;
+    std::string checkpointFile;
+    double checkpointInterval = 300.0;
+    bool resume = false;
+    uint64_t shardFirst = 0, shardEnd = 0;
+    std::vector<std::string> mergeFiles;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters params = RtpParameters::fromGame(game);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--mode" && i + 1 < argc) {
+            modeName = argv[++i];
+        } else if (arg == "--half-width" && i + 1 < argc) {
+            rule.halfWidth = std::stod(argv[++i]);
+        } else if (arg == "--confidence" && i + 1 < argc) {
+            rule.confidence = std::stod(argv[++i]);
+        } else if (arg == "--min-trials" && i + 1 < argc) {
+            rule.minTrials = std::stoull(argv[++i]);
+        } else if (arg == "--max-trials" && i + 1 < argc) {
+            rule.maxTrials = std::stoull(argv[++i]);
+        } else if (arg == "--trials" && i + 1 < argc) {
+            fixedTrials = std::stoull(argv[++i]);
+        } else if (arg == "--stratify") {
+            reduction.stratify = true;
+        } else if (arg == "--is-trigger" && i + 1 < argc) {
+            reduction.triggerRate = std::stod(argv[++i]);
+        } else if (arg == "--is-multiplier" && i + 1 < argc) {
+            reduction.multiplierTilt = std::stod(argv[++i]);
+        } else if (arg == "--control-variate") {
+            reduction.controlVariate = true;
+        } else if (arg == "--check-reduction") {
+            check = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            checkpointInterval = std::stod(argv[++i]);
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--batches" && i + 2 < argc) {
+            shardFirst = std::stoull(argv[++i]);
+            shardEnd = std::stoull(argv[++i]);
+        } else if (arg == "--merge" && i + 1 < argc) {
+            while (i + 1 < argc && argv[i + 1][0] != '-') mergeFiles.push_back(argv[++i]);
+        } else if (arg == "--trigger" && i + 1 < argc) {
+            params.fgTrigger = std::stod(argv[++i]);
+        } else if (arg == "--retrigger" && i + 1 < argc) {
+            params.fgRetrigger = std::stod(argv[++i]);
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            params.fgRounds = std::stoi(argv[++i]);
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            params.volatility = argv[++i];
+        } else if (arg == "--multiplier-table" && i + 1 < argc) {
+            tableFile = argv[++i];
+        } else if (arg == "--cost" && i + 1 < argc) {
+            cost = std::stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_simulate [scripts.json] [--mode spin|buy] [--half-width RTP] [--confidence C]"
+                         " [--min-trials N] [--max-trials N] [--trials N] [--stratify] [--is-trigger Q]"
+                         " [--is-multiplier TILT] [--control-variate] [--check-reduction] [--checkpoint FILE]"
+                         " [--checkpoint-interval SEC] [--resume] [--batches FIRST END] [--merge FILE...]"
+                         " [--trigger P] [--retrigger P] [--rounds N] [--volatility low|high] [--multiplier-table FILE]"
+                         " [--cost BETS] [--seed N] [--threads N] [-o output.json]\n";
+            return 1;
+        }
+    }
+    if (modeName != "spin" && modeName != "buy") {
+        std::cerr << "Error: mode must be spin or buy\n";
+        return 1;
+    }
+    const SimulationMode mode = modeName == "buy" ? SimulationMode::Buy : SimulationMode::Spin;
+    if (fixedTrials > 0) {
+        rule.halfWidth = 0.0;
+        rule.minTrials = rule.maxTrials = fixedTrials;
+    }
+    if (resume && checkpointFile.empty()) {
+        checkpointFile = "SS02_simulate.ckpt";
+    }
+    if (shardEnd > 0) {
+        // The stopping rule needs the whole in-order prefix, so shards only split fixed runs
+        if (fixedTrials == 0 || shardEnd <= shardFirst || shardFirst % SimulationState::BLOCK_BATCHES != 0) {
+            std::cerr << "Error: --batches needs --trials and FIRST < END with FIRST a multiple of "
+                      << SimulationState::BLOCK_BATCHES << "\n";
+            return 1;
+        }
+        rule.maxTrials = std::min(rule.maxTrials, shardEnd * SessionSimulator::BATCH);
+    }
+
+    std::cout << "=== SS02 Adaptive Simulation ===\n\n";
+
+    try {
+        auto config = loadSS02Scripts(scriptsFile);
+        params.buyCost = cost > 0.0 ? cost : config.buy_free_game_multiplier;
+        if (!tableFile.empty()) {
+            std::ifstream file(tableFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open " + tableFile);
+            }
+            file >> params.multiplierTable;
+        }
+        ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+        RtpReport report = SS02AnalyticRtp(cache).solve(params, 0);
+        if (check) {
+            const double exact = modeName == "buy" ? report.buyRtp : report.rtp;
+            return checkReduction(cache, params, mode, reduction, fixedTrials > 0 ? fixedTrials : 1 << 22, seed, threads, exact);
+        }
+        SessionSimulator simulator(cache, params, reduction);
+
+        const double stake = simulator.stake(mode);
+        const double exactRtp = mode == SimulationMode::Buy ? report.buyRtp : report.rtp;
+        const double exactVariance = mode == SimulationMode::Buy ? report.buyVariance : report.spinVariance;
+        const double z = rule.zScore();
+
+        std::cout << "Mode: " << modeName << ", stake " << std::fixed << std::setprecision(0) << stake << ", seed " << seed
+                  << ", " << threads << " threads\n";
+        if (fixedTrials > 0) {
+            std::cout << "Fixed run: " << fixedTrials << " trials\n\n";
+        } else {
+            const double predicted = std::pow(z * std::sqrt(exactVariance) / (stake * rule.halfWidth), 2.0);
+            std::cout << "Target: +-" << std::setprecision(4) << rule.halfWidth * 100.0 << "% RTP at "
+                      << std::setprecision(2) << rule.confidence * 100.0 << "% (z = " << std::setprecision(4) << z
+                      << "), " << rule.minTrials << " to " << rule.maxTrials << " trials\n"
+                      << "Exact std dev " << std::sqrt(exactVariance) / stake << "x stake predicts "
+                      << std::setprecision(0) << predicted << " trials\n\n";
+        }
+
+        const uint64_t fingerprint = simulator.fingerprint(mode, seed);
+        SimulationState state;
+        state.firstBatch = state.nextBatch = shardFirst;
+        if (!mergeFiles.empty()) {
+            std::vector<SimulationState> shards;
+            for (const auto& f : mergeFiles) shards.push_back(SimulationState::load(f, fingerprint));
+            std::sort(shards.begin(), shards.end(),
+                      [](const SimulationState& a, const SimulationState& b) { return a.firstBatch < b.firstBatch; });
+            state = shards.front();
+            for (size_t i = 1; i < shards.size(); ++i) state.merge(shards[i]);
+            std::cout << "Merged " << shards.size() << " shards: batches " << state.firstBatch << " to "
+                      << state.nextBatch << ", " << state.trials() << " trials\n\n";
+        } else if (resume) {
+            state = SimulationState::load(checkpointFile, fingerprint);
+            std::cout << "Resuming " << checkpointFile << " at batch " << state.nextBatch << " ("
+                      << state.trials() << " trials done)\n\n";
+        }
+        const uint64_t resumedTrials = state.trials();
+
+        auto start = std::chrono::steady_clock::now();
+        auto lastSave = start;
+        auto checkpoint = [&](const SimulationState& current) {
+            if (checkpointFile.empty()) return;
+            const auto now = std::chrono::steady_clock::now();
+            if (std::chrono::duration<double>(now - lastSave).count() < checkpointInterval) return;
+            current.save(checkpointFile);
+            lastSave = now;
+        };
+        SimulationRun run = simulator.runUntil(mode, rule, seed, threads, state, checkpoint);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!checkpointFile.empty()) {
+            state.save(checkpointFile);
+        }
+        const SimulationStats& s = run.stats;
+        const uint64_t simulated = s.trials - resumedTrials;
+        const double rtp = s.mean / stake;
+        const double se = run.halfWidth / z;
+
+        std::cout << "Trials:     " << s.trials << ", " << simulated << " in " << std::setprecision(1) << ms / 1000.0
+                  << " s (" << std::setprecision(0) << simulated / (ms / 1000.0) << "/s)\n"
+                  << std::setprecision(6) << "RTP:        " << rtp << " +- " << run.halfWidth << " ("
+                  << std::setprecision(2) << rule.confidence * 100.0 << "%)\n"
+                  << std::setprecision(6) << "Exact RTP:  " << exactRtp << "\n"
+                  << std::setprecision(4) << (reduction.any() ? "Est std dev:" : "Std dev:   ") << " "
+                  << std::sqrt(s.variance()) / stake << "x stake (plain sampling, exact "
+                  << std::sqrt(exactVariance) / stake << "x)\n"
+                  << std::setprecision(2) << "Max win:    " << s.maxWin / stake << "x stake\n";
+
+        int failed = 0;
+        if (fixedTrials == 0) {
+            if (run.converged) {
+                std::cout << "✅ Reached the target half-width after " << s.trials << " trials\n";
+            } else {
+                std::cout << "⚠️  Stopped at --max-trials before reaching the target half-width\n";
+            }
+        }
+        if (!std::isfinite(se)) {
+            std::cout << "⚠️  Too few trials for a standard error (--stratify needs " << SimulationStats::MIN_BATCHES
+                      << " batches of " << SessionSimulator::BATCH << "), RTP check inconclusive\n";
+        } else if (std::abs(rtp - exactRtp) <= 4.0 * se + 1e-12) {
+            std::cout << "✅ Simulated RTP within 4 standard errors of the exact RTP\n";
+        } else {
+            std::cout << "❌ Simulated RTP differs from the exact RTP by more than 4 standard errors\n";
+            failed = 1;
+        }
+
+        nlohmann::json out;
+        out["scripts_file"] = scriptsFile;
+        out["mode"] = modeName;
+        out["seed"] = seed;
+        out["stopping_rule"] = {{"half_width", rule.halfWidth}, {"confidence", rule.confidence},
+                                {"min_trials", rule.minTrials}, {"max_trials", rule.maxTrials}};
+        out["trials"] = s.trials;
+        out["batches"] = {state.firstBatch, state.nextBatch};
+        if (!checkpointFile.empty()) out["checkpoint"] = checkpointFile;
+        out["converged"] = run.converged;
+        out["rtp"] = rtp;
+        out["half_width"] = run.halfWidth;
+        out["exact_rtp"] = exactRtp;
+        out["std_dev"] = std::sqrt(s.variance());
+        out["max_win"] = s.maxWin;
+        out["win_over_stake_histogram"] = s.histogram;
+        std::ofstream file(outputFile);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        file << out.dump(2) << "\n";
+        std::cout << "\n   Output: " << outputFile << "\n";
+        return failed;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,293 @@
+#include "SS02Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include "ScriptStream.hpp"
+#include "ScriptConfig.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+// Streaming validation of script sets larger than memory. Scripts are read from an NDJSON
+// or binary script stream (ScriptStream.hpp) by a reader thread, handed to evaluator
+// threads through a bounded queue of chunks and folded into running statistics, so memory
+// is bounded by queue depth x chunk size and evaluation overlaps I/O.
+//
+// --convert writes a stream from SS02_scripts.json (or another stream) for later runs.
+
+namespace {
+
+struct Mismatch {
+    bool is_free = false;
+    int index = 0;
+    int expectedPayout = 0, calculatedPayout = 0;
+    int expectedStop = 0, actualStop = 0;
+    bool cascade = true;
+};
+
+// Running payout statistics (Welford), mergeable across threads
+struct SectionStats {
+    uint64_t count = 0;
+    double mean = 0.0, m2 = 0.0;
+    double expectedSum = 0.0;
+    uint64_t payoutMismatches = 0, stopMismatches = 0, cascadingMismatches = 0;
+
+    void add(double payout, double expected) {
+        count++;
+        double delta = payout - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (payout - mean);
+        expectedSum += expected;
+    }
+
+    void merge(const SectionStats& o) {
+        if (o.count == 0) return;
+        uint64_t n = count + o.count;
+        double delta = o.mean - mean;
+        m2 += o.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(o.count) / static_cast<double>(n);
+        mean += delta * static_cast<double>(o.count) / static_cast<double>(n);
+        count = n;
+        expectedSum += o.expectedSum;
+        payoutMismatches += o.payoutMismatches;
+        stopMismatches += o.stopMismatches;
+        cascadingMismatches += o.cascadingMismatches;
+    }
+
+    double variance() const { return count > 0 ? m2 / static_cast<double>(count) : 0.0; }
+};
+
+struct WorkerState {
+    SectionStats base, free;
+    std::vector<Mismatch> mismatches;   // First few only
+};
+
+const size_t kMaxMismatchExamples = 5;
+
+void evaluateChunk(const ScriptChunk& chunk, const SS02BatchEvaluator& baseEval, const SS02BatchEvaluator& freeEval,
+                   WorkerState& state) {
+    for (int section = 0; section < 2; ++section) {
+        const bool isFree = section == 1;
+        std::vector<PackedScript> packed;
+        std::vector<const StreamScript*> scripts;
+        for (const auto& s : chunk.scripts) {
+            if (s.is_free != isFree) continue;
+            packed.push_back(chunk.packed(s));
+            scripts.push_back(&s);
+        }
+        if (packed.empty()) continue;
+        std::vector<BatchScriptResult> results(packed.size());
+        (isFree ? freeEval : baseEval).evaluate(packed.data(), packed.size(), results.data());
+
+        SectionStats& stats = isFree ? state.free : state.base;
+        for (size_t i = 0; i < packed.size(); ++i) {
+            const StreamScript& s = *scripts[i];
+            const BatchScriptResult& r = results[i];
+            stats.add(r.score, s.payout);
+            bool payoutMismatch = r.score != s.payout;
+            bool stopMismatch = r.stop != s.stop;
+            if (payoutMismatch) stats.payoutMismatches++;
+            if (stopMismatch) stats.stopMismatches++;
+            if (!r.cascade_match) stats.cascadingMismatches++;
+            if ((payoutMismatch || stopMismatch || !r.cascade_match) && state.mismatches.size() < kMaxMismatchExamples) {
+                state.mismatches.push_back({isFree, s.index, s.payout, r.score, s.stop, r.stop, r.cascade_match});
+            }
+        }
+    }
+}
+
+void printSection(const std::string& title, const SectionStats& s) {
+    std::cout << "\n========== " << title << " SCRIPTS SUMMARY ==========\n";
+    std::cout << "Total Scripts: " << s.count << "\n";
+    if (s.count == 0) return;
+    std::cout << "Expected Average Payout: " << std::fixed << std::setprecision(2) << s.expectedSum / s.count << "\n";
+    std::cout << "Calculated Average Payout: " << s.mean << "\n";
+    std::cout << "Calculated Payout Variance: " << s.variance() << "\n";
+    std::cout << "Calculated Payout Standard Deviation: " << std::sqrt(s.variance()) << "\n";
+    std::cout << "Payout Mismatches: " << s.payoutMismatches << "\n";
+    std::cout << "Stop Mismatches: " << s.stopMismatches << "\n";
+    std::cout << "Cascading Mismatches: " << s.cascadingMismatches << "\n";
+}
+
+// Writes `input` (a JSON script file or a script stream) as a stream in `format`
+uint64_t convert(const std::string& input, const std::string& output, StreamFormat format, size_t chunkSize) {
+    std::ofstream out(output, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot write to " + output);
+    }
+    ScriptStreamWriter writer(out, format);
+    std::ifstream in(input, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Cannot open " + input);
+    }
+
+    int first = in.peek();
+    bool isStream = first == 'S';
+    if (!isStream && first == '{') {
+        // Either one NDJSON entry per line or a whole JSON document: NDJSON lines carry "section"
+        std::string line;
+        std::getline(in, line);
+        isStream = line.find("\"section\"") != std::string::npos;
+        in.clear();
+        in.seekg(0);
+    }
+
+    ScriptChunk chunk;
+    if (isStream) {
+        ScriptStreamReader reader(in);
+        while (reader.read(chunk, chunkSize)) writer.write(chunk);
+    } else {
+        in.close();
+        auto config = ScriptApp::ScriptConfig::loadFromFile(input);
+        for (const auto* section : {&config.base_scripts, &config.free_scripts}) {
+            for (const auto& [index, data] : *section) {
+                chunk.add(index, data);
+                if (chunk.scripts.size() >= chunkSize) {
+                    writer.write(chunk);
+                    chunk.clear();
+                }
+            }
+        }
+        if (!chunk.scripts.empty()) writer.write(chunk);
+    }
+    return writer.scriptsWritten();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string inputFile = "SS02_scripts.ndjson";
+    std::string convertTo;
+    std::string formatName;
+    size_t queueDepth = 16;
+    size_t chunkSize = 512;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--convert" && i + 1 < argc) {
+            convertTo = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            formatName = argv[++i];
+        } else if (arg == "--queue" && i + 1 < argc) {
+            queueDepth = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--chunk" && i + 1 < argc) {
+            chunkSize = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-" || arg[0] != '-') {
+            inputFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_stream [stream|-] [--threads N] [--queue DEPTH] [--chunk SCRIPTS]\n"
+                         "       SS02_stream input.json --convert output.ndjson|output.ss02b [--format ndjson|binary]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "=== SS02 Streaming Script Validation ===\n\n";
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+
+        if (!convertTo.empty()) {
+            StreamFormat format = ScriptStreamWriter::formatFor(convertTo);
+            if (formatName == "ndjson") format = StreamFormat::Ndjson;
+            else if (formatName == "binary") format = StreamFormat::Binary;
+            else if (!formatName.empty()) throw std::runtime_error("Unknown format: " + formatName);
+            uint64_t written = convert(inputFile, convertTo, format, chunkSize);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "✅ Wrote " << written << " scripts to " << convertTo << " ("
+                      << (format == StreamFormat::Ndjson ? "NDJSON" : "binary") << ") in "
+                      << std::fixed << std::setprecision(1) << ms << " ms\n";
+            return 0;
+        }
+
+        std::ifstream file;
+        if (inputFile != "-") {
+            file.open(inputFile, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open " + inputFile);
+            }
+        }
+        std::istream& in = inputFile == "-" ? std::cin : file;
+        ScriptStreamReader reader(in);
+
+        SlotSS02 baseGame(true, 20.0f, "base");
+        SlotSS02 freeGame(true, 20.0f, "free");
+        SS02BatchEvaluator baseEval(baseGame), freeEval(freeGame);
+
+        std::cout << "Input: " << (inputFile == "-" ? "stdin" : inputFile) << " ("
+                  << (reader.format() == StreamFormat::Ndjson ? "NDJSON" : "binary") << ")\n";
+        std::cout << "Pipeline: 1 reader -> queue of " << queueDepth << " x " << chunkSize << " scripts -> "
+                  << threads << " evaluators (" << SS02BatchEvaluator::isa_name() << ")\n";
+
+        BoundedQueue<ScriptChunk> queue(queueDepth);
+        std::string readError;
+        std::thread readerThread([&]() {
+            try {
+                ScriptChunk chunk;
+                while (reader.read(chunk, chunkSize)) {
+                    if (!queue.push(std::move(chunk))) break;
+                    chunk = ScriptChunk();
+                }
+            } catch (const std::exception& e) {
+                readError = e.what();
+            }
+            queue.close();
+        });
+
+        std::vector<WorkerState> states(threads);
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t]() {
+                ScriptChunk chunk;
+                while (queue.pop(chunk)) evaluateChunk(chunk, baseEval, freeEval, states[t]);
+            });
+        }
+        readerThread.join();
+        for (auto& t : pool) t.join();
+        if (!readError.empty()) {
+            throw std::runtime_error(readError);
+        }
+
+        WorkerState total;
+        for (const auto& s : states) {
+            total.base.merge(s.base);
+            total.free.merge(s.free);
+            total.mismatches.insert(total.mismatches.end(), s.mismatches.begin(), s.mismatches.end());
+        }
+        std::sort(total.mismatches.begin(), total.mismatches.end(), [](const Mismatch& a, const Mismatch& b) {
+            return std::make_pair(a.is_free, a.index) < std::make_pair(b.is_free, b.index);
+        });
+
+        for (size_t i = 0; i < total.mismatches.size() && i < kMaxMismatchExamples; ++i) {
+            const auto& m = total.mismatches[i];
+            std::cout << "❌ " << (m.is_free ? "free" : "base") << " script " << m.index << ": payout "
+                      << m.calculatedPayout << " (expected " << m.expectedPayout << "), stop " << m.actualStop
+                      << " (expected " << m.expectedStop << ")" << (m.cascade ? "" : ", cascading mismatch") << "\n";
+        }
+        printSection("BASE", total.base);
+        printSection("FREE", total.free);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t scripts = total.base.count + total.free.count;
+        std::cout << "\nValidated " << scripts << " scripts (" << std::fixed << std::setprecision(1)
+                  << reader.bytesRead() / (1024.0 * 1024.0) << " MB) in " << std::setprecision(2) << seconds << " s: "
+                  << std::setprecision(0) << (seconds > 0.0 ? scripts / seconds : 0.0) << " scripts/s\n";
+        std::cout << "Peak queue depth: " << queue.peak() << "/" << queue.capacity() << " chunks\n";
+
+        uint64_t mismatches = total.base.payoutMismatches + total.base.stopMismatches + total.base.cascadingMismatches +
+                              total.free.payoutMismatches + total.free.stopMismatches + total.free.cascadingMismatches;
+        if (mismatches == 0) {
+            std::cout << "✅ All scripts match their payouts and stops\n";
+            return 0;
+        }
+        std::cout << "⚠️  " << mismatches << " mismatches found\n";
+        return 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
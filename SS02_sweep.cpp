@@ -0,0 +1,333 @@
+#include "SS02Pay.hpp"
+#include "SS02Analytic.hpp"
+#include "ScriptConfig.h"
+#include "Checkpoint.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+// Parameter sweep over FG trigger, FG retrigger, multiplier volatility table and ante
+// multiplier. Script payouts are evaluated once into an outcome cache; every grid point is
+// then solved analytically (SS02AnalyticRtp), in parallel.
+//
+// Values are given as a comma list ("0.004,0.005") or an inclusive range ("0.003:0.006:0.0005").
+//
+// --checkpoint saves the finished rows every --checkpoint-interval seconds; --resume reloads
+// them and only solves the points that were not finished (or failed).
+
+namespace {
+
+struct SweepPoint {
+    RtpParameters params;
+    double ante = 1.5;
+};
+
+// Everything the sweep reports per point; plain doubles so rows go straight into checkpoints
+struct SweepRow {
+    double rtp = 0.0, baseRtp = 0.0, freeRtp = 0.0;
+    double antebetRtp = 0.0;
+    double mysteryTrigger = 0.0;
+    double spinStdDev = 0.0;
+    double lengthMean = 0.0, sessionMean = 0.0, sessionStdDev = 0.0;
+    double sessionP99 = 0.0, sessionP999 = 0.0, spinP9999 = 0.0;   // With --quantiles
+};
+
+std::vector<double> parseValues(const std::string& text) {
+    std::vector<double> values;
+    if (std::count(text.begin(), text.end(), ':') == 2) {
+        std::istringstream iss(text);
+        std::string a, b, c;
+        std::getline(iss, a, ':');
+        std::getline(iss, b, ':');
+        std::getline(iss, c, ':');
+        double start = std::stod(a), end = std::stod(b), step = std::stod(c);
+        if (step <= 0.0) throw std::runtime_error("Range step must be positive: " + text);
+        for (int i = 0; start + i * step <= end + step * 1e-9; ++i) values.push_back(start + i * step);
+    } else {
+        std::istringstream iss(text);
+        std::string item;
+        while (std::getline(iss, item, ',')) values.push_back(std::stod(item));
+    }
+    if (values.empty()) throw std::runtime_error("No values in: " + text);
+    return values;
+}
+
+std::vector<std::string> parseNames(const std::string& text) {
+    std::vector<std::string> names;
+    std::istringstream iss(text);
+    std::string item;
+    while (std::getline(iss, item, ',')) names.push_back(item);
+    return names;
+}
+
+// Same relationships as the ANTEBET RTP CALCULATION in SS02_test, with the ante
+// multiplier as a parameter (SS02_test uses 1.5, i.e. a 30 credit ante bet on 20)
+void computeAntebet(const SweepPoint& point, const RtpReport& r, SweepRow& row) {
+    const double anteBet = point.params.bet * point.ante;
+    row.antebetRtp = (r.spinMean * point.ante - r.baseMean) / anteBet;
+    double averageFeatureValue = r.freeSpinMean * r.sessionLengthMean / anteBet;
+    double expectedPullsToFG = averageFeatureValue / row.antebetRtp;
+    row.mysteryTrigger = 1.0 - (1.0 - 1.0 / expectedPullsToFG) / (1.0 - point.params.fgTrigger);
+}
+
+SweepRow makeRow(const SweepPoint& point, const RtpReport& r, bool quantiles) {
+    SweepRow row;
+    row.rtp = r.rtp;
+    row.baseRtp = r.baseRtp;
+    row.freeRtp = r.freeRtp;
+    row.spinStdDev = std::sqrt(r.spinVariance);
+    row.lengthMean = r.sessionLengthMean;
+    row.sessionMean = r.sessionMean;
+    row.sessionStdDev = std::sqrt(r.sessionVariance);
+    if (quantiles) {
+        row.sessionP99 = r.session.quantile(0.99);
+        row.sessionP999 = r.session.quantile(0.999);
+        row.spinP9999 = r.spin.quantile(0.9999);
+    }
+    computeAntebet(point, r, row);
+    return row;
+}
+
+uint64_t sweepFingerprint(const ScriptOutcomeCache& cache, const std::vector<SweepPoint>& points, bool quantiles) {
+    Checkpoint::Fingerprint hash;
+    hash.add(cache.fingerprint()).add(quantiles).add<uint64_t>(points.size());
+    for (const auto& p : points) {
+        hash.add(p.params.bet).add(p.params.fgTrigger).add(p.params.fgRetrigger).add(p.params.fgRounds)
+            .add(p.params.volatility).add(p.params.drawMultipliers).add(p.ante);
+    }
+    return hash.value();
+}
+
+// Payload: group count, then per solve group a done flag followed by its rows when done
+void saveSweep(const std::string& path, uint64_t fingerprint, const std::vector<char>& done,
+               const std::vector<SweepRow>& rows, size_t anteCount) {
+    Checkpoint::Writer out;
+    out.put<uint64_t>(done.size());
+    for (size_t g = 0; g < done.size(); ++g) {
+        out.put<uint8_t>(done[g]);
+        if (!done[g]) continue;
+        for (size_t a = 0; a < anteCount; ++a) out.put(rows[g * anteCount + a]);
+    }
+    out.save(path, Checkpoint::SWEEP, fingerprint);
+}
+
+size_t loadSweep(const std::string& path, uint64_t fingerprint, std::vector<char>& done,
+                 std::vector<SweepRow>& rows, size_t anteCount) {
+    Checkpoint::Reader in(path, Checkpoint::SWEEP, fingerprint);
+    if (in.get<uint64_t>() != done.size()) {
+        throw std::runtime_error(path + ": grid size does not match");
+    }
+    size_t finished = 0;
+    for (size_t g = 0; g < done.size(); ++g) {
+        done[g] = static_cast<char>(in.get<uint8_t>());
+        if (!done[g]) continue;
+        for (size_t a = 0; a < anteCount; ++a) rows[g * anteCount + a] = in.get<SweepRow>();
+        finished++;
+    }
+    return finished;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string scriptsFile = "SS02_scripts.json";
+    std::string outputFile = "SS02_sweep.csv";
+    std::string triggers, retriggers, volatilities, antes = "1.5";
+    bool drawMultipliers = true;
+    bool quantiles = false;
+    std::string checkpointFile;
+    double checkpointInterval = 60.0;
+    bool resume = false;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SlotSS02 game(true, 20.0f, "free");
+    RtpParameters defaults = RtpParameters::fromGame(game);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--trigger" && i + 1 < argc) {
+            triggers = argv[++i];
+        } else if (arg == "--retrigger" && i + 1 < argc) {
+            retriggers = argv[++i];
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            volatilities = argv[++i];
+        } else if (arg == "--ante" && i + 1 < argc) {
+            antes = argv[++i];
+        } else if (arg == "--flat-multipliers") {
+            drawMultipliers = false;
+        } else if (arg == "--quantiles") {
+            quantiles = true;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            checkpointInterval = std::stod(argv[++i]);
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (arg[0] != '-') {
+            scriptsFile = arg;
+        } else {
+            std::cerr << "Usage: SS02_sweep [scripts.json] [--trigger LIST|A:B:STEP] [--retrigger LIST|A:B:STEP]"
+                         " [--volatility low,high] [--ante LIST] [--flat-multipliers] [--quantiles] [--checkpoint FILE]"
+                         " [--checkpoint-interval SEC] [--resume] [--threads N] [-o sweep.csv]\n";
+            return 1;
+        }
+    }
+    if (resume && checkpointFile.empty()) {
+        checkpointFile = "SS02_sweep.ckpt";
+    }
+
+    std::cout << "=== SS02 Parameter Sweep ===\n\n";
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        auto config = loadSS02Scripts(scriptsFile);
+        ScriptOutcomeCache cache = ScriptOutcomeCache::build(config);
+        SS02AnalyticRtp solver(cache);
+
+        std::vector<double> triggerValues = triggers.empty() ? std::vector<double>{defaults.fgTrigger} : parseValues(triggers);
+        std::vector<double> retriggerValues = retriggers.empty() ? std::vector<double>{defaults.fgRetrigger} : parseValues(retriggers);
+        std::vector<std::string> volatilityValues = volatilities.empty() ? std::vector<std::string>{defaults.volatility} : parseNames(volatilities);
+        std::vector<double> anteValues = parseValues(antes);
+        for (const auto& volatility : volatilityValues) RtpParameters::checkVolatility(volatility);
+
+        std::vector<SweepPoint> points;
+        for (const auto& volatility : volatilityValues) {
+            for (double trigger : triggerValues) {
+                for (double retrigger : retriggerValues) {
+                    for (double ante : anteValues) {
+                        SweepPoint point;
+                        point.params = defaults;
+                        point.params.fgTrigger = trigger;
+                        point.params.fgRetrigger = retrigger;
+                        point.params.volatility = volatility;
+                        point.params.drawMultipliers = drawMultipliers;
+                        point.ante = ante;
+                        points.push_back(point);
+                    }
+                }
+            }
+        }
+        std::cout << "Scripts: " << cache.base.size() << " base, " << cache.free.size() << " free\n";
+        std::cout << "Grid: " << volatilityValues.size() << " volatility x " << triggerValues.size() << " trigger x "
+                  << retriggerValues.size() << " retrigger x " << anteValues.size() << " ante = "
+                  << points.size() << " points, " << threads << " threads\n";
+
+        // The ante multiplier does not change the solve: one solve per group of consecutive
+        // points that only differ in ante. Every solve only reads the shared outcome cache.
+        const size_t anteCount = anteValues.size();
+        const size_t solves = points.size() / anteCount;
+        std::vector<SweepRow> rows(points.size());
+        std::vector<std::string> errors(points.size());
+        std::vector<char> done(solves, 0);
+        const uint64_t fingerprint = sweepFingerprint(cache, points, quantiles);
+        if (resume) {
+            const size_t finished = loadSweep(checkpointFile, fingerprint, done, rows, anteCount);
+            std::cout << "Resuming " << checkpointFile << ": " << finished << " of " << solves << " solves done\n";
+        }
+        std::vector<size_t> todo;
+        for (size_t g = 0; g < solves; ++g) {
+            if (!done[g]) todo.push_back(g);
+        }
+
+        // Workers write disjoint rows; `done` and the checkpoint file are guarded by the mutex
+        std::mutex mutex;
+        auto lastSave = std::chrono::steady_clock::now();
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next++; i < todo.size(); i = next++) {
+                const size_t g = todo[i];
+                try {
+                    RtpReport report = solver.solve(points[g * anteCount].params, quantiles ? (1 << 16) : 0);
+                    for (size_t a = 0; a < anteCount; ++a) {
+                        rows[g * anteCount + a] = makeRow(points[g * anteCount + a], report, quantiles);
+                    }
+                } catch (const std::exception& e) {
+                    for (size_t a = 0; a < anteCount; ++a) errors[g * anteCount + a] = e.what();
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                done[g] = 1;
+                const auto now = std::chrono::steady_clock::now();
+                if (!checkpointFile.empty() && std::chrono::duration<double>(now - lastSave).count() >= checkpointInterval) {
+                    try {
+                        saveSweep(checkpointFile, fingerprint, done, rows, anteCount);
+                    } catch (const std::exception& e) {
+                        std::cerr << "⚠️  " << e.what() << "\n";
+                    }
+                    lastSave = now;
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+        if (!checkpointFile.empty()) {
+            saveSweep(checkpointFile, fingerprint, done, rows, anteCount);
+        }
+
+        std::ofstream csv(outputFile);
+        if (!csv.is_open()) {
+            throw std::runtime_error("Cannot write to " + outputFile);
+        }
+        csv << "volatility,fg_trigger,fg_retrigger,ante,rtp,base_rtp,free_rtp,antebet_rtp,mystery_trigger,"
+               "spin_std_dev,fg_length_mean,fg_session_mean,fg_session_std_dev";
+        if (quantiles) csv << ",fg_session_p99,fg_session_p999,spin_p9999";
+        csv << "\n";
+        csv << std::setprecision(10);
+
+        std::cout << "\n" << std::left << std::setw(6) << "Vol" << std::right << std::setw(9) << "Trigger"
+                  << std::setw(10) << "Retrig" << std::setw(6) << "Ante" << std::setw(9) << "RTP"
+                  << std::setw(9) << "Base" << std::setw(9) << "Free" << std::setw(9) << "Antebet"
+                  << std::setw(9) << "Mystery" << std::setw(10) << "SpinSD" << "\n";
+        int failed = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& p = points[i];
+            if (!errors[i].empty()) {
+                std::cerr << "❌ trigger " << p.params.fgTrigger << ", retrigger " << p.params.fgRetrigger
+                          << ": " << errors[i] << "\n";
+                failed++;
+                continue;
+            }
+            const auto& r = rows[i];
+            csv << p.params.volatility << "," << p.params.fgTrigger << "," << p.params.fgRetrigger << "," << p.ante << ","
+                << r.rtp << "," << r.baseRtp << "," << r.freeRtp << "," << r.antebetRtp << ","
+                << r.mysteryTrigger << "," << r.spinStdDev << "," << r.lengthMean << ","
+                << r.sessionMean << "," << r.sessionStdDev;
+            if (quantiles) {
+                csv << "," << r.sessionP99 << "," << r.sessionP999 << "," << r.spinP9999;
+            }
+            csv << "\n";
+
+            std::cout << std::left << std::setw(6) << p.params.volatility << std::right << std::fixed
+                      << std::setprecision(4) << std::setw(9) << p.params.fgTrigger << std::setw(10) << p.params.fgRetrigger
+                      << std::setprecision(2) << std::setw(6) << p.ante << std::setprecision(4) << std::setw(9) << r.rtp
+                      << std::setw(9) << r.baseRtp << std::setw(9) << r.freeRtp << std::setw(9) << r.antebetRtp
+                      << std::setw(9) << r.mysteryTrigger << std::setprecision(2) << std::setw(10)
+                      << r.spinStdDev << "\n";
+        }
+        csv.close();
+
+        double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "\n✅ Evaluated " << points.size() - failed << " points in " << std::fixed << std::setprecision(1) << duration << " ms\n";
+        if (failed > 0) {
+            std::cout << "⚠️  " << failed << " points failed\n";
+        }
+        std::cout << "   Output: " << outputFile << "\n";
+        return failed == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -2,6 +2,10 @@
 #include "SS02Pay.hpp"
 #include "ScriptConfig.h"
 #include "BoardAnalyzer.h"
+#include "ResultsTable.h"
+#include "SS02Analytic.hpp"
+#define SS02_INSTRUMENT_MAIN
+#include "Instrumentation.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -37,6 +41,7 @@ static void analyzeScriptSet(const std::map<int, ScriptApp::ScriptData>& scripts
     int displayCount = 0;  // Track displayed items (mismatches + errors)
     
     std::cout << "\n***** RUNNING MISMATCH CHECKS: Stop, Cascading, Terminal *****\n";
+    Instrumentation::instance().counter("scripts") += static_cast<long long>(scripts.size());
     
     for (const auto& [index, scriptData] : scripts) {
         // Create a new SS02Pay instance for each script with appropriate game type
@@ -182,7 +187,7 @@ static void analyzeScriptSet(const std::map<int, ScriptApp::ScriptData>& scripts
 }
 
 // Main SS02 analysis function
-static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContext& context) {
+static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContext& context, bool resultsJson) {
     // Create a game instance to get the FG trigger probability from SS02
     SlotSS02 game(true, 20.0f, "base");
     double fgTriggerProb = game.get_fg_trigger_probability();
@@ -206,7 +211,10 @@ static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContex
     double freeTotalCalculated = 0.0;
     
     // Store current totals before analyzing base scripts
-    analyzeScriptSet(config.base_scripts, "BASE", "base", context);
+    {
+        Instrumentation::ScopedTimer timer("base scripts");
+        analyzeScriptSet(config.base_scripts, "BASE", "base", context);
+    }
     baseTotalExpected = context.totalPayout;
     baseTotalCalculated = context.totalCalculatedPayout;
     
@@ -215,7 +223,10 @@ static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContex
     context.totalCalculatedPayout = 0.0;
     
     // Analyze free scripts
-    analyzeScriptSet(config.free_scripts, "FREE", "free", context);
+    {
+        Instrumentation::ScopedTimer timer("free scripts");
+        analyzeScriptSet(config.free_scripts, "FREE", "free", context);
+    }
     freeTotalExpected = context.totalPayout;
     freeTotalCalculated = context.totalCalculatedPayout;
     
@@ -283,6 +294,39 @@ static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContex
     std::cout << "  Calculated Average: " << std::fixed << std::setprecision(2) << overallCalculatedAvg << "\n";
     std::cout << "  Average Difference: " << std::fixed << std::setprecision(2) << (overallCalculatedAvg - overallExpectedAvg) << "\n";
     
+    // Exact RTP over the FG session structure and multiplier table draws
+    std::cout << "\n==============================================\n";
+    std::cout << "       ANALYTIC RTP (FG SESSIONS)\n";
+    std::cout << "==============================================\n";
+    try {
+        Instrumentation::ScopedTimer timer("analytic rtp");
+        ScriptOutcomeCache outcomes = ScriptOutcomeCache::build(config);
+        SS02AnalyticRtp solver(outcomes);
+        RtpParameters params = RtpParameters::fromGame(game);
+        params.buyCost = config.buy_free_game_multiplier;
+        RtpReport drawn = solver.solve(params);
+        params.drawMultipliers = false;
+        RtpReport flat = solver.solve(params, 0);
+
+        std::cout << "FG Length: mean " << std::fixed << std::setprecision(2) << drawn.sessionLengthMean
+                  << ", std dev " << std::sqrt(drawn.sessionLengthVariance) << "\n";
+        std::cout << "RTP (script multipliers): " << std::setprecision(4) << flat.rtp
+                  << " (base " << flat.baseRtp << ", free " << flat.freeRtp << ")\n";
+        std::cout << "RTP (" << params.volatility << " multiplier table draws): " << drawn.rtp
+                  << " (base " << drawn.baseRtp << ", free " << drawn.freeRtp << ")\n";
+        std::cout << "FG Session: mean " << std::setprecision(2) << drawn.sessionMean
+                  << ", std dev " << std::sqrt(drawn.sessionVariance)
+                  << ", P99 " << drawn.session.quantile(0.99) << ", P99.9 " << drawn.session.quantile(0.999) << "\n";
+        std::cout << "Per Base Spin: std dev " << std::sqrt(drawn.spinVariance)
+                  << ", P99.9 " << drawn.spin.quantile(0.999) << ", P99.99 " << drawn.spin.quantile(0.9999) << "\n";
+        std::cout << "Buy Feature (" << std::setprecision(0) << params.buyCost << "x bet"
+                  << (outcomes.buy.empty() ? ", no buy_free scripts" : "") << "): RTP " << std::setprecision(4)
+                  << drawn.buyRtp << ", std dev " << std::sqrt(drawn.buyVariance) / (params.buyCost * params.bet)
+                  << "x cost\n";
+    } catch (const std::exception& e) {
+        std::cerr << "⚠️  Warning: Analytic RTP failed: " << e.what() << "\n";
+    }
+
     // Calculate Antebet Free RTP
     std::cout << "\n==============================================\n";
     std::cout << "       ANTEBET RTP CALCULATION\n";
@@ -326,32 +370,110 @@ static void analyzeScripts(const ScriptApp::ScriptConfig& config, AnalysisContex
     std::cout << "\n==============================================\n";
     std::cout << "       Report Generation\n";
     std::cout << "==============================================\n";
-    // Export detailed results to JSON file with separated base and free sections
-    BoardAnalyzer::exportResultsToJson("script_results.json", 
-                       config.base_scripts.size(), 
-                       config.free_scripts.size(),
-                       baseTotalExpected, baseTotalCalculated,
-                       freeTotalExpected, freeTotalCalculated,
-                       fgTriggerProb, context);
+    // Export per-script results as columns (query with SS02_query); the JSON report is opt-in
+    Instrumentation::ScopedTimer timer("report export");
+    ResultsTable::fromContext(context, config.base_scripts.size(), fgTriggerProb).save("script_results.ss02r");
+    std::cout << "Results exported to script_results.ss02r\n";
+    if (resultsJson) {
+        BoardAnalyzer::exportResultsToJson("script_results.json", 
+                           config.base_scripts.size(), 
+                           config.free_scripts.size(),
+                           baseTotalExpected, baseTotalCalculated,
+                           freeTotalExpected, freeTotalCalculated,
+                           fgTriggerProb, context);
+    }
 }
 
-int main() {
+// Loads a backend reel-format file (FG_hist/Insert_Script.json): every section must come back
+// non-empty and every replayed script must stop after its recorded stopover boards
+bool checkBackendScripts(const std::string& filename) {
+    std::cout << "\n============================================\n";
+    std::cout << "Backend Script File: " << filename << "\n";
+    std::cout << "============================================\n";
+    std::ifstream probe(filename);
+    if (!probe.is_open()) {
+        std::cout << "⚠️  " << filename << " not found, skipped\n";
+        return true;
+    }
+    auto config = loadSS02Scripts(filename);
+    bool ok = true;
+    auto checkSection = [&](const char* name, const std::map<int, ScriptApp::ScriptData>& scripts) {
+        size_t stopMismatches = 0;
+        for (const auto& [index, data] : scripts) {
+            if (static_cast<int>(data.script.size()) != data.stop) stopMismatches++;
+        }
+        std::cout << "  " << name << ": " << scripts.size() << " scripts, " << stopMismatches << " stopover mismatches\n";
+        if (scripts.empty() || stopMismatches > 0) ok = false;
+    };
+    checkSection("base", config.base_scripts);
+    checkSection("free", config.free_scripts);
+    checkSection("buy_free", config.buy_free_scripts);
+    std::cout << "  buy_free_game_multiplier: " << config.buy_free_game_multiplier << "\n";
+    if (ok) {
+        std::cout << "✅ Reel entries replayed into boards for every section\n";
+    } else {
+        std::cout << "❌ Reel-format scripts did not load correctly\n";
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool profile = false;
+    std::string profileJson;
+    bool perfCounters = false;
+    bool resultsJson = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--profile-json" && i + 1 < argc) {
+            profileJson = argv[++i];
+        } else if (arg == "--perf") {
+            perfCounters = true;
+        } else if (arg == "--results-json") {
+            resultsJson = true;
+        } else {
+            std::cerr << "Usage: SS02_test [--profile] [--profile-json FILE] [--perf] [--results-json]\n";
+            return 1;
+        }
+    }
+
     std::cout << "=== SS02Pay Script Test Program ===\n\n";
+    if (perfCounters && !Instrumentation::instance().enableHardwareCounters()) {
+        std::cout << "⚠️  Hardware counters unavailable, reporting wall time only\n\n";
+    }
     
     try {
         std::cout << "DEBUG: About to load configuration file\n";
-        auto config = ScriptApp::ScriptConfig::loadFromFile("SS02_scripts.json");
+        ScriptApp::ScriptConfig config;
+        {
+            Instrumentation::ScopedTimer timer("load");
+            config = ScriptApp::ScriptConfig::loadFromFile("SS02_scripts.json");
+        }
         std::cout << "DEBUG: Configuration file loaded successfully\n\n";
 
         // Create analysis context
         AnalysisContext context;
 
         // Check first board uniqueness for both base and free
-        BoardAnalyzer::checkFirstBoardUniqueness(config);
+        {
+            Instrumentation::ScopedTimer timer("first board uniqueness");
+            BoardAnalyzer::checkFirstBoardUniqueness(config);
+        }
         
         // Analyze all scripts (base and free separately) - SS02-specific version
-        analyzeScripts(config, context);
+        {
+            Instrumentation::ScopedTimer timer("analysis");
+            analyzeScripts(config, context, resultsJson);
+        }
         
+        bool backendOk = true;
+        {
+            Instrumentation::ScopedTimer timer("backend scripts");
+            backendOk = checkBackendScripts("FG_hist/Insert_Script.json");
+        }
+
         // Export multiplier tables
         std::cout << "\n============================================\n";
         std::cout << "Exporting Multiplier Tables\n";
@@ -382,8 +504,19 @@ int main() {
         } catch (const std::exception& e) {
             std::cerr << "⚠️  Warning: Failed to export multiplier tables: " << e.what() << "\n";
         }
+
+        if (profile || perfCounters) {
+            Instrumentation::instance().printReport();
+        }
+        if (!profileJson.empty()) {
+            if (Instrumentation::instance().exportJson(profileJson)) {
+                std::cout << "✅ Exported instrumentation to " << profileJson << "\n";
+            } else {
+                std::cerr << "⚠️  Warning: Could not open " << profileJson << " for writing\n";
+            }
+        }
         
-        return 0;
+        return backendOk ? 0 : 1;
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
@@ -7,8 +7,10 @@
 #include <fstream>
 #include <stdexcept>
 #include <map>
+#include <functional>
 #include "json.hpp"
 #include "SlotPay.hpp"
+#include "ReelConverter.h"
 
 namespace ScriptApp {
 
@@ -20,16 +22,56 @@ struct ScriptData {
     int payout = 0;                     // Payout value
     int payout_id = 0;                  // Payout identifier
     int special_multipliers = 1;        // Special multiplier value (default 1 for no multiplier effect)
-    int multiple_table = 0;             // Multiple table value (only for free section)
+    int multiple_table = 0;             // Multiplier table: free 0/1 (ids 1/2), buy_free the id 1/2 itself
     bool is_free = false;               // Flag to indicate if this is from free section
 };
 
 struct ScriptConfig {
     std::map<int, ScriptData> base_scripts;  // Map of index to base script data
     std::map<int, ScriptData> free_scripts;  // Map of index to free script data
-    
+    std::map<int, ScriptData> buy_free_scripts;  // Free spins of a bought feature (Insert_Script.json "buy_free")
+    int buy_free_game_multiplier = 100;      // Buy feature price in bets ("config" section)
+    size_t skipped_reel_entries = 0;         // Reel entries loaded without a replayer
+
+    // Plays a reel-format entry back into its board sequence; isFree selects the game type
+    using ReelReplayer = std::function<std::vector<Board>(const ReelScript& reel, bool isFree)>;
+
+    // Backend files (Insert_Script.json, FG_hist/Script*.json) store each script as reel
+    // strips: {"number", "stopover", "script": [{"index", "stop", "reel"}]}
+    static bool isReelEntry(const nlohmann::json& entry) {
+        return entry.contains("number") && !entry.contains("index");
+    }
+
+
+    // Parses one base or free entry as found in SS02_scripts.json (the entry's "index"
+    // is read by the caller)
+    static ScriptData parseEntry(const nlohmann::json& entry, bool isFree) {
+        ScriptData scriptData;
+        scriptData.script = entry.at("script").get<ScriptData::Script>();
+        scriptData.stop = entry.at("stop").get<int>();
+        scriptData.is_free = isFree;
+        
+        // Read payout information
+        if (entry.contains("payout") && !entry.at("payout").is_null()) {
+            scriptData.payout = entry.at("payout").get<int>();
+        }
+        if (entry.contains("payout_id") && !entry.at("payout_id").is_null()) {
+            scriptData.payout_id = entry.at("payout_id").get<int>();
+        }
+        if (entry.contains("special_multipliers") && !entry.at("special_multipliers").is_null()) {
+            scriptData.special_multipliers = entry.at("special_multipliers").get<int>();
+        }
+        
+        // Set multiple_table to 1 if special_multipliers is 3 or 20
+        if (isFree && (scriptData.special_multipliers == 1 || scriptData.special_multipliers == 20 || scriptData.special_multipliers == 40)) {
+            scriptData.multiple_table = 1;
+        }
+        return scriptData;
+    }
 
-    static ScriptConfig loadFromFile(const std::string& filename) {
+    // Board-format entries are read as is. Reel-format entries are replayed into boards with
+    // `replay`; without one they are skipped and counted in skipped_reel_entries.
+    static ScriptConfig loadFromFile(const std::string& filename, const ReelReplayer& replay = {}) {
         std::ifstream file(filename);
         if (!file.is_open()) {
             throw std::runtime_error("Unable to open script configuration file: " + filename);
@@ -45,61 +87,37 @@ struct ScriptConfig {
         if (j.contains("result")) {
             // SS02_scripts.json format - data is nested under "result"
             data = j.at("result");
+        } else if (j.contains("data")) {
+            // Backend format (Insert_Script.json), board or reel entries
+            data = j.at("data");
         }
         
-        // Process base entries
-        if (data.contains("base")) {
-            for (const auto& base : data.at("base")) {
-                int index = base.at("index").get<int>();
-                
-                ScriptData scriptData;
-                scriptData.script = base.at("script").get<ScriptData::Script>();
-                scriptData.stop = base.at("stop").get<int>();
-                scriptData.is_free = false;
-                
-                // Read payout information
-                if (base.contains("payout") && !base.at("payout").is_null()) {
-                    scriptData.payout = base.at("payout").get<int>();
+        // Reads one section into `out`; buy_free entries are free spins (MULTIPLIER cells, multiple_table)
+        auto readSection = [&](const char* name, bool isFree, std::map<int, ScriptData>& out) {
+            if (!data.contains(name) || !data.at(name).is_array()) return;
+            for (const auto& entry : data.at(name)) {
+                if (!isReelEntry(entry)) {
+                    out[entry.at("index").get<int>()] = parseEntry(entry, isFree);
+                    continue;
                 }
-                if (base.contains("payout_id") && !base.at("payout_id").is_null()) {
-                    scriptData.payout_id = base.at("payout_id").get<int>();
+                if (!replay) {
+                    config.skipped_reel_entries++;
+                    continue;
                 }
-                if (base.contains("special_multipliers") && !base.at("special_multipliers").is_null()) {
-                    scriptData.special_multipliers = base.at("special_multipliers").get<int>();
-                }
-                
-                config.base_scripts[index] = scriptData;
-            }
-        }
-        
-        // Process free entries
-        if (data.contains("free")) {
-            for (const auto& free : data.at("free")) {
-                int index = free.at("index").get<int>();
-                
+                const ReelScript reel = ReelConverter::parseEntry(entry);
                 ScriptData scriptData;
-                scriptData.script = free.at("script").get<ScriptData::Script>();
-                scriptData.stop = free.at("stop").get<int>();
-                scriptData.is_free = true;
-                
-                // Read payout information
-                if (free.contains("payout") && !free.at("payout").is_null()) {
-                    scriptData.payout = free.at("payout").get<int>();
-                }
-                if (free.contains("payout_id") && !free.at("payout_id").is_null()) {
-                    scriptData.payout_id = free.at("payout_id").get<int>();
-                }
-                if (free.contains("special_multipliers") && !free.at("special_multipliers").is_null()) {
-                    scriptData.special_multipliers = free.at("special_multipliers").get<int>();
-                }
-                
-                // Set multiple_table to 1 if special_multipliers is 3 or 20
-                if (scriptData.special_multipliers == 1 || scriptData.special_multipliers == 20 || scriptData.special_multipliers == 40) {
-                    scriptData.multiple_table = 1;
-                }
-                
-                config.free_scripts[index] = scriptData;
+                scriptData.script = replay(reel, isFree);
+                scriptData.stop = reel.stopover;
+                scriptData.multiple_table = reel.multiple_table;
+                scriptData.is_free = isFree;
+                out[reel.number] = std::move(scriptData);
             }
+        };
+        readSection("base", false, config.base_scripts);
+        readSection("free", true, config.free_scripts);
+        readSection("buy_free", true, config.buy_free_scripts);
+        if (data.contains("config") && data.at("config").contains("buy_free_game_multiplier")) {
+            config.buy_free_game_multiplier = data.at("config").at("buy_free_game_multiplier").get<int>();
         }
         
         return config;
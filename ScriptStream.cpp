@@ -0,0 +1,223 @@
+#include "ScriptStream.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[8] = {'S', 'S', '0', '2', 'S', 'C', 'R', 'B'};
+const uint32_t kVersion = 1;
+const size_t kRecordBytes = 24;
+
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+uint32_t get32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+int board(const PackedScript& script, int b, int cell) {
+    uint8_t v = script.boards[b * SS02BatchEvaluator::CELLS + cell];
+    return v == SS02BatchEvaluator::EMPTY ? -1 : v;
+}
+
+}  // namespace
+
+void ScriptChunk::add(int index, const ScriptApp::ScriptData& data) {
+    StreamScript s;
+    s.is_free = data.is_free;
+    s.index = index;
+    s.stop = data.stop;
+    s.payout = data.payout;
+    s.payout_id = data.payout_id;
+    s.special_multipliers = data.special_multipliers;
+    s.multiple_table = data.multiple_table;
+    s.offset = cells.size();
+    s.board_count = static_cast<int>(data.script.size());
+    for (const auto& b : data.script) {
+        if (b.size() != SS02BatchEvaluator::HEIGHT || b[0].size() != SS02BatchEvaluator::WIDTH) {
+            throw std::runtime_error("Script " + std::to_string(index) + ": boards must be 5x6");
+        }
+        cells.resize(cells.size() + SS02BatchEvaluator::CELLS);
+        SS02BatchEvaluator::packBoard(b, cells.data() + cells.size() - SS02BatchEvaluator::CELLS);
+    }
+    scripts.push_back(s);
+}
+
+PackedScript ScriptChunk::packed(const StreamScript& script) const {
+    PackedScript p;
+    p.boards = cells.data() + script.offset;
+    p.board_count = script.board_count;
+    p.special_multipliers = script.special_multipliers;
+    return p;
+}
+
+ScriptStreamReader::ScriptStreamReader(std::istream& in) : in_(in) {
+    // NDJSON lines start with '{' (or whitespace); only the binary magic starts with 'S'
+    if (in_.peek() != kMagic[0]) {
+        format_ = StreamFormat::Ndjson;
+        return;
+    }
+    char magic[sizeof(kMagic)] = {};
+    uint8_t version[4] = {};
+    in_.read(magic, sizeof(magic));
+    in_.read(reinterpret_cast<char*>(version), sizeof(version));
+    if (!in_ || std::memcmp(magic, kMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Script stream is neither NDJSON nor a binary script stream");
+    }
+    if (get32(version) != kVersion) {
+        throw std::runtime_error("Unsupported binary script stream version " + std::to_string(get32(version)));
+    }
+    format_ = StreamFormat::Binary;
+    bytesRead_ = sizeof(kMagic) + sizeof(version);
+}
+
+bool ScriptStreamReader::read(ScriptChunk& chunk, size_t maxScripts) {
+    chunk.clear();
+    return format_ == StreamFormat::Binary ? readBinary(chunk, maxScripts) : readNdjson(chunk, maxScripts);
+}
+
+bool ScriptStreamReader::readNdjson(ScriptChunk& chunk, size_t maxScripts) {
+    std::string line;
+    while (chunk.scripts.size() < maxScripts && std::getline(in_, line)) {
+        bytesRead_ += line.size() + 1;
+        line_++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        try {
+            nlohmann::json entry = nlohmann::json::parse(line);
+            std::string section = entry.value("section", "base");
+            if (section != "base" && section != "free") {
+                throw std::runtime_error("unknown section '" + section + "'");
+            }
+            int index = entry.at("index").get<int>();
+            chunk.add(index, ScriptApp::ScriptConfig::parseEntry(entry, section == "free"));
+        } catch (const std::exception& e) {
+            throw std::runtime_error("NDJSON line " + std::to_string(line_) + ": " + e.what());
+        }
+    }
+    return !chunk.scripts.empty();
+}
+
+bool ScriptStreamReader::readBinary(ScriptChunk& chunk, size_t maxScripts) {
+    while (chunk.scripts.size() < maxScripts) {
+        if (pendingPos_ >= pending_.scripts.size()) {
+            uint8_t header[8];
+            in_.read(reinterpret_cast<char*>(header), sizeof(header));
+            if (in_.gcount() == 0) break;
+            if (in_.gcount() != sizeof(header)) throw std::runtime_error("Truncated binary chunk header");
+            const uint32_t count = get32(header);
+            const uint32_t cellBytes = get32(header + 4);
+            std::vector<uint8_t> records(static_cast<size_t>(count) * kRecordBytes);
+            pending_.clear();
+            pending_.cells.resize(cellBytes);
+            in_.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size()));
+            in_.read(reinterpret_cast<char*>(pending_.cells.data()), cellBytes);
+            if (!in_) throw std::runtime_error("Truncated binary chunk");
+            bytesRead_ += sizeof(header) + records.size() + cellBytes;
+
+            size_t offset = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                const uint8_t* r = records.data() + i * kRecordBytes;
+                StreamScript s;
+                s.is_free = r[0] != 0;
+                s.multiple_table = r[1];
+                s.board_count = r[2] | r[3] << 8;
+                s.index = static_cast<int32_t>(get32(r + 4));
+                s.stop = static_cast<int32_t>(get32(r + 8));
+                s.payout = static_cast<int32_t>(get32(r + 12));
+                s.payout_id = static_cast<int32_t>(get32(r + 16));
+                s.special_multipliers = static_cast<int32_t>(get32(r + 20));
+                s.offset = offset;
+                offset += static_cast<size_t>(s.board_count) * SS02BatchEvaluator::CELLS;
+                if (offset > cellBytes) throw std::runtime_error("Binary chunk records exceed its cell data");
+                pending_.scripts.push_back(s);
+            }
+            pendingPos_ = 0;
+        }
+        // Move scripts from the decoded chunk, rebasing their cell offsets
+        while (pendingPos_ < pending_.scripts.size() && chunk.scripts.size() < maxScripts) {
+            StreamScript s = pending_.scripts[pendingPos_++];
+            const uint8_t* src = pending_.cells.data() + s.offset;
+            s.offset = chunk.cells.size();
+            chunk.cells.insert(chunk.cells.end(), src, src + static_cast<size_t>(s.board_count) * SS02BatchEvaluator::CELLS);
+            chunk.scripts.push_back(s);
+        }
+    }
+    return !chunk.scripts.empty();
+}
+
+ScriptStreamWriter::ScriptStreamWriter(std::ostream& out, StreamFormat format) : out_(out), format_(format) {
+    if (format_ == StreamFormat::Binary) {
+        std::vector<uint8_t> header(kMagic, kMagic + sizeof(kMagic));
+        put32(header, kVersion);
+        out_.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    }
+}
+
+void ScriptStreamWriter::write(const ScriptChunk& chunk) {
+    if (format_ == StreamFormat::Binary) {
+        std::vector<uint8_t> buffer;
+        buffer.reserve(8 + chunk.scripts.size() * kRecordBytes);
+        size_t cellBytes = 0;
+        for (const auto& s : chunk.scripts) cellBytes += static_cast<size_t>(s.board_count) * SS02BatchEvaluator::CELLS;
+        put32(buffer, static_cast<uint32_t>(chunk.scripts.size()));
+        put32(buffer, static_cast<uint32_t>(cellBytes));
+        for (const auto& s : chunk.scripts) {
+            if (s.board_count > 0xFFFF || s.multiple_table > 0xFF) {
+                throw std::runtime_error("Script " + std::to_string(s.index) + " does not fit the binary record");
+            }
+            buffer.push_back(s.is_free ? 1 : 0);
+            buffer.push_back(static_cast<uint8_t>(s.multiple_table));
+            buffer.push_back(static_cast<uint8_t>(s.board_count & 0xFF));
+            buffer.push_back(static_cast<uint8_t>(s.board_count >> 8));
+            put32(buffer, static_cast<uint32_t>(s.index));
+            put32(buffer, static_cast<uint32_t>(s.stop));
+            put32(buffer, static_cast<uint32_t>(s.payout));
+            put32(buffer, static_cast<uint32_t>(s.payout_id));
+            put32(buffer, static_cast<uint32_t>(s.special_multipliers));
+        }
+        for (const auto& s : chunk.scripts) {
+            const uint8_t* src = chunk.cells.data() + s.offset;
+            buffer.insert(buffer.end(), src, src + static_cast<size_t>(s.board_count) * SS02BatchEvaluator::CELLS);
+        }
+        out_.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    } else {
+        for (const auto& s : chunk.scripts) {
+            PackedScript p = chunk.packed(s);
+            nlohmann::json script = nlohmann::json::array();
+            for (int b = 0; b < p.board_count; ++b) {
+                nlohmann::json rows = nlohmann::json::array();
+                for (int row = 0; row < SS02BatchEvaluator::HEIGHT; ++row) {
+                    nlohmann::json cells = nlohmann::json::array();
+                    for (int col = 0; col < SS02BatchEvaluator::WIDTH; ++col) {
+                        cells.push_back(board(p, b, row * SS02BatchEvaluator::WIDTH + col));
+                    }
+                    rows.push_back(cells);
+                }
+                script.push_back(rows);
+            }
+            nlohmann::json entry = {
+                {"section", s.is_free ? "free" : "base"},
+                {"index", s.index},
+                {"stop", s.stop},
+                {"payout", s.payout},
+                {"payout_id", s.payout_id},
+                {"special_multipliers", s.special_multipliers},
+                {"script", script}
+            };
+            out_ << entry.dump() << "\n";
+        }
+    }
+    if (!out_) {
+        throw std::runtime_error("Failed to write script stream");
+    }
+    scripts_ += chunk.scripts.size();
+}
+
+StreamFormat ScriptStreamWriter::formatFor(const std::string& filename) {
+    auto endsWith = [&](const std::string& suffix) {
+        return filename.size() >= suffix.size() && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    return endsWith(".ndjson") || endsWith(".jsonl") ? StreamFormat::Ndjson : StreamFormat::Binary;
+}
@@ -0,0 +1,136 @@
+// ScriptStream.hpp
+#pragma once
+#include "ScriptConfig.h"
+#include "SS02BatchEval.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Streaming script input for sets larger than memory.
+//
+// Scripts are read in chunks of packed boards (SS02BatchEvaluator layout, 30 bytes per
+// board) so a chunk can be evaluated in place. Two stream formats are supported:
+//
+//   NDJSON  one SS02_scripts.json entry per line, plus "section": "base" | "free"
+//   Binary  "SS02SCRB" + u32 version, then chunks of
+//           u32 script count, u32 cell bytes, count * 24-byte records, cell bytes
+//           record: u8 is_free, u8 multiple_table, u16 board_count,
+//                   i32 index, i32 stop, i32 payout, i32 payout_id, i32 special_multipliers
+//           (all little-endian)
+
+struct StreamScript {
+    bool is_free = false;
+    int index = 0;
+    int stop = 0;
+    int payout = 0;
+    int payout_id = 0;
+    int special_multipliers = 1;
+    int multiple_table = 0;
+    size_t offset = 0;          // Byte offset of the first board in ScriptChunk::cells
+    int board_count = 0;
+};
+
+struct ScriptChunk {
+    std::vector<StreamScript> scripts;
+    std::vector<uint8_t> cells;
+
+    void clear() { scripts.clear(); cells.clear(); }
+    void add(int index, const ScriptApp::ScriptData& data);
+    PackedScript packed(const StreamScript& script) const;
+};
+
+// Fixed-capacity queue between pipeline stages: push blocks while full, pop blocks while
+// empty; after close() pushes fail and pops drain what is left
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] { return items_.size() < capacity_ || closed_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        peak_ = std::max(peak_, items_.size());
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    size_t peak() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_;
+    }
+
+private:
+    const size_t capacity_;
+    std::deque<T> items_;
+    mutable std::mutex mutex_;
+    std::condition_variable notFull_, notEmpty_;
+    size_t peak_ = 0;
+    bool closed_ = false;
+};
+
+enum class StreamFormat { Ndjson, Binary };
+
+class ScriptStreamReader {
+public:
+    // Detects the format from the first bytes of the stream
+    explicit ScriptStreamReader(std::istream& in);
+
+    // Fills `chunk` with up to maxScripts scripts; false once the stream is exhausted
+    bool read(ScriptChunk& chunk, size_t maxScripts);
+
+    StreamFormat format() const { return format_; }
+    uint64_t bytesRead() const { return bytesRead_; }
+
+private:
+    bool readNdjson(ScriptChunk& chunk, size_t maxScripts);
+    bool readBinary(ScriptChunk& chunk, size_t maxScripts);
+
+    std::istream& in_;
+    StreamFormat format_ = StreamFormat::Ndjson;
+    uint64_t bytesRead_ = 0;
+    uint64_t line_ = 0;
+    ScriptChunk pending_;       // Binary chunks larger than the requested size
+    size_t pendingPos_ = 0;
+};
+
+class ScriptStreamWriter {
+public:
+    ScriptStreamWriter(std::ostream& out, StreamFormat format);
+
+    void write(const ScriptChunk& chunk);
+    uint64_t scriptsWritten() const { return scripts_; }
+
+    // Format from a file name: ".ndjson" / ".jsonl" is NDJSON, anything else binary
+    static StreamFormat formatFor(const std::string& filename);
+
+private:
+    std::ostream& out_;
+    StreamFormat format_;
+    uint64_t scripts_ = 0;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// splitmix64 finalizer: derives one independent RNG seed per stream (optimizer restart,
+// generator job, simulation batch) from a run seed, so results do not depend on how the
+// streams are spread over threads.
+inline uint64_t mixSeed(uint64_t seed, uint64_t stream) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
@@ -0,0 +1,351 @@
+#include "SelectionOptimizer.hpp"
+#include "SeedMix.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Penalty weights: any constraint violation outweighs the variance/diversity objective
+constexpr double kWindowPenalty = 1.0e4;   // Per relative deviation of the total payout
+constexpr double kBinPenalty = 1.0e7;      // Per missing distinct payout in a bin (outranks the window)
+
+}  // namespace
+
+SelectionProblem SelectionProblem::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open selection config file: " + filename);
+    }
+    nlohmann::json j;
+    file >> j;
+
+    SelectionProblem problem;
+    problem.name = j.value("problem_name", "");
+    problem.section = problem.name.find("FG") != std::string::npos ? "free" : "base";
+    problem.numToSelect = j.at("num_to_select").get<int>();
+
+    const auto& average = j.at("average_range");
+    const double n = problem.numToSelect;
+    problem.sumMin = static_cast<long long>(std::ceil(average.at("min").get<double>() * n - 1e-6));
+    problem.sumMax = static_cast<long long>(std::floor(average.at("max").get<double>() * n + 1e-6));
+
+    const auto& constraints = j.at("constraints");
+    problem.zeroMin = constraints.at("zero_constraints").value("min", 0);
+    problem.zeroMax = constraints.at("zero_constraints").value("max", problem.numToSelect);
+    problem.minCount = constraints.at("count_constraints").value("global_min_count", 0);
+    problem.maxCount = constraints.at("count_constraints").at("global_max_count").get<int>();
+    if (constraints.contains("diversity_constraints")) {
+        const auto& diversity = constraints.at("diversity_constraints");
+        problem.dividers = diversity.at("bin_definition").at("dividers").get<std::vector<int>>();
+        std::sort(problem.dividers.begin(), problem.dividers.end());
+        problem.binRules_ = diversity.value("per_bin_rules", nlohmann::json::array());
+    }
+
+    problem.setValues(j.value("input_values", std::vector<int>{}), 0);
+    return problem;
+}
+
+void SelectionProblem::setValues(std::vector<int> candidates, int maxPayout) {
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [&](int v) { return v <= 0 || (maxPayout > 0 && v > maxPayout); }),
+                     candidates.end());
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    values = std::move(candidates);
+
+    // A bin takes the rule with the smallest value_less_than above its upper bound,
+    // otherwise the default; never more than the distinct payouts it holds
+    int defaultMin = 0;
+    for (const auto& rule : binRules_) {
+        if (rule.contains("default_min_selections")) defaultMin = rule.at("default_min_selections").get<int>();
+    }
+    std::vector<int> available(dividers.size() + 1, 0);
+    for (int v : values) available[binOf(v)]++;
+    binMin.assign(dividers.size() + 1, 0);
+    for (size_t bin = 0; bin < binMin.size(); ++bin) {
+        long long upper = bin < dividers.size() ? dividers[bin] : LLONG_MAX;
+        int required = defaultMin;
+        long long threshold = LLONG_MAX;
+        for (const auto& rule : binRules_) {
+            if (!rule.contains("value_less_than")) continue;
+            long long limit = rule.at("value_less_than").get<long long>();
+            if (upper < limit && limit < threshold) {
+                threshold = limit;
+                required = rule.value("min_selections", defaultMin);
+            }
+        }
+        binMin[bin] = std::min(required, available[bin]);
+    }
+}
+
+int SelectionProblem::applyGameConfig(const nlohmann::json& gameConfig) {
+    const auto rtp = gameConfig.at("game_RTP").get<std::vector<double>>();
+    if (rtp.size() != 2) {
+        throw std::runtime_error("game_RTP must be a [min, max] window");
+    }
+    const double bet = gameConfig.value("base_bet", 20.0);
+    const double bgPercent = gameConfig.value("BG_percent", 1.0);
+
+    // Average payout per script needed for one unit of RTP
+    double perRtp;
+    if (section == "free") {
+        const double trigger = gameConfig.at("FG_trigger").get<double>();
+        const double rounds = gameConfig.value("FG_rounds", 10.0);
+        const double retrigger = gameConfig.value("FG_retrigger", 0.0);
+        if (rounds * retrigger >= 1.0) {
+            throw std::runtime_error("FG_rounds * FG_retrigger >= 1: free game sessions never end");
+        }
+        // Each spin retriggers another FG_rounds spins with probability FG_retrigger
+        const double expectedLength = rounds / (1.0 - rounds * retrigger);
+        perRtp = (1.0 - bgPercent) * bet / (trigger * expectedLength);
+    } else {
+        perRtp = bgPercent * bet / gameConfig.value("BG_score_factor", 1.0);
+    }
+
+    const double n = numToSelect;
+    sumMin = static_cast<long long>(std::ceil(rtp[0] * perRtp * n - 1e-6));
+    sumMax = static_cast<long long>(std::floor(rtp[1] * perRtp * n + 1e-6));
+    return gameConfig.value(section == "free" ? "FG_max" : "BG_max", 0);
+}
+
+int SelectionProblem::binOf(int value) const {
+    return static_cast<int>(std::lower_bound(dividers.begin(), dividers.end(), value) - dividers.begin());
+}
+
+double SelectionResult::variance(int n) const {
+    if (n <= 0) return 0.0;
+    double m = mean(n);
+    return std::max(0.0, static_cast<double>(sumSquares) / n - m * m);
+}
+
+struct SelectionOptimizer::State {
+    std::vector<int> counts;
+    std::vector<int> bins;          // Bin of each candidate payout
+    std::vector<int> binDistinct;
+    std::vector<int> active;        // Candidates with a non-zero count
+    std::vector<int> activePos;     // Index into active, -1 when inactive
+    int zeros = 0;
+    long long sum = 0;
+    long long sumSquares = 0;
+    int distinct = 0;
+    int deficit = 0;
+
+    void add(int i, int value, const std::vector<int>& binMin) {
+        if (counts[i]++ == 0) {
+            distinct++;
+            if (binDistinct[bins[i]]++ < binMin[bins[i]]) deficit--;
+            activePos[i] = static_cast<int>(active.size());
+            active.push_back(i);
+        }
+        sum += value;
+        sumSquares += static_cast<long long>(value) * value;
+    }
+
+    void remove(int i, int value, const std::vector<int>& binMin) {
+        if (--counts[i] == 0) {
+            distinct--;
+            if (--binDistinct[bins[i]] < binMin[bins[i]]) deficit++;
+            int last = active.back();
+            active[activePos[i]] = last;
+            activePos[last] = activePos[i];
+            active.pop_back();
+            activePos[i] = -1;
+        }
+        sum -= value;
+        sumSquares -= static_cast<long long>(value) * value;
+    }
+};
+
+double SelectionOptimizer::score(long long sum, long long sumSquares, int distinct, int binDeficit) const {
+    const double n = problem_.numToSelect;
+    const double target = 0.5 * static_cast<double>(problem_.sumMin + problem_.sumMax);
+    long long outside = std::max({0LL, problem_.sumMin - sum, sum - problem_.sumMax});
+
+    double mean = sum / n;
+    double variance = std::max(0.0, sumSquares / n - mean * mean);
+    double cv2 = mean > 0.0 ? variance / (mean * mean) : 1.0e6;
+    int maxDistinct = std::max(1, std::min(static_cast<int>(problem_.values.size()), problem_.numToSelect - problem_.zeroMin));
+
+    return kWindowPenalty * outside / std::max(1.0, target) + kBinPenalty * binDeficit +
+           cv2 - diversityWeight_ * distinct / maxDistinct;
+}
+
+void SelectionOptimizer::initialize(State& state) const {
+    const auto& values = problem_.values;
+    const auto& binMin = problem_.binMin;
+    const int n = static_cast<int>(values.size());
+
+    state.counts.assign(n, 0);
+    state.bins.resize(n);
+    for (int i = 0; i < n; ++i) state.bins[i] = problem_.binOf(values[i]);
+    state.binDistinct.assign(binMin.size(), 0);
+    state.activePos.assign(n, -1);
+    state.deficit = 0;
+    for (int m : binMin) state.deficit += m;
+
+    state.zeros = (problem_.zeroMin + problem_.zeroMax) / 2;
+    for (int i = 0; i < n; ++i) {
+        for (int c = 0; c < problem_.minCount; ++c) state.add(i, values[i], binMin);
+    }
+    int slots = problem_.numToSelect - state.zeros - n * problem_.minCount;
+
+    // Bin minimums first, using the payouts closest to the average non-zero payout
+    const double target = 0.5 * static_cast<double>(problem_.sumMin + problem_.sumMax);
+    const double nonzeroMean = target / std::max(1, slots);
+    for (size_t bin = 0; bin < binMin.size() && slots > 0; ++bin) {
+        std::vector<int> members;
+        for (int i = 0; i < n; ++i) {
+            if (state.bins[i] == static_cast<int>(bin) && state.counts[i] == 0) members.push_back(i);
+        }
+        std::sort(members.begin(), members.end(), [&](int a, int b) {
+            return std::abs(values[a] - nonzeroMean) < std::abs(values[b] - nonzeroMean);
+        });
+        for (int k = 0; k < static_cast<int>(members.size()) && state.binDistinct[bin] < binMin[bin] && slots > 0; ++k) {
+            state.add(members[k], values[members[k]], binMin);
+            slots--;
+        }
+    }
+
+    // Then greedily aim each remaining slot at the payout still needed per slot
+    while (slots > 0) {
+        double want = (target - state.sum) / slots;
+        int pos = static_cast<int>(std::lower_bound(values.begin(), values.end(), static_cast<int>(std::lround(want))) -
+                                   values.begin());
+        int best = -1;
+        for (int offset = 0; best < 0 && offset <= n; ++offset) {
+            for (int i : {pos - offset, pos + offset - 1}) {
+                if (i >= 0 && i < n && state.counts[i] < problem_.maxCount) {
+                    best = i;
+                    break;
+                }
+            }
+        }
+        if (best < 0) {
+            // Every payout is at its maximum count; the remaining slots go to zero payouts
+            state.zeros += slots;
+            break;
+        }
+        state.add(best, values[best], binMin);
+        slots--;
+    }
+}
+
+SelectionResult SelectionOptimizer::search(uint64_t seed, int iterations) const {
+    const auto& values = problem_.values;
+    const auto& binMin = problem_.binMin;
+    const int n = static_cast<int>(values.size());
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    State state;
+    initialize(state);
+
+    auto snapshot = [&](double s) {
+        SelectionResult r;
+        r.counts = state.counts;
+        r.zeroCount = state.zeros;
+        r.sum = state.sum;
+        r.sumSquares = state.sumSquares;
+        r.distinct = state.distinct;
+        r.binDeficit = state.deficit;
+        r.feasible = state.deficit == 0 && state.sum >= problem_.sumMin && state.sum <= problem_.sumMax &&
+                     state.zeros >= problem_.zeroMin && state.zeros <= problem_.zeroMax;
+        r.score = s;
+        return r;
+    };
+    auto better = [](const SelectionResult& a, const SelectionResult& b) {
+        if (a.feasible != b.feasible) return a.feasible;
+        return a.score < b.score;
+    };
+
+    double current = score(state.sum, state.sumSquares, state.distinct, state.deficit);
+    SelectionResult best = snapshot(current);
+    if (n == 0) return best;
+
+    // Geometric cooling
+    const double t0 = 1.0, t1 = 1.0e-5;
+    const double cooling = std::pow(t1 / t0, 1.0 / std::max(1, iterations));
+    double temperature = t0;
+
+    for (int it = 0; it < iterations; ++it, temperature *= cooling) {
+        // Source: a zero-payout script or a selected payout above its minimum count
+        int from = -1;
+        bool fromZero = std::uniform_int_distribution<int>(0, problem_.numToSelect - 1)(rng) < state.zeros;
+        if (fromZero) {
+            if (state.zeros <= problem_.zeroMin) continue;
+        } else {
+            if (state.active.empty()) continue;
+            from = state.active[std::uniform_int_distribution<size_t>(0, state.active.size() - 1)(rng)];
+            if (state.counts[from] <= problem_.minCount) continue;
+        }
+
+        // Destination: zero, a random payout, or a payout near the source
+        int to = -1;
+        double r = unit(rng);
+        if (r < 0.1) {
+            if (fromZero || state.zeros >= problem_.zeroMax) continue;
+        } else if (r < 0.55) {
+            to = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        } else {
+            int origin = from >= 0 ? from : std::uniform_int_distribution<int>(0, n - 1)(rng);
+            int offset = std::uniform_int_distribution<int>(1, 8)(rng);
+            to = std::clamp(origin + (unit(rng) < 0.5 ? -offset : offset), 0, n - 1);
+        }
+        if (to >= 0 && (to == from || state.counts[to] >= problem_.maxCount)) continue;
+
+        if (fromZero) state.zeros--; else state.remove(from, values[from], binMin);
+        if (to < 0) state.zeros++; else state.add(to, values[to], binMin);
+
+        double candidate = score(state.sum, state.sumSquares, state.distinct, state.deficit);
+        double delta = candidate - current;
+        if (delta <= 0.0 || unit(rng) < std::exp(-delta / temperature)) {
+            current = candidate;
+            if (candidate < best.score || (!best.feasible && state.deficit == 0 &&
+                                           state.sum >= problem_.sumMin && state.sum <= problem_.sumMax)) {
+                SelectionResult snap = snapshot(current);
+                if (better(snap, best)) best = std::move(snap);
+            }
+        } else {
+            if (to < 0) state.zeros--; else state.remove(to, values[to], binMin);
+            if (fromZero) state.zeros++; else state.add(from, values[from], binMin);
+        }
+    }
+    return best;
+}
+
+SelectionResult SelectionOptimizer::optimize(int threads, uint64_t seed, int restarts, int iterations) const {
+    const int n = static_cast<int>(problem_.values.size());
+    if (problem_.numToSelect < problem_.zeroMin + static_cast<long long>(n) * problem_.minCount) {
+        throw std::runtime_error("num_to_select is below the zero and per-payout minimum counts");
+    }
+    if (problem_.numToSelect > problem_.zeroMax + static_cast<long long>(n) * problem_.maxCount) {
+        throw std::runtime_error("num_to_select exceeds what the candidate payouts and zeros can fill");
+    }
+
+    restarts = std::max(1, restarts);
+    std::vector<SelectionResult> results(restarts);
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int run = next++; run < restarts; run = next++) {
+            results[run] = search(mixSeed(seed, run), iterations);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < std::max(1, std::min(threads, restarts)); ++t) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+
+    // Best by feasibility, then score; ties keep the lowest run index
+    size_t best = 0;
+    for (size_t run = 1; run < results.size(); ++run) {
+        const auto& a = results[run];
+        const auto& b = results[best];
+        if ((a.feasible && !b.feasible) || (a.feasible == b.feasible && a.score < b.score)) best = run;
+    }
+    return results[best];
+}
@@ -0,0 +1,79 @@
+// SelectionOptimizer.hpp
+#pragma once
+#include "json.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// DeepDive selection problem (Backup/DeepDive_{BG,FG}_Selection.json).
+//
+// Pick numToSelect scripts from the candidate payouts (each payout at most maxCount times,
+// plus [zeroMin, zeroMax] zero-payout scripts) so that the total payout lies in
+// [sumMin, sumMax], every diversity bin gets its minimum number of distinct payouts, and
+// the selection has low variance and many distinct payouts.
+struct SelectionProblem {
+    std::string name;
+    std::string section;                 // "base" or "free"
+    std::vector<int> values;             // Candidate non-zero payouts, ascending and unique
+    int numToSelect = 0;
+    int zeroMin = 0;
+    int zeroMax = 0;
+    int minCount = 0;                    // Per candidate payout
+    int maxCount = 0;
+    long long sumMin = 0;                // Window on the total payout of the selection
+    long long sumMax = 0;
+    std::vector<int> dividers;           // Bin k holds values in (dividers[k-1], dividers[k]]
+    std::vector<int> binMin;             // Minimum distinct payouts per bin (capped at what exists)
+
+    static SelectionProblem loadFromFile(const std::string& filename);
+
+    // Replace the candidate payouts and recompute the bin minimums
+    void setValues(std::vector<int> candidates, int maxPayout);
+
+    // Derive the average-payout window from GameConfig.json: the RTP window times the
+    // BG/FG split, per base spin for the base game and per free spin for the free game.
+    // Returns the max-win cap (BG_max / FG_max) for the section.
+    int applyGameConfig(const nlohmann::json& gameConfig);
+
+    int binOf(int value) const;
+
+private:
+    nlohmann::json binRules_;
+};
+
+struct SelectionResult {
+    std::vector<int> counts;             // Parallel to SelectionProblem::values
+    int zeroCount = 0;
+    long long sum = 0;
+    long long sumSquares = 0;
+    int distinct = 0;
+    int binDeficit = 0;
+    bool feasible = false;
+    double score = 0.0;
+
+    double mean(int n) const { return n > 0 ? static_cast<double>(sum) / n : 0.0; }
+    double variance(int n) const;
+};
+
+// Simulated-annealing local search over selection counts. Moves shift one script from a
+// payout (or zero) to another, so the selection size and count bounds always hold; the
+// payout window and bin minimums are penalized until met.
+class SelectionOptimizer {
+public:
+    explicit SelectionOptimizer(const SelectionProblem& problem, double diversityWeight = 1.0)
+        : problem_(problem), diversityWeight_(diversityWeight) {}
+
+    // Run `restarts` independent searches of `iterations` moves on `threads` workers and
+    // return the best; the result only depends on the seed, not on the thread count.
+    SelectionResult optimize(int threads, uint64_t seed, int restarts, int iterations) const;
+
+private:
+    struct State;
+
+    SelectionResult search(uint64_t seed, int iterations) const;
+    void initialize(State& state) const;
+    double score(long long sum, long long sumSquares, int distinct, int binDeficit) const;
+
+    const SelectionProblem& problem_;
+    double diversityWeight_;
+};
@@ -0,0 +1,167 @@
+#include "SlotPayC.h"
+#include "SS02Pay.hpp"
+#include "SS03Pay.hpp"
+#include "SS02BatchEval.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct slotpay_engine {
+    std::string game;
+    std::unique_ptr<SlotSS02> ss02;
+    std::unique_ptr<SS02BatchEvaluator> ss02Batch;
+    std::unique_ptr<SlotSS03> ss03;
+    int height = 0;
+    int width = 0;
+};
+
+namespace {
+
+thread_local std::string g_lastError;
+
+int fail(const std::string& message) {
+    g_lastError = message;
+    return -1;
+}
+
+int decodeCell(uint8_t v) {
+    return v >= 0xF0 ? static_cast<int>(v) - 256 : static_cast<int>(v);
+}
+
+// SS02: the packed layout is the batch evaluator's own, so boards are evaluated in place
+void evaluateSS02(slotpay_engine& engine, const uint8_t* boards, const int32_t* boardCounts,
+                  const int32_t* specials, size_t count, double* scores, int32_t* stops,
+                  uint8_t* cascade, uint32_t* masks, int32_t maskStride) {
+    std::vector<PackedScript> packed(count);
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        packed[i].boards = boards + offset;
+        packed[i].board_count = boardCounts[i];
+        packed[i].special_multipliers = specials ? specials[i] : 1;
+        offset += static_cast<size_t>(boardCounts[i]) * SS02BatchEvaluator::CELLS;
+    }
+    std::vector<BatchScriptResult> results(count);
+    engine.ss02Batch->evaluate(packed.data(), count, results.data(), masks, masks ? maskStride : 0);
+    for (size_t i = 0; i < count; ++i) {
+        scores[i] = results[i].score;
+        stops[i] = results[i].stop;
+        cascade[i] = results[i].cascade_match ? 1 : 0;
+    }
+}
+
+void evaluateSS03(slotpay_engine& engine, const uint8_t* boards, const int32_t* boardCounts,
+                  size_t count, double* scores, int32_t* stops, uint8_t* cascade,
+                  uint32_t* masks, int32_t maskStride) {
+    const int h = engine.height, w = engine.width;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<Board> script(boardCounts[i], Board(h, std::vector<int>(w)));
+        for (auto& board : script) {
+            for (int row = 0; row < h; ++row) {
+                for (int col = 0; col < w; ++col) board[row][col] = decodeCell(boards[offset++]);
+            }
+        }
+        auto [final_board, total_score, actual_stop, patterns, boards_match] = engine.ss03->steps(script);
+        scores[i] = total_score;
+        stops[i] = actual_stop;
+        cascade[i] = boards_match ? 1 : 0;
+        if (masks) {
+            uint32_t* out = masks + i * static_cast<size_t>(maskStride);
+            for (int step = 0; step < maskStride; ++step) {
+                uint32_t mask = 0;
+                if (step < static_cast<int>(patterns.size())) {
+                    for (const auto& [symbol, positions] : patterns[step]) {
+                        for (const auto& [row, col] : positions) mask |= 1u << (row * w + col);
+                    }
+                }
+                out[step] = mask;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+int slotpay_abi_version(void) {
+    return SLOTPAY_ABI_VERSION;
+}
+
+slotpay_engine* slotpay_create(const char* game, const char* game_type) {
+    try {
+        if (!game || !game_type) {
+            fail("game and game_type are required");
+            return nullptr;
+        }
+        std::string type = game_type;
+        if (type != "base" && type != "free") {
+            fail("game_type must be \"base\" or \"free\", got \"" + type + "\"");
+            return nullptr;
+        }
+        auto engine = std::make_unique<slotpay_engine>();
+        engine->game = game;
+        if (engine->game == "SS02") {
+            engine->ss02 = std::make_unique<SlotSS02>(true, 20.0f, type);
+            engine->ss02Batch = std::make_unique<SS02BatchEvaluator>(*engine->ss02);
+            engine->height = engine->ss02->get_board_height();
+            engine->width = engine->ss02->get_board_width();
+        } else if (engine->game == "SS03") {
+            engine->ss03 = std::make_unique<SlotSS03>(true, 20.0f, type);
+            engine->height = engine->ss03->get_board_height();
+            engine->width = engine->ss03->get_board_width();
+        } else {
+            fail("Unknown game \"" + engine->game + "\" (expected SS02 or SS03)");
+            return nullptr;
+        }
+        return engine.release();
+    } catch (const std::exception& e) {
+        fail(e.what());
+        return nullptr;
+    }
+}
+
+void slotpay_destroy(slotpay_engine* engine) {
+    delete engine;
+}
+
+int slotpay_board_shape(const slotpay_engine* engine, int* height, int* width) {
+    if (!engine || !height || !width) return fail("engine, height and width are required");
+    *height = engine->height;
+    *width = engine->width;
+    return 0;
+}
+
+int slotpay_evaluate(slotpay_engine* engine, const uint8_t* boards, const int32_t* board_counts,
+                     const int32_t* special_multipliers, size_t script_count, double* scores,
+                     int32_t* stops, uint8_t* cascade_match, uint32_t* match_masks, int32_t mask_stride) {
+    if (!engine) return fail("engine is required");
+    if (script_count == 0) return 0;
+    if (!boards || !board_counts || !scores || !stops || !cascade_match) {
+        return fail("boards, board_counts, scores, stops and cascade_match are required");
+    }
+    if (match_masks && mask_stride <= 0) return fail("mask_stride must be positive when match_masks is given");
+    if (engine->height * engine->width > 32) return fail("match masks need at most 32 cells per board");
+    for (size_t i = 0; i < script_count; ++i) {
+        if (board_counts[i] <= 0) return fail("script " + std::to_string(i) + " has no boards");
+    }
+    try {
+        if (engine->ss02) {
+            evaluateSS02(*engine, boards, board_counts, special_multipliers, script_count, scores, stops,
+                         cascade_match, match_masks, mask_stride);
+        } else {
+            evaluateSS03(*engine, boards, board_counts, script_count, scores, stops, cascade_match,
+                         match_masks, mask_stride);
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        return fail(e.what());
+    }
+}
+
+const char* slotpay_last_error(void) {
+    return g_lastError.c_str();
+}
+
+}  // extern "C"
@@ -0,0 +1,72 @@
+/* SlotPayC.h - C ABI of the cascade engines (libslotpay.so) */
+#ifndef SLOTPAY_C_H
+#define SLOTPAY_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define SLOTPAY_API __declspec(dllexport)
+#else
+#define SLOTPAY_API __attribute__((visibility("default")))
+#endif
+
+/* Bumped whenever a signature or the buffer layout below changes */
+#define SLOTPAY_ABI_VERSION 1
+
+/*
+ * Buffer layout
+ *
+ * boards          All boards of all scripts, back to back: script 0 board 0, script 0
+ *                 board 1, ..., script 1 board 0, ... Each board is height * width bytes,
+ *                 row-major. A cell holds the symbol value as an unsigned byte; values
+ *                 >= 0xF0 are negative (0xFF = -1 empty cell, 0xFE = -2 SS03 padding).
+ *                 SS02 MULTIPLIER (202) and SS03 WILD/SCATTER/golden tiles fit as is.
+ * board_counts    Boards per script (script_count entries)
+ * special_multipliers  Per script, SS02 free games only; NULL means 1 for every script
+ *
+ * Outputs (caller-allocated, script_count entries each)
+ * scores          Total score of the script (multiplied for SS02 free games)
+ * stops           Boards consumed, as SlotSS02::steps / SlotSS03::steps report it
+ * cascade_match   1 if every post-gravity survivor agrees with the next board
+ * match_masks     Optional (NULL to skip): script_count * mask_stride entries;
+ *                 match_masks[i * mask_stride + step] is the bitmask (bit row * width + col)
+ *                 of cells matched at cascade step `step`, 0 after the last step
+ *
+ * All functions return 0 on success and -1 on error; slotpay_last_error() describes the
+ * last error of the calling thread. An engine must not be used by two threads at once;
+ * create one engine per thread instead.
+ */
+
+typedef struct slotpay_engine slotpay_engine;
+
+SLOTPAY_API int slotpay_abi_version(void);
+
+/* game: "SS02" or "SS03"; game_type: "base" or "free". NULL on error. */
+SLOTPAY_API slotpay_engine* slotpay_create(const char* game, const char* game_type);
+SLOTPAY_API void slotpay_destroy(slotpay_engine* engine);
+
+SLOTPAY_API int slotpay_board_shape(const slotpay_engine* engine, int* height, int* width);
+
+SLOTPAY_API int slotpay_evaluate(slotpay_engine* engine,
+                                 const uint8_t* boards,
+                                 const int32_t* board_counts,
+                                 const int32_t* special_multipliers,
+                                 size_t script_count,
+                                 double* scores,
+                                 int32_t* stops,
+                                 uint8_t* cascade_match,
+                                 uint32_t* match_masks,
+                                 int32_t mask_stride);
+
+SLOTPAY_API const char* slotpay_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLOTPAY_C_H */
@@ -3,9 +3,17 @@
 # Build and Update Script
 # This script compiles SS02_test, runs SS02_convertpay, and updates Insert_Script.json
 # Integrated with build.sh functionality
+#
+# With --watch, runs the pipeline once and then keeps SS02_convertpay watching
+# SS02_scripts.json and FG_hist/Insert_Script.json, updating only changed scripts.
 
 set -e  # Exit on error
 
+WATCH=0
+if [ "$1" == "--watch" ]; then
+    WATCH=1
+fi
+
 echo "=========================================="
 echo "Starting Build and Update Process"
 echo "=========================================="
@@ -26,8 +34,8 @@ if [ -f "SS02_test" ]; then
     rm SS02_test
 fi
 
-echo "Running: g++ -std=c++17 -Wall -Wextra -o SS02_test SlotPay.cpp SS02Pay.cpp SS02_test.cpp"
-g++ -std=c++17 -Wall -Wextra -o SS02_test SlotPay.cpp SS02Pay.cpp SS02_test.cpp
+echo "Running: g++ -std=c++17 -Wall -Wextra -o SS02_test SlotPay.cpp SS02Pay.cpp SS02BatchEval.cpp SS02Analytic.cpp SS02_test.cpp"
+g++ -std=c++17 -Wall -Wextra -o SS02_test SlotPay.cpp SS02Pay.cpp SS02BatchEval.cpp SS02Analytic.cpp SS02_test.cpp
 
 if [ $? -eq 0 ] && [ -f "SS02_test" ]; then
     echo "✅ SS02_test compiled successfully"
@@ -39,7 +47,7 @@ if [ $? -eq 0 ] && [ -f "SS02_test" ]; then
 else
     echo "❌ SS02_test compilation failed"
     echo "Trying with verbose output to see errors:"
-    g++ -std=c++17 -Wall -Wextra -v -o SS02_test SlotPay.cpp SS02Pay.cpp SS02_test.cpp
+    g++ -std=c++17 -Wall -Wextra -v -o SS02_test SlotPay.cpp SS02Pay.cpp SS02BatchEval.cpp SS02Analytic.cpp SS02_test.cpp
     exit 1
 fi
 echo ""
@@ -54,8 +62,8 @@ if [ -f "SS02_convertpay" ]; then
     rm SS02_convertpay
 fi
 
-echo "Running: g++ -std=c++17 -Wall -Wextra -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_Convertpay.cpp"
-g++ -std=c++17 -Wall -Wextra -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_Convertpay.cpp
+echo "Running: g++ -std=c++17 -Wall -Wextra -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_convertpay.cpp"
+g++ -std=c++17 -Wall -Wextra -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_convertpay.cpp
 
 if [ $? -eq 0 ] && [ -f "SS02_convertpay" ]; then
     echo "✅ SS02_convertpay compiled successfully"
@@ -67,7 +75,7 @@ if [ $? -eq 0 ] && [ -f "SS02_convertpay" ]; then
 else
     echo "❌ SS02_convertpay compilation failed"
     echo "Trying with verbose output to see errors:"
-    g++ -std=c++17 -Wall -Wextra -v -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_Convertpay.cpp
+    g++ -std=c++17 -Wall -Wextra -v -o SS02_convertpay SlotPay.cpp SS02Pay.cpp SS02_convertpay.cpp
     exit 1
 fi
 echo ""
@@ -83,6 +91,13 @@ fi
 
 python3 replace_base_free.py
 
+if [ $WATCH -eq 1 ]; then
+    echo ""
+    echo "Step 4: Watching for script changes (intermediate files are kept)..."
+    echo "------------------------------------------"
+    exec ./SS02_convertpay --watch
+fi
+
 # Step 4: Clean up temporary files
 echo "Step 4: Cleaning up temporary files..."
 echo "------------------------------------------"
@@ -115,7 +130,7 @@ echo ""
 echo "Generated files:"
 echo "  - SS02_test (executable)"
 echo "  - SS02_convertpay (executable)"
-echo "  - script_results.json (from SS02_test)"
+echo "  - script_results.ss02r (from SS02_test, query with SS02_query)"
 echo "  - FG_hist/Insert_Script.json (updated with base, free, multiplier_table, and config)"
 echo ""
 echo "Temporary files cleaned up:"
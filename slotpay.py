@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""
+ctypes wrapper for libslotpay.so (SlotPayC.h): batch evaluation of SS02/SS03 scripts
+without round-tripping through JSON files.
+
+Boards are passed as one contiguous uint8 buffer (see SlotPayC.h for the cell encoding).
+NumPy arrays are passed zero-copy; without NumPy any writable buffer (bytearray,
+array.array, memoryview) is passed zero-copy too, read-only buffers are copied once.
+
+    import numpy as np, slotpay
+    engine = slotpay.Engine("SS02", "free")
+    boards = slotpay.pack_scripts([script["script"] for script in scripts])
+    result = engine.evaluate(boards, counts, special_multipliers, mask_stride=16)
+    result["scores"], result["stops"], result["cascade_match"], result["match_masks"]
+
+Run as a script to evaluate a JSON script file and compare against its payouts:
+
+    python3 slotpay.py SS02_scripts.json [SS02|SS03]
+
+The game defaults to the file's "game_type" field, else to its board shape (5x6 = SS02,
+5x5 = SS03).
+"""
+
+import array
+import ctypes
+import json
+import os
+import sys
+
+try:
+    import numpy as np
+except ImportError:  # NumPy is optional
+    np = None
+
+ABI_VERSION = 1
+
+_lib = None
+
+
+def load_library(path=None):
+    """Load libslotpay.so (default: next to this file, then the loader search path)."""
+    global _lib
+    if _lib is not None:
+        return _lib
+    candidates = [path] if path else [os.path.join(os.path.dirname(os.path.abspath(__file__)), "libslotpay.so"),
+                                      "libslotpay.so"]
+    last_error = None
+    for candidate in candidates:
+        try:
+            lib = ctypes.CDLL(candidate)
+            break
+        except OSError as e:
+            last_error = e
+    else:
+        raise OSError(f"Cannot load libslotpay.so: {last_error}")
+
+    lib.slotpay_abi_version.restype = ctypes.c_int
+    lib.slotpay_create.argtypes = [ctypes.c_char_p, ctypes.c_char_p]
+    lib.slotpay_create.restype = ctypes.c_void_p
+    lib.slotpay_destroy.argtypes = [ctypes.c_void_p]
+    lib.slotpay_destroy.restype = None
+    lib.slotpay_board_shape.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int)]
+    lib.slotpay_board_shape.restype = ctypes.c_int
+    lib.slotpay_evaluate.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+                                     ctypes.c_size_t, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p,
+                                     ctypes.c_void_p, ctypes.c_int32]
+    lib.slotpay_evaluate.restype = ctypes.c_int
+    lib.slotpay_last_error.restype = ctypes.c_char_p
+
+    version = lib.slotpay_abi_version()
+    if version != ABI_VERSION:
+        raise OSError(f"libslotpay.so ABI version {version}, this wrapper needs {ABI_VERSION}")
+    _lib = lib
+    return lib
+
+
+def _check(status):
+    if status != 0:
+        raise RuntimeError(_lib.slotpay_last_error().decode())
+
+
+def _pointer(buffer, ctype, count, keep):
+    """Address of `count` elements of `ctype` in `buffer`, zero-copy where possible."""
+    if buffer is None:
+        return None
+    if np is not None and isinstance(buffer, np.ndarray):
+        expected = np.dtype(ctype)
+        if buffer.dtype != expected or not buffer.flags["C_CONTIGUOUS"]:
+            raise TypeError(f"expected a C-contiguous {expected} array, got {buffer.dtype}")
+        if buffer.size < count:
+            raise ValueError(f"buffer holds {buffer.size} elements, {count} needed")
+        return buffer.ctypes.data
+    view = memoryview(buffer).cast("B")
+    if view.nbytes < count * ctypes.sizeof(ctype):
+        raise ValueError(f"buffer holds {view.nbytes} bytes, {count * ctypes.sizeof(ctype)} needed")
+    if view.readonly:
+        copy = (ctypes.c_uint8 * view.nbytes).from_buffer_copy(view)
+        keep.append(copy)
+        return ctypes.addressof(copy)
+    c_buffer = (ctypes.c_uint8 * view.nbytes).from_buffer(view)
+    keep.append(c_buffer)
+    return ctypes.addressof(c_buffer)
+
+
+def _allocate(typecode, dtype, count):
+    if np is not None:
+        return np.zeros(count, dtype=dtype)
+    return array.array(typecode, bytes(count * array.array(typecode).itemsize))
+
+
+def pack_scripts(scripts):
+    """Pack scripts (lists of boards, boards as row lists) into (boards, board_counts)."""
+    cells = bytearray()
+    counts = array.array("i")
+    for script in scripts:
+        counts.append(len(script))
+        for board in script:
+            for row in board:
+                cells.extend(v & 0xFF for v in row)
+    if np is not None:
+        return np.frombuffer(cells, dtype=np.uint8).copy(), np.frombuffer(counts, dtype=np.int32).copy()
+    return cells, counts
+
+
+class Engine:
+    """One SS02 or SS03 engine ("base" or "free"); not to be shared between threads."""
+
+    def __init__(self, game="SS02", game_type="base", library=None):
+        self._lib = load_library(library)
+        self._handle = self._lib.slotpay_create(game.encode(), game_type.encode())
+        if not self._handle:
+            raise RuntimeError(self._lib.slotpay_last_error().decode())
+        height, width = ctypes.c_int(), ctypes.c_int()
+        _check(self._lib.slotpay_board_shape(self._handle, ctypes.byref(height), ctypes.byref(width)))
+        self.shape = (height.value, width.value)
+
+    def close(self):
+        if self._handle:
+            self._lib.slotpay_destroy(self._handle)
+            self._handle = None
+
+    def __del__(self):
+        self.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def evaluate(self, boards, board_counts, special_multipliers=None, mask_stride=0, out=None):
+        """Evaluate scripts; returns scores (float64), stops (int32), cascade_match (uint8)
+        and, with mask_stride > 0, match_masks (uint32, script_count * mask_stride).
+        Pass `out` (a dict of preallocated arrays with those keys) to reuse buffers."""
+        count = len(board_counts)
+        keep = []
+        result = out if out is not None else {
+            "scores": _allocate("d", "float64", count),
+            "stops": _allocate("i", "int32", count),
+            "cascade_match": _allocate("B", "uint8", count),
+        }
+        if mask_stride > 0 and "match_masks" not in result:
+            result["match_masks"] = _allocate("I", "uint32", count * mask_stride)
+
+        total_boards = sum(int(c) for c in board_counts)
+        cells = total_boards * self.shape[0] * self.shape[1]
+        _check(self._lib.slotpay_evaluate(
+            self._handle,
+            _pointer(boards, ctypes.c_uint8, cells, keep),
+            _pointer(board_counts, ctypes.c_int32, count, keep),
+            _pointer(special_multipliers, ctypes.c_int32, count, keep),
+            count,
+            _pointer(result["scores"], ctypes.c_double, count, keep),
+            _pointer(result["stops"], ctypes.c_int32, count, keep),
+            _pointer(result["cascade_match"], ctypes.c_uint8, count, keep),
+            _pointer(result.get("match_masks") if mask_stride > 0 else None, ctypes.c_uint32,
+                     count * mask_stride, keep),
+            mask_stride))
+        return result
+
+
+BOARD_SHAPES = {(5, 6): "SS02", (5, 5): "SS03"}
+
+
+def detect_game(data):
+    """Game of a script file: its "game_type" field, else the shape of its first board."""
+    game = data.get("game_type")
+    if game in BOARD_SHAPES.values():
+        return game
+    for section in ("base", "free"):
+        for entry in data.get(section, []):
+            board = entry["script"][0]
+            shape = (len(board), len(board[0]) if board else 0)
+            if shape not in BOARD_SHAPES:
+                raise ValueError(f"Cannot tell the game from a {shape[0]}x{shape[1]} board; "
+                                 "pass SS02 or SS03 as the second argument")
+            return BOARD_SHAPES[shape]
+    raise ValueError("No scripts to tell the game from; pass SS02 or SS03 as the second argument")
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else "SS02_scripts.json"
+    with open(path) as f:
+        data = json.load(f)
+    data = data.get("result", data)
+    game = sys.argv[2] if len(sys.argv) > 2 else detect_game(data)
+
+    failed = False
+    for section in ("base", "free"):
+        entries = data.get(section, [])
+        if not entries:
+            continue
+        boards, counts = pack_scripts([entry["script"] for entry in entries])
+        specials = array.array("i", [entry.get("special_multipliers") or 1 for entry in entries])
+        with Engine(game, section) as engine:
+            shape = (len(entries[0]["script"][0]), len(entries[0]["script"][0][0]))
+            if shape != engine.shape:
+                raise ValueError(f"{path}: {section} boards are {shape[0]}x{shape[1]}, "
+                                 f"{game} expects {engine.shape[0]}x{engine.shape[1]}")
+            result = engine.evaluate(boards, counts, specials)
+        mismatches = sum(1 for entry, score in zip(entries, result["scores"])
+                         if "payout" in entry and entry["payout"] is not None and int(score) != entry["payout"])
+        stops = sum(1 for entry, stop in zip(entries, result["stops"]) if stop != entry["stop"])
+        average = sum(result["scores"]) / len(entries)
+        print(f"{section}: {len(entries)} scripts, average payout {average:.2f}, "
+              f"{mismatches} payout mismatches, {stops} stop mismatches")
+        failed = failed or mismatches > 0 or stops > 0
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())